@@ -0,0 +1,78 @@
+/* throughput of the byte swap kernels, against the per element loop the getters used. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <nanoexif-bswap.h>
+
+static inline uint16_t swap_endian_16(uint16_t i) {
+    return ((i&0xff)<<8) | ((i&0xff00)>>8);
+}
+static inline uint32_t swap_endian_32(uint32_t i) {
+    return ((i&0x000000ff)<<24) | ((i&0x0000ff00)<<8) | ((i&0x00ff0000)>>8) | ((i&0xff000000)>>24);
+}
+
+/* what nanoexif_get_ifd_entry_data_short/long did: memcpy, then swap in place. */
+static void loop16(void * dst, const void * src, size_t n) {
+    memcpy(dst, src, n*2);
+    uint16_t * p = dst;
+    size_t i;
+    for (i=0; i<n; i++) { p[i] = swap_endian_16(p[i]); }
+}
+static void loop32(void * dst, const void * src, size_t n) {
+    memcpy(dst, src, n*4);
+    uint32_t * p = dst;
+    size_t i;
+    for (i=0; i<n; i++) { p[i] = swap_endian_32(p[i]); }
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static volatile uint8_t sink;
+
+static void run(const char * name, nanoexif_bswap_fn fn, size_t width, size_t bytes, uint8_t * dst, const uint8_t * src) {
+    size_t n = bytes / width;
+    size_t total = 0;
+    double start = now(), elapsed;
+    /* at least 256MB or 0.2 sec, whichever is later */
+    do {
+        size_t r;
+        for (r=0; r<64; r++) {
+            fn(dst, src, n);
+            sink = dst[r % bytes];
+        }
+        total += 64 * n * width;
+        elapsed = now() - start;
+    } while (total < (256u<<20) || elapsed < 0.2);
+    printf("%-8s %2zu bit %8zu bytes  %7.2f GB/s\n", name, width*8, bytes, total / elapsed / 1e9);
+}
+
+int main(int argc, char **argv) {
+    /* typical entries: a few StripOffsets, a ColorMap, a large tile table; larger than L1, larger than L2 */
+    size_t sizes[] = { 64, 1536, 16*1024, 1024*1024 };
+    size_t max = sizes[sizeof(sizes)/sizeof(sizes[0])-1];
+    uint8_t * src = malloc(max);
+    uint8_t * dst = malloc(max);
+    if (!src || !dst) { perror("malloc"); return 1; }
+    size_t i, k, nk;
+    for (i=0; i<max; i++) { src[i] = (uint8_t)i; }
+
+    const nanoexif_bswap_kernel * kernels = nanoexif_bswap_kernels(&nk);
+    printf("selected: %s\n", nanoexif_bswap_selected()->name);
+    for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+        run("loop", loop16, 2, sizes[i], dst, src);
+        for (k=0; k<nk; k++) { run(kernels[k].name, kernels[k].swap16, 2, sizes[i], dst, src); }
+        run("loop", loop32, 4, sizes[i], dst, src);
+        for (k=0; k<nk; k++) { run(kernels[k].name, kernels[k].swap32, 4, sizes[i], dst, src); }
+    }
+    free(src);
+    free(dst);
+    return 0;
+}
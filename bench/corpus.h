@@ -0,0 +1,271 @@
+#ifndef NANOEXIF_BENCH_CORPUS_H__
+#define NANOEXIF_BENCH_CORPUS_H__
+
+/* synthetic jpeg/exif files for the benchmarks. shared by bench/gen-corpus.c and bench/exif.c. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <nanoexif.h>
+
+typedef struct {
+    bool big_endian;
+    unsigned ifds;      /* directories in the chain from IFD0. 2 or more has IFD1 */
+    unsigned tags;      /* entries in each directory, besides the pointers and the thumbnail ones */
+    unsigned depth;     /* sub ifds: 0 none, 1 Exif, 2 Exif and Interop */
+    bool gps;
+    uint32_t thumbnail; /* bytes of the jpeg thumbnail in IFD1. 0 for none */
+    uint32_t padding;   /* bytes of APP2 segments before the APP1 */
+    uint32_t seed;
+} corpus_spec;
+
+#define CORPUS_MAX_DIRS 16
+#define CORPUS_APP1_MAX (65535-2-6)
+
+typedef struct {
+    uint16_t tag;
+    uint16_t type;
+    uint32_t count;
+    uint8_t  link;  /* CORPUS_LINK_*: the value is the offset of something else */
+} corpus_entry;
+
+enum { CORPUS_LINK_NONE, CORPUS_LINK_EXIF, CORPUS_LINK_GPS, CORPUS_LINK_INTEROP, CORPUS_LINK_THUMB, CORPUS_LINK_THUMB_LEN };
+
+typedef struct {
+    corpus_entry * entries;
+    uint16_t n;
+    uint32_t offset;
+    uint32_t data;  /* bytes of the values out of the entries */
+} corpus_dir;
+
+typedef struct {
+    bool big;
+    uint8_t * p;
+} corpus_writer;
+
+static inline void corpus_put16(const corpus_writer * w, uint32_t off, uint16_t v) {
+    if (w->big) { w->p[off] = v>>8; w->p[off+1] = v; }
+    else        { w->p[off] = v; w->p[off+1] = v>>8; }
+}
+
+static inline void corpus_put32(const corpus_writer * w, uint32_t off, uint32_t v) {
+    if (w->big) { corpus_put16(w, off, v>>16); corpus_put16(w, off+2, v); }
+    else        { corpus_put16(w, off, v); corpus_put16(w, off+2, v>>16); }
+}
+
+static inline uint32_t corpus_rand(uint32_t * s) {
+    /* xorshift32 */
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+/* the mix of types in real files: mostly single SHORT/LONG/RATIONAL, some strings and arrays. */
+static inline void corpus_random_entry(corpus_entry * e, uint16_t tag, uint32_t * seed) {
+    static const uint16_t types[] = {
+        NANOEXIF_TYPE_SHORT, NANOEXIF_TYPE_SHORT, NANOEXIF_TYPE_LONG, NANOEXIF_TYPE_RATIONAL,
+        NANOEXIF_TYPE_RATIONAL, NANOEXIF_TYPE_ASCII, NANOEXIF_TYPE_UNDEFINED, NANOEXIF_TYPE_SRATIONAL,
+    };
+    uint32_t r = corpus_rand(seed);
+    e->tag   = tag;
+    e->type  = types[r % 8];
+    e->link  = CORPUS_LINK_NONE;
+    switch (e->type) {
+    case NANOEXIF_TYPE_ASCII:     e->count = 4 + (r>>8) % 28; break;
+    case NANOEXIF_TYPE_UNDEFINED: e->count = 1 + (r>>8) % 64; break;
+    case NANOEXIF_TYPE_SHORT:     e->count = (r>>8) % 4 ? 1 : 1 + (r>>12) % 16; break;
+    default:                      e->count = (r>>8) % 8 ? 1 : 1 + (r>>12) % 4; break;
+    }
+}
+
+static inline void corpus_link(corpus_entry * e, uint16_t tag, uint16_t type, uint8_t link) {
+    e->tag   = tag;
+    e->type  = type;
+    e->count = 1;
+    e->link  = link;
+}
+
+/* fill the directory: the fixed entries at the given places, synthetic tags from 0x1000 between them. */
+static inline bool corpus_fill(corpus_dir * d, unsigned tags, const corpus_entry * head, unsigned nhead, const corpus_entry * tail, unsigned ntail, uint32_t * seed) {
+    unsigned i;
+    if (tags > 0x7000) { return false; }
+    d->n = nhead + tags + ntail;
+    d->entries = malloc(sizeof(corpus_entry) * (d->n ? d->n : 1));
+    if (!d->entries) { return false; }
+    memcpy(d->entries, head, sizeof(corpus_entry) * nhead);
+    for (i=0; i<tags; i++) {
+        corpus_random_entry(&d->entries[nhead+i], 0x1000 + i, seed);
+    }
+    memcpy(d->entries + nhead + tags, tail, sizeof(corpus_entry) * ntail);
+    d->data = 0;
+    for (i=0; i<d->n; i++) {
+        uint32_t size = nanoexif_type_size(d->entries[i].type) * d->entries[i].count;
+        if (size > 4) { d->data += (size + 1) & ~1u; }
+    }
+    return true;
+}
+
+/* the tiff data of APP1. return the bytes written to out, or 0 if it does not fit in cap. */
+static inline size_t corpus_tiff(const corpus_spec * spec, uint8_t * out, size_t cap) {
+    corpus_dir dirs[CORPUS_MAX_DIRS];
+    corpus_entry head[4], tail[3];
+    unsigned nh, nt, ndirs = 0, i, j;
+    uint32_t seed = spec->seed ? spec->seed : 1;
+    unsigned ifds = spec->ifds ? spec->ifds : 1;
+    if (ifds > CORPUS_MAX_DIRS - 3) { return 0; }
+    int exif = -1, interop = -1, gps = -1, ifd1 = -1;
+    bool ok = true;
+
+    /* IFD0 */
+    nh = nt = 0;
+    corpus_link(&head[nh], NANOEXIF_TAG_ORIENTATION, NANOEXIF_TYPE_SHORT, CORPUS_LINK_NONE); nh++;
+    if (spec->depth >= 1) { corpus_link(&tail[nt++], NANOEXIF_TAG_EXIF_OFFSET, NANOEXIF_TYPE_LONG, CORPUS_LINK_EXIF); }
+    if (spec->gps)        { corpus_link(&tail[nt++], NANOEXIF_TAG_GPS_INFO, NANOEXIF_TYPE_LONG, CORPUS_LINK_GPS); }
+    ok = ok && corpus_fill(&dirs[ndirs++], spec->tags, head, nh, tail, nt, &seed);
+    if (spec->depth >= 1) {
+        exif = ndirs;
+        nt = 0;
+        if (spec->depth >= 2) { corpus_link(&tail[nt++], NANOEXIF_TAG_INTEROP_OFFSET, NANOEXIF_TYPE_LONG, CORPUS_LINK_INTEROP); }
+        ok = ok && corpus_fill(&dirs[ndirs++], spec->tags, head, 0, tail, nt, &seed);
+    }
+    if (spec->depth >= 2) {
+        interop = ndirs;
+        ok = ok && corpus_fill(&dirs[ndirs++], spec->tags < 4 ? spec->tags : 4, head, 0, tail, 0, &seed);
+    }
+    if (spec->gps) {
+        gps = ndirs;
+        ok = ok && corpus_fill(&dirs[ndirs++], spec->tags < 30 ? spec->tags : 30, head, 0, tail, 0, &seed);
+    }
+    /* IFD1 and the rest of the chain */
+    for (i=1; i<ifds; i++) {
+        nh = 0;
+        if (i == 1) {
+            ifd1 = ndirs;
+            corpus_link(&head[nh++], NANOEXIF_TAG_COMPRESSION, NANOEXIF_TYPE_SHORT, CORPUS_LINK_NONE);
+            if (spec->thumbnail) {
+                corpus_link(&head[nh++], NANOEXIF_TAG_JPEG_IF_OFFSET, NANOEXIF_TYPE_LONG, CORPUS_LINK_THUMB);
+                corpus_link(&head[nh++], NANOEXIF_TAG_JPEG_IF_BYTE_COUNT, NANOEXIF_TYPE_LONG, CORPUS_LINK_THUMB_LEN);
+            }
+        }
+        ok = ok && corpus_fill(&dirs[ndirs++], spec->tags, head, nh, tail, 0, &seed);
+    }
+    if (!ok) {
+        for (i=0; i<ndirs; i++) { free(dirs[i].entries); }
+        return 0;
+    }
+
+    uint64_t off = 8;
+    for (i=0; i<ndirs; i++) {
+        dirs[i].offset = off;
+        off += 2 + 12*dirs[i].n + 4 + dirs[i].data;
+    }
+    uint32_t thumb = off;
+    off += spec->thumbnail;
+
+    corpus_writer w = { spec->big_endian, out };
+    if (off <= cap) {
+        memcpy(out, spec->big_endian ? "MM" : "II", 2);
+        corpus_put16(&w, 2, 0x2A);
+        corpus_put32(&w, 4, 8);
+        for (i=0; i<ndirs; i++) {
+            corpus_dir * d = &dirs[i];
+            uint32_t p = d->offset, data = d->offset + 2 + 12*d->n + 4;
+            corpus_put16(&w, p, d->n);
+            p += 2;
+            for (j=0; j<d->n; j++, p+=12) {
+                corpus_entry * e = &d->entries[j];
+                uint32_t size = nanoexif_type_size(e->type) * e->count, k;
+                corpus_put16(&w, p, e->tag);
+                corpus_put16(&w, p+2, e->type);
+                corpus_put32(&w, p+4, e->count);
+                memset(out+p+8, 0, 4);
+                uint32_t v = corpus_rand(&seed);
+                switch (e->link) {
+                case CORPUS_LINK_EXIF:      v = dirs[exif].offset; break;
+                case CORPUS_LINK_GPS:       v = dirs[gps].offset; break;
+                case CORPUS_LINK_INTEROP:   v = dirs[interop].offset; break;
+                case CORPUS_LINK_THUMB:     v = thumb; break;
+                case CORPUS_LINK_THUMB_LEN: v = spec->thumbnail; break;
+                default:
+                    if (e->tag == NANOEXIF_TAG_ORIENTATION)  { v = 1 + v % 8; }
+                    if (e->tag == NANOEXIF_TAG_COMPRESSION) { v = spec->thumbnail ? 6 : 1; }
+                }
+                uint32_t at = size > 4 ? data : p+8;
+                if (size > 4) {
+                    corpus_put32(&w, p+8, data);
+                    data += (size + 1) & ~1u;
+                }
+                if (e->type == NANOEXIF_TYPE_SHORT && size <= 4) {
+                    for (k=0; k<e->count; k++) { corpus_put16(&w, at+k*2, e->link || e->count == 1 ? v : corpus_rand(&seed)); }
+                } else if (e->type == NANOEXIF_TYPE_LONG && e->count == 1) {
+                    corpus_put32(&w, at, v);
+                } else if (e->type == NANOEXIF_TYPE_ASCII) {
+                    for (k=0; k+1<e->count; k++) { out[at+k] = 'a' + corpus_rand(&seed) % 26; }
+                    out[at+k] = '\0';
+                } else if (nanoexif_type_size(e->type) == 1) {
+                    for (k=0; k<size; k++) { out[at+k] = corpus_rand(&seed); }
+                } else if (nanoexif_type_size(e->type) == 2) {
+                    for (k=0; k<size; k+=2) { corpus_put16(&w, at+k, corpus_rand(&seed)); }
+                } else {
+                    /* LONG arrays, and rationals with nonzero denominators */
+                    for (k=0; k<size; k+=4) { corpus_put32(&w, at+k, 1 + corpus_rand(&seed) % 1000); }
+                }
+            }
+            /* the chain: IFD0, IFD1, and the ones after it */
+            uint32_t next = 0;
+            if (ifd1 >= 0 && i == 0)                        { next = dirs[ifd1].offset; }
+            if (ifd1 >= 0 && (int)i >= ifd1 && i+1 < ndirs) { next = dirs[i+1].offset; }
+            corpus_put32(&w, p, next);
+        }
+        if (spec->thumbnail) {
+            memset(out+thumb, 0, spec->thumbnail);
+            out[thumb] = 0xFF;
+            if (spec->thumbnail > 1) { out[thumb+1] = 0xD8; }
+            if (spec->thumbnail > 3) { out[thumb+spec->thumbnail-2] = 0xFF; out[thumb+spec->thumbnail-1] = 0xD9; }
+        }
+    }
+    for (i=0; i<ndirs; i++) { free(dirs[i].entries); }
+    return off <= cap ? off : 0;
+}
+
+/* a whole jpeg: SOI, APP2 padding, APP1 exif, and a tiny 8x8 scan. return the bytes written, or 0 if it does not fit. */
+static inline size_t corpus_jpeg(const corpus_spec * spec, uint8_t * out, size_t cap) {
+    static const uint8_t image[] = {
+        0xFF, 0xDB, 0x00, 0x43, 0x00, /* DQT: 64 ones */
+        1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,
+        1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,
+        0xFF, 0xC0, 0x00, 0x0B, 0x08, 0x00, 0x08, 0x00, 0x08, 0x01, 0x01, 0x11, 0x00, /* SOF0 8x8 gray */
+        0xFF, 0xC4, 0x00, 0x14, 0x00, 0x01, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0x00, /* DHT DC: one code */
+        0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0x00, /* DHT AC: EOB */
+        0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00, 0x3F, 0x00, /* SOS */
+        0x00, /* scan */
+        0xFF, 0xD9,
+    };
+    size_t pos = 2, left = spec->padding;
+    if (cap < 2) { return 0; }
+    out[0] = 0xFF; out[1] = 0xD8;
+    while (left > 0) {
+        size_t seg = left < 4 ? 4 : left > 65535+2 ? 65535+2 : left; /* marker and length count */
+        if (pos + seg > cap) { return 0; }
+        out[pos] = 0xFF; out[pos+1] = 0xE2;
+        out[pos+2] = (seg-2) >> 8; out[pos+3] = (seg-2) & 0xFF;
+        memset(out+pos+4, 0, seg-4);
+        pos += seg;
+        left = left > seg ? left - seg : 0;
+    }
+    if (pos + 10 > cap) { return 0; }
+    size_t max = cap - pos - 10 < CORPUS_APP1_MAX ? cap - pos - 10 : CORPUS_APP1_MAX;
+    size_t tiff = corpus_tiff(spec, out+pos+10, max);
+    if (!tiff) { return 0; }
+    out[pos] = 0xFF; out[pos+1] = 0xE1;
+    out[pos+2] = (tiff+8) >> 8; out[pos+3] = (tiff+8) & 0xFF;
+    memcpy(out+pos+4, "Exif\0\0", 6);
+    pos += 10 + tiff;
+    if (pos + sizeof(image) > cap) { return 0; }
+    memcpy(out+pos, image, sizeof(image));
+    return pos + sizeof(image);
+}
+
+#endif  /* NANOEXIF_BENCH_CORPUS_H__ */
@@ -0,0 +1,501 @@
+/* files/sec, ns/tag, I/O and allocations of the parsing entry points, as NDJSON for tracking regressions.
+ * runs over the jpeg files in the given directory, or a generated corpus. */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <nanoexif.h>
+#include <nanoexif-easy.h>
+#include "corpus.h"
+
+/* count the allocations by interposing malloc; glibc only, and not under the sanitizers which have their own. */
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define COUNT_ALLOCS 1
+extern void *__libc_malloc(size_t n);
+extern void *__libc_calloc(size_t n, size_t m);
+extern void *__libc_realloc(void *p, size_t n);
+static size_t allocs;
+void *malloc(size_t n) { allocs++; return __libc_malloc(n); }
+void *calloc(size_t n, size_t m) { allocs++; return __libc_calloc(n, m); }
+void *realloc(void *p, size_t n) { allocs++; return __libc_realloc(p, n); }
+#else
+static size_t allocs;
+#endif
+
+typedef struct {
+    char * path;
+    uint8_t * data;
+    size_t len;
+    nanoexif * ne;
+    uint32_t ifd0_offset;
+} file;
+
+typedef struct {
+    nanoexif * ne;
+    nanoexif_ifd_entry entry;
+} tagged;
+
+typedef struct {
+    file * files;
+    size_t n;
+    tagged * tags;
+    size_t ntags;
+    double min_time;
+} corpus;
+
+typedef struct {
+    size_t files;
+    size_t tags;
+    uint64_t bytes;
+    uint64_t syscalls;
+    bool io;
+    double harness_time;   /* opening and closing the FILEs, taken out of the results */
+    size_t harness_allocs;
+} counts;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void die(const char *msg) {
+    perror(msg);
+    exit(1);
+}
+
+/* stdio over read(2), counting the calls. what nanoexif_init() costs in syscalls. */
+typedef struct {
+    int fd;
+    counts * c;
+    char buf[BUFSIZ]; /* the stdio buffer, so that the first read does not allocate it */
+} counted_file;
+
+static ssize_t cf_read(void *cookie, char *buf, size_t n) {
+    counted_file *f = cookie;
+    ssize_t r = read(f->fd, buf, n);
+    f->c->syscalls++;
+    if (r > 0) { f->c->bytes += r; }
+    return r;
+}
+
+static int cf_seek(void *cookie, off64_t *offset, int whence) {
+    counted_file *f = cookie;
+    off_t r = lseek(f->fd, *offset, whence);
+    f->c->syscalls++;
+    if (r < 0) { return -1; }
+    *offset = r;
+    return 0;
+}
+
+static int cf_close(void *cookie) {
+    counted_file *f = cookie;
+    int r = close(f->fd);
+    free(f);
+    return r;
+}
+
+static FILE * counted_fopen(const char *path, counts *c) {
+    counted_file *f = malloc(sizeof(counted_file));
+    if (!f) { return NULL; }
+    f->fd = open(path, O_RDONLY);
+    f->c  = c;
+    if (f->fd < 0) {
+        free(f);
+        return NULL;
+    }
+    cookie_io_functions_t fns = { cf_read, NULL, cf_seek, cf_close };
+    FILE *fp = fopencookie(f, "rb", fns);
+    if (!fp) {
+        close(f->fd);
+        free(f);
+        return NULL;
+    }
+    setvbuf(fp, f->buf, _IOFBF, sizeof(f->buf));
+    return fp;
+}
+
+/* open and close around the library calls, with the time and the allocations counted apart. */
+static FILE * harness_fopen(const char *path, counts *c) {
+    size_t a = allocs;
+    double t = now();
+    FILE *fp = counted_fopen(path, c);
+    if (!fp) { die(path); }
+    c->harness_time   += now() - t;
+    c->harness_allocs += allocs - a;
+    return fp;
+}
+
+static void harness_fclose(FILE *fp, counts *c) {
+    double t = now();
+    fclose(fp);
+    c->harness_time += now() - t;
+}
+
+static volatile uintptr_t sink;
+
+/* ---- the benchmarks: one pass over the corpus each ---- */
+
+static void pass_init(corpus *cp, counts *c) {
+    size_t i;
+    c->io = true;
+    for (i=0; i<cp->n; i++) {
+        FILE *fp = harness_fopen(cp->files[i].path, c);
+        uint32_t ifd0_offset;
+        nanoexif *ne = nanoexif_init(fp, &ifd0_offset);
+        sink += (uintptr_t)ne;
+        nanoexif_free(ne);
+        harness_fclose(fp, c);
+        c->files++;
+    }
+}
+
+static void pass_init_fd(corpus *cp, counts *c) {
+    size_t i;
+    c->io = true;
+    for (i=0; i<cp->n; i++) {
+        int fd = open(cp->files[i].path, O_RDONLY);
+        if (fd < 0) { die(cp->files[i].path); }
+        uint32_t ifd0_offset;
+        nanoexif_read_stats stats;
+        nanoexif *ne = nanoexif_init_fd(fd, 0, &ifd0_offset, &stats);
+        sink += (uintptr_t)ne;
+        nanoexif_free(ne);
+        close(fd);
+        c->files++;
+        c->syscalls += stats.syscalls;
+        c->bytes    += stats.bytes;
+    }
+}
+
+static void pass_init_memory(corpus *cp, counts *c) {
+    size_t i;
+    for (i=0; i<cp->n; i++) {
+        uint32_t ifd0_offset;
+        nanoexif *ne = nanoexif_init_from_memory(cp->files[i].data, cp->files[i].len, &ifd0_offset);
+        sink += (uintptr_t)ne;
+        nanoexif_free(ne);
+        c->files++;
+    }
+}
+
+/* read one ifd, and the sub ifds it points to. */
+static void read_ifd_tree(nanoexif *ne, uint32_t offset, counts *c, int depth) {
+    while (offset && depth < 8) {
+        uint32_t next;
+        uint16_t cnt, j;
+        nanoexif_ifd_entry *entries = nanoexif_read_ifd(ne, offset, &next, &cnt);
+        if (!entries) { return; }
+        c->tags += cnt;
+        for (j=0; j<cnt; j++) {
+            uint16_t tag = entries[j].tag;
+            uint32_t sub;
+            if ((tag == NANOEXIF_TAG_EXIF_OFFSET || tag == NANOEXIF_TAG_GPS_INFO || tag == NANOEXIF_TAG_INTEROP_OFFSET)
+                    && nanoexif_get_ifd_entry_uint(ne, &entries[j], 0, &sub)) {
+                read_ifd_tree(ne, sub, c, depth+1);
+            }
+        }
+        free(entries);
+        offset = next;
+        depth++;
+    }
+}
+
+static void pass_read_ifd(corpus *cp, counts *c) {
+    size_t i;
+    for (i=0; i<cp->n; i++) {
+        if (!cp->files[i].ne) { continue; }
+        read_ifd_tree(cp->files[i].ne, cp->files[i].ifd0_offset, c, 0);
+        c->files++;
+    }
+}
+
+static void pass_walker(corpus *cp, counts *c) {
+    size_t i;
+    for (i=0; i<cp->n; i++) {
+        if (!cp->files[i].ne) { continue; }
+        nanoexif_walker w;
+        nanoexif_ifd_entry entry;
+        nanoexif_walker_init(&w, cp->files[i].ne, cp->files[i].ifd0_offset);
+        while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) {
+            sink += entry.tag;
+            c->tags++;
+        }
+        c->files++;
+    }
+}
+
+#define GETTER_PASS(NAME, COND, BODY) \
+static void pass_##NAME(corpus *cp, counts *c) { \
+    size_t i; \
+    for (i=0; i<cp->ntags; i++) { \
+        nanoexif *ne = cp->tags[i].ne; \
+        nanoexif_ifd_entry *entry = &cp->tags[i].entry; \
+        uint16_t type = entry->type; \
+        (void)ne; (void)type; \
+        if (!(COND)) { continue; } \
+        BODY \
+        c->tags++; \
+    } \
+    c->files += cp->n; \
+}
+
+GETTER_PASS(get_short, type == NANOEXIF_TYPE_SHORT, {
+    uint16_t *v = nanoexif_get_ifd_entry_data_short(ne, entry);
+    sink += (uintptr_t)v;
+    free(v);
+})
+GETTER_PASS(get_long, type == NANOEXIF_TYPE_LONG, {
+    uint32_t *v = nanoexif_get_ifd_entry_data_long(ne, entry);
+    sink += (uintptr_t)v;
+    free(v);
+})
+GETTER_PASS(get_rational, type == NANOEXIF_TYPE_RATIONAL || type == NANOEXIF_TYPE_SRATIONAL, {
+    uint32_t *v = nanoexif_get_ifd_entry_data_rational(ne, entry);
+    sink += (uintptr_t)v;
+    free(v);
+})
+GETTER_PASS(get_ascii, type == NANOEXIF_TYPE_ASCII, {
+    char *v = nanoexif_get_ifd_entry_data_ascii(ne, entry);
+    sink += (uintptr_t)v;
+    free(v);
+})
+GETTER_PASS(get_data, true, {
+    sink += (uintptr_t)nanoexif_get_ifd_entry_data(ne, entry);
+})
+GETTER_PASS(get_uint, type == NANOEXIF_TYPE_BYTE || type == NANOEXIF_TYPE_SHORT || type == NANOEXIF_TYPE_LONG, {
+    uint32_t v = 0;
+    nanoexif_get_ifd_entry_uint(ne, entry, 0, &v);
+    sink += v;
+})
+GETTER_PASS(get_double, type == NANOEXIF_TYPE_SHORT || type == NANOEXIF_TYPE_LONG || type == NANOEXIF_TYPE_RATIONAL || type == NANOEXIF_TYPE_SRATIONAL, {
+    double v = 0;
+    nanoexif_get_ifd_entry_double(ne, entry, 0, &v);
+    sink += (uintptr_t)v;
+})
+
+static void pass_easy_thumbnail(corpus *cp, counts *c) {
+    size_t i;
+    c->io = true;
+    for (i=0; i<cp->n; i++) {
+        FILE *fp = harness_fopen(cp->files[i].path, c);
+        uint16_t orientation;
+        uint32_t len;
+        char *thumb = nanoexif_easy_thumbnail(fp, &orientation, &len);
+        sink += (uintptr_t)thumb;
+        free(thumb);
+        harness_fclose(fp, c);
+        c->files++;
+    }
+}
+
+static void pass_thumbnail_view(corpus *cp, counts *c) {
+    size_t i;
+    for (i=0; i<cp->n; i++) {
+        if (!cp->files[i].ne) { continue; }
+        uint16_t orientation;
+        uint32_t len;
+        sink += (uintptr_t)nanoexif_easy_thumbnail_view(cp->files[i].ne, cp->files[i].ifd0_offset, &orientation, &len);
+        c->files++;
+    }
+}
+
+typedef struct {
+    const char * name;
+    void (*pass)(corpus *cp, counts *c);
+    bool per_tag;
+} bench;
+
+static const bench BENCHES[] = {
+    { "init",             pass_init,           false },
+    { "init_fd",          pass_init_fd,        false },
+    { "init_from_memory", pass_init_memory,    false },
+    { "read_ifd",         pass_read_ifd,       true  },
+    { "walker",           pass_walker,         true  },
+    { "get_short",        pass_get_short,      true  },
+    { "get_long",         pass_get_long,       true  },
+    { "get_rational",     pass_get_rational,   true  },
+    { "get_ascii",        pass_get_ascii,      true  },
+    { "get_data",         pass_get_data,       true  },
+    { "get_uint",         pass_get_uint,       true  },
+    { "get_double",       pass_get_double,     true  },
+    { "easy_thumbnail",   pass_easy_thumbnail, false },
+    { "thumbnail_view",   pass_thumbnail_view, false },
+};
+
+static void print_per(const char *key, double total, size_t n, bool known) {
+    if (known && n) {
+        printf(",\"%s\":%.2f", key, total / n);
+    } else {
+        printf(",\"%s\":null", key);
+    }
+}
+
+static void run(corpus *cp, const bench *b) {
+    counts c;
+    memset(&c, 0, sizeof(c));
+    size_t passes = 0, allocs_start = allocs;
+    double start = now(), elapsed;
+    do {
+        b->pass(cp, &c);
+        passes++;
+        elapsed = now() - start;
+    } while (elapsed < cp->min_time);
+    size_t nallocs = allocs - allocs_start - c.harness_allocs;
+    elapsed -= c.harness_time;
+
+#ifdef COUNT_ALLOCS
+    bool allocs_known = true;
+#else
+    bool allocs_known = false;
+#endif
+    printf("{\"bench\":\"%s\",\"files\":%zu,\"passes\":%zu", b->name, cp->n, passes);
+    printf(",\"files_per_sec\":%.1f", c.files ? c.files / elapsed : 0.0);
+    print_per("ns_per_file", elapsed * 1e9, c.files, true);
+    print_per("ns_per_tag", elapsed * 1e9, c.tags, b->per_tag);
+    print_per("bytes_per_file", c.bytes, c.files, c.io);
+    print_per("syscalls_per_file", c.syscalls, c.files, c.io);
+    print_per("allocs_per_file", nallocs, c.files, allocs_known);
+    printf("}\n");
+    fflush(stdout);
+}
+
+/* ---- the corpus ---- */
+
+static void add_file(corpus *cp, const char *path) {
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) { return; }
+    file *tmp = realloc(cp->files, sizeof(file) * (cp->n + 1));
+    if (!tmp) { die("realloc"); }
+    cp->files = tmp;
+    file *f = &cp->files[cp->n++];
+    memset(f, 0, sizeof(file));
+    f->path = strdup(path);
+    f->data = malloc(st.st_size ? st.st_size : 1);
+    FILE *fp = fopen(path, "rb");
+    if (!f->path || !f->data || !fp) { die(path); }
+    f->len = fread(f->data, 1, st.st_size, fp);
+    fclose(fp);
+}
+
+static void load_dir(corpus *cp, const char *dir) {
+    DIR *d = opendir(dir);
+    if (!d) { die(dir); }
+    struct dirent *e;
+    while ((e = readdir(d))) {
+        size_t len = strlen(e->d_name);
+        if (len < 4 || strcasecmp(e->d_name + len - 4, ".jpg") != 0) { continue; }
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        add_file(cp, path);
+    }
+    closedir(d);
+}
+
+/* a mix of what cameras and phones write: both byte orders, 8 to 64 tags, some GPS, thumbnails and padding. */
+static char * generate(unsigned n) {
+    static char dir[] = "/tmp/nanoexif-bench-XXXXXX";
+    if (!mkdtemp(dir)) { die("mkdtemp"); }
+    size_t cap = 2*65536 + 32*1024 + 1024;
+    uint8_t *buf = malloc(cap);
+    if (!buf) { die("malloc"); }
+    unsigned i;
+    for (i=0; i<n; i++) {
+        corpus_spec spec;
+        spec.big_endian = i % 2;
+        spec.ifds       = i % 4 ? 2 : 1;
+        spec.tags       = 8 << (i % 4);
+        spec.depth      = i % 3;
+        spec.gps        = i % 3 == 0;
+        spec.thumbnail  = spec.ifds > 1 && i % 2 ? 4096 : 0;
+        spec.padding    = i % 4 == 3 ? 32*1024 : 0;
+        spec.seed       = i + 1;
+        size_t len = corpus_jpeg(&spec, buf, cap);
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%06u.jpg", dir, i);
+        FILE *fp = fopen(path, "wb");
+        if (!len || !fp || fwrite(buf, 1, len, fp) != len || fclose(fp) != 0) { die(path); }
+    }
+    free(buf);
+    return dir;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-t seconds] [-b bench] [dir]\n"
+                    "  prints one JSON object per benchmark. without dir, runs on a generated corpus.\n"
+                    "  -t  minimum seconds per benchmark (default 0.5)\n"
+                    "  -b  run only the named benchmark\n", prog);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    corpus cp;
+    memset(&cp, 0, sizeof(cp));
+    cp.min_time = 0.5;
+    const char *only = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:b:h")) != -1) {
+        switch (opt) {
+        case 't': cp.min_time = atof(optarg); break;
+        case 'b': only = optarg; break;
+        default: usage(argv[0]);
+        }
+    }
+    char *generated = NULL;
+    if (optind < argc) {
+        load_dir(&cp, argv[optind]);
+    } else {
+        generated = generate(64);
+        load_dir(&cp, generated);
+    }
+    if (cp.n == 0) {
+        fprintf(stderr, "no jpeg files\n");
+        return 1;
+    }
+
+    /* handles and entries for the benchmarks which do not measure the init */
+    size_t i, cap = 0;
+    for (i=0; i<cp.n; i++) {
+        file *f = &cp.files[i];
+        f->ne = nanoexif_init_from_memory(f->data, f->len, &f->ifd0_offset);
+        if (!f->ne) { continue; }
+        nanoexif_walker w;
+        nanoexif_ifd_entry entry;
+        nanoexif_walker_init(&w, f->ne, f->ifd0_offset);
+        while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) {
+            if (cp.ntags == cap) {
+                cap = cap ? cap*2 : 1024;
+                cp.tags = realloc(cp.tags, sizeof(tagged) * cap);
+                if (!cp.tags) { die("realloc"); }
+            }
+            cp.tags[cp.ntags].ne    = f->ne;
+            cp.tags[cp.ntags].entry = entry;
+            cp.ntags++;
+        }
+    }
+
+    for (i=0; i<sizeof(BENCHES)/sizeof(BENCHES[0]); i++) {
+        if (only && strcmp(only, BENCHES[i].name) != 0) { continue; }
+        run(&cp, &BENCHES[i]);
+    }
+
+    for (i=0; i<cp.n; i++) {
+        nanoexif_free(cp.files[i].ne);
+        if (generated) { unlink(cp.files[i].path); }
+        free(cp.files[i].path);
+        free(cp.files[i].data);
+    }
+    if (generated) { rmdir(generated); }
+    free(cp.files);
+    free(cp.tags);
+    return 0;
+}
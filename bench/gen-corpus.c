@@ -0,0 +1,74 @@
+/* writes synthetic jpeg/exif files for the benchmarks. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "corpus.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] dir\n"
+                    "  writes dir/000000.jpg ... with synthetic exif.\n"
+                    "  -n count      files (default 100)\n"
+                    "  -e ii|mm|mix  byte order (default mix)\n"
+                    "  -i ifds       directories in the IFD0 chain, 2 or more has IFD1 (default 2)\n"
+                    "  -t tags       entries per directory (default 16)\n"
+                    "  -d depth      sub ifds: 0 none, 1 Exif, 2 Exif and Interop (default 2)\n"
+                    "  -g            add GPS ifd\n"
+                    "  -T bytes      thumbnail size in IFD1 (default 0)\n"
+                    "  -p bytes      APP2 padding before APP1 (default 0)\n"
+                    "  -s seed       (default 1)\n", prog);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    corpus_spec spec = { false, 2, 16, 2, false, 0, 0, 1 };
+    unsigned n = 100, i;
+    const char *endian = "mix";
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:e:i:t:d:gT:p:s:h")) != -1) {
+        switch (opt) {
+        case 'n': n = atoi(optarg); break;
+        case 'e': endian = optarg; break;
+        case 'i': spec.ifds = atoi(optarg); break;
+        case 't': spec.tags = atoi(optarg); break;
+        case 'd': spec.depth = atoi(optarg); break;
+        case 'g': spec.gps = true; break;
+        case 'T': spec.thumbnail = strtoul(optarg, NULL, 10); break;
+        case 'p': spec.padding = strtoul(optarg, NULL, 10); break;
+        case 's': spec.seed = strtoul(optarg, NULL, 10); break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind + 1 != argc) { usage(argv[0]); }
+    const char *dir = argv[optind];
+    mkdir(dir, 0777);
+
+    size_t cap = (size_t)spec.padding + 2*65536 + 1024;
+    uint8_t *buf = malloc(cap);
+    if (!buf) { perror("malloc"); return 1; }
+    uint32_t seed = spec.seed;
+    for (i=0; i<n; i++) {
+        spec.seed = seed + i;
+        spec.big_endian = strcmp(endian, "mm") == 0 || (strcmp(endian, "mix") == 0 && i % 2);
+        size_t len = corpus_jpeg(&spec, buf, cap);
+        if (!len) {
+            fprintf(stderr, "the exif does not fit in APP1: fewer tags or a smaller thumbnail\n");
+            return 1;
+        }
+
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%06u.jpg", dir, i);
+        FILE *fp = fopen(path, "wb");
+        if (!fp || fwrite(buf, 1, len, fp) != len || fclose(fp) != 0) {
+            perror(path);
+            return 1;
+        }
+    }
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,296 @@
+#define _POSIX_C_SOURCE 200809L
+#include <nanoexif-batch.h>
+#include <nanoexif.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file nanoexif-batch.c
+ */
+
+#define GROW(p, n) do { \
+        void *tmp = realloc((p), sizeof(*(p))*(n)); \
+        if (!tmp) { return false; } \
+        (p) = tmp; \
+    } while (0)
+
+static bool reserve(nanoexif_columns * cols, size_t capacity) {
+    if (capacity <= cols->capacity) { return true; }
+    if (capacity < cols->capacity*2) { capacity = cols->capacity*2; }
+
+    int i;
+    for (i=0; i<NANOEXIF_COL_COUNT; i++) {
+        GROW(cols->valid[i], (capacity+7)/8);
+        memset(cols->valid[i] + (cols->capacity+7)/8, 0, (capacity+7)/8 - (cols->capacity+7)/8);
+    }
+    nanoexif_string_column * strs[] = { &cols->make, &cols->model, &cols->software, &cols->datetime_original };
+    for (i=0; i<4; i++) {
+        bool empty = !strs[i]->offsets;
+        GROW(strs[i]->offsets, capacity+1);
+        if (empty) { strs[i]->offsets[0] = 0; }
+    }
+    GROW(cols->orientation, capacity);
+    GROW(cols->width, capacity);
+    GROW(cols->height, capacity);
+    GROW(cols->exposure_time, capacity);
+    GROW(cols->f_number, capacity);
+    GROW(cols->iso, capacity);
+    GROW(cols->focal_length, capacity);
+    GROW(cols->flash, capacity);
+    GROW(cols->latitude, capacity);
+    GROW(cols->longitude, capacity);
+    GROW(cols->altitude, capacity);
+    cols->capacity = capacity;
+    return true;
+}
+
+/** allocate the columns.
+ * @args size_t capacity: rows to reserve. columns grow as needed.
+ * @return pointer of struct nanoexif_columns. return NULL if error occurred.
+ *
+ * You should call nanoexif_columns_free(cols) if return value is not null.
+ */
+nanoexif_columns * nanoexif_columns_new(size_t capacity) {
+    nanoexif_columns * cols = calloc(1, sizeof(nanoexif_columns));
+    if (!cols) { return NULL; }
+    if (!reserve(cols, capacity ? capacity : 64)) {
+        nanoexif_columns_free(cols);
+        return NULL;
+    }
+    return cols;
+}
+
+/** destruct the columns.
+ */
+void nanoexif_columns_free(nanoexif_columns * cols) {
+    if (!cols) { return; }
+    int i;
+    for (i=0; i<NANOEXIF_COL_COUNT; i++) {
+        free(cols->valid[i]);
+    }
+    nanoexif_string_column * strs[] = { &cols->make, &cols->model, &cols->software, &cols->datetime_original };
+    for (i=0; i<4; i++) {
+        free(strs[i]->offsets);
+        free(strs[i]->data);
+    }
+    free(cols->orientation);
+    free(cols->width);
+    free(cols->height);
+    free(cols->exposure_time);
+    free(cols->f_number);
+    free(cols->iso);
+    free(cols->focal_length);
+    free(cols->flash);
+    free(cols->latitude);
+    free(cols->longitude);
+    free(cols->altitude);
+    free(cols);
+}
+
+/** drop all rows, keeping the buffers for the next batch.
+ */
+void nanoexif_columns_clear(nanoexif_columns * cols) {
+    int i;
+    for (i=0; i<NANOEXIF_COL_COUNT; i++) {
+        memset(cols->valid[i], 0, (cols->n+7)/8);
+    }
+    nanoexif_string_column * strs[] = { &cols->make, &cols->model, &cols->software, &cols->datetime_original };
+    for (i=0; i<4; i++) {
+        strs[i]->data_len = 0;
+    }
+    cols->n = 0;
+}
+
+/** true if row of col has a value.
+ */
+bool nanoexif_columns_is_valid(const nanoexif_columns * cols, nanoexif_column col, size_t row) {
+    return (cols->valid[col][row/8] >> (row&7)) & 1;
+}
+
+static inline void set_valid(nanoexif_columns * cols, nanoexif_column col, size_t row) {
+    cols->valid[col][row/8] |= 1 << (row&7);
+}
+
+static bool set_string(nanoexif_columns * cols, nanoexif_column col, nanoexif_string_column * str, size_t row, nanoexif * ne, nanoexif_ifd_entry * entry) {
+    if (entry->type != NANOEXIF_TYPE_ASCII) { return true; }
+    const char *p = (const char*)nanoexif_get_ifd_entry_data(ne, entry);
+    if (!p) { return true; }
+    size_t len = strnlen(p, entry->count);
+    while (len && p[len-1] == ' ') { len--; }
+
+    str->data_len = str->offsets[row];
+    if (str->data_len + len > str->data_cap) {
+        size_t cap = str->data_cap ? str->data_cap*2 : 1024;
+        while (cap < str->data_len + len) { cap *= 2; }
+        GROW(str->data, cap);
+        str->data_cap = cap;
+    }
+    memcpy(str->data + str->data_len, p, len);
+    str->data_len += len;
+    str->offsets[row+1] = str->data_len;
+    set_valid(cols, col, row);
+    return true;
+}
+
+#define SET_UINT(col, field) do { \
+        uint32_t v; \
+        if (nanoexif_get_ifd_entry_uint(ne, &entry, 0, &v)) { \
+            cols->field[row] = v; \
+            set_valid(cols, col, row); \
+        } \
+    } while (0)
+
+#define SET_DOUBLE(col, field) do { \
+        double v; \
+        if (nanoexif_get_ifd_entry_double(ne, &entry, 0, &v)) { \
+            cols->field[row] = v; \
+            set_valid(cols, col, row); \
+        } \
+    } while (0)
+
+static double gps_degree(nanoexif * ne, nanoexif_ifd_entry * entry, bool * found) {
+    double d, m, s;
+    *found = entry->count >= 3
+        && nanoexif_get_ifd_entry_double(ne, entry, 0, &d)
+        && nanoexif_get_ifd_entry_double(ne, entry, 1, &m)
+        && nanoexif_get_ifd_entry_double(ne, entry, 2, &s);
+    return *found ? d + m/60 + s/3600 : 0;
+}
+
+/** append one row to the columns.
+ * @args nanoexif_columns * cols: the columns
+ * @args nanoexif * ne: the exif. NULL appends the row of nulls.
+ * @args uint32_t ifd0_offset: offset bytes for first ifd entry, given by nanoexif_init*()
+ * @return true if succeeded. return false if memory allocation failed.
+ *
+ * Values are read in place from the exif. Nothing is allocated unless the columns grow.
+ */
+bool nanoexif_columns_append(nanoexif_columns * cols, nanoexif * ne, uint32_t ifd0_offset) {
+    if (!reserve(cols, cols->n+1)) { return false; }
+
+    size_t row = cols->n;
+    nanoexif_string_column * strs[] = { &cols->make, &cols->model, &cols->software, &cols->datetime_original };
+    int i;
+    for (i=0; i<4; i++) {
+        strs[i]->offsets[row+1] = strs[i]->offsets[row] = strs[i]->data_len;
+    }
+    cols->orientation[row]   = 0;
+    cols->width[row]         = 0;
+    cols->height[row]        = 0;
+    cols->exposure_time[row] = 0;
+    cols->f_number[row]      = 0;
+    cols->iso[row]           = 0;
+    cols->focal_length[row]  = 0;
+    cols->flash[row]         = 0;
+    cols->latitude[row]      = 0;
+    cols->longitude[row]     = 0;
+    cols->altitude[row]      = 0;
+
+    if (ne) {
+        char lat_ref = 'N', lon_ref = 'E';
+        uint32_t alt_ref = 0;
+        bool lat = false, lon = false, alt = false;
+
+        nanoexif_walker w;
+        nanoexif_ifd_entry entry;
+        nanoexif_walker_init(&w, ne, ifd0_offset);
+        while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) {
+            switch (w.kind) {
+            case NANOEXIF_IFD_0:
+                switch (entry.tag) {
+                case NANOEXIF_TAG_MAKE: if (!set_string(cols, NANOEXIF_COL_MAKE, &cols->make, row, ne, &entry)) { return false; } break;
+                case NANOEXIF_TAG_MODEL: if (!set_string(cols, NANOEXIF_COL_MODEL, &cols->model, row, ne, &entry)) { return false; } break;
+                case NANOEXIF_TAG_SOFTWARE: if (!set_string(cols, NANOEXIF_COL_SOFTWARE, &cols->software, row, ne, &entry)) { return false; } break;
+                case NANOEXIF_TAG_ORIENTATION: SET_UINT(NANOEXIF_COL_ORIENTATION, orientation); break;
+                }
+                break;
+            case NANOEXIF_IFD_EXIF:
+                switch (entry.tag) {
+                case NANOEXIF_TAG_DATETIME_ORIGINAL: if (!set_string(cols, NANOEXIF_COL_DATETIME_ORIGINAL, &cols->datetime_original, row, ne, &entry)) { return false; } break;
+                case NANOEXIF_TAG_EXIF_IMAGE_WIDTH: SET_UINT(NANOEXIF_COL_WIDTH, width); break;
+                case NANOEXIF_TAG_EXIF_IMAGE_HEIGHT: SET_UINT(NANOEXIF_COL_HEIGHT, height); break;
+                case NANOEXIF_TAG_EXPOSURE_TIME: SET_DOUBLE(NANOEXIF_COL_EXPOSURE_TIME, exposure_time); break;
+                case NANOEXIF_TAG_F_NUMBER: SET_DOUBLE(NANOEXIF_COL_F_NUMBER, f_number); break;
+                case NANOEXIF_TAG_ISO: SET_UINT(NANOEXIF_COL_ISO, iso); break;
+                case NANOEXIF_TAG_FOCAL_LENGTH: SET_DOUBLE(NANOEXIF_COL_FOCAL_LENGTH, focal_length); break;
+                case NANOEXIF_TAG_FLASH: SET_UINT(NANOEXIF_COL_FLASH, flash); break;
+                }
+                break;
+            case NANOEXIF_IFD_GPS:
+                {
+                    const uint8_t *p;
+                    switch (entry.tag) {
+                    case NANOEXIF_TAG_GPS_LATITUDE_REF: if ((p = nanoexif_get_ifd_entry_data(ne, &entry)) && entry.count) { lat_ref = p[0]; } break;
+                    case NANOEXIF_TAG_GPS_LATITUDE: cols->latitude[row] = gps_degree(ne, &entry, &lat); break;
+                    case NANOEXIF_TAG_GPS_LONGITUDE_REF: if ((p = nanoexif_get_ifd_entry_data(ne, &entry)) && entry.count) { lon_ref = p[0]; } break;
+                    case NANOEXIF_TAG_GPS_LONGITUDE: cols->longitude[row] = gps_degree(ne, &entry, &lon); break;
+                    case NANOEXIF_TAG_GPS_ALTITUDE_REF: nanoexif_get_ifd_entry_uint(ne, &entry, 0, &alt_ref); break;
+                    case NANOEXIF_TAG_GPS_ALTITUDE: alt = nanoexif_get_ifd_entry_double(ne, &entry, 0, &cols->altitude[row]); break;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (lat) {
+            if (lat_ref == 'S') { cols->latitude[row] = -cols->latitude[row]; }
+            set_valid(cols, NANOEXIF_COL_LATITUDE, row);
+        }
+        if (lon) {
+            if (lon_ref == 'W') { cols->longitude[row] = -cols->longitude[row]; }
+            set_valid(cols, NANOEXIF_COL_LONGITUDE, row);
+        }
+        if (alt) {
+            if (alt_ref == 1) { cols->altitude[row] = -cols->altitude[row]; }
+            set_valid(cols, NANOEXIF_COL_ALTITUDE, row);
+        }
+    }
+
+    cols->n++;
+    return true;
+}
+
+/** extract the tags from n jpeg files, one row per file.
+ * @args nanoexif_columns * cols: rows are appended to this.
+ * @args FILE ** fps: file pointers for reading exif
+ * @args size_t n: number of files
+ * @return number of files which have exif. files without exif get the row of nulls.
+ */
+size_t nanoexif_batch_extract(nanoexif_columns * cols, FILE ** fps, size_t n) {
+    if (!reserve(cols, cols->n+n)) { return 0; }
+
+    nanoexif_ctx * ctx = nanoexif_ctx_new();
+    if (!ctx) { return 0; }
+
+    size_t found = 0;
+    size_t i;
+    for (i=0; i<n; i++) {
+        uint32_t ifd0_offset = 0;
+        nanoexif * ne = nanoexif_reset(ctx, fps[i], &ifd0_offset);
+        if (ne) { found++; }
+        if (!nanoexif_columns_append(cols, ne, ifd0_offset)) { break; }
+    }
+    nanoexif_ctx_free(ctx);
+    return found;
+}
+
+/** ditto, for the jpeg files on memory.
+ */
+size_t nanoexif_batch_extract_memory(nanoexif_columns * cols, const uint8_t ** data, const size_t * lens, size_t n) {
+    if (!reserve(cols, cols->n+n)) { return 0; }
+
+    size_t found = 0;
+    size_t i;
+    for (i=0; i<n; i++) {
+        uint32_t ifd0_offset = 0;
+        nanoexif * ne = nanoexif_init_from_memory(data[i], lens[i], &ifd0_offset);
+        if (ne) { found++; }
+        bool ok = nanoexif_columns_append(cols, ne, ifd0_offset);
+        nanoexif_free(ne);
+        if (!ok) { break; }
+    }
+    return found;
+}
@@ -0,0 +1,84 @@
+#ifndef NANOEXIF_BATCH_H__
+#define NANOEXIF_BATCH_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <nanoexif.h>
+
+/**
+ * enum nanoexif_column names the columns filled by the batch extractor.
+ */
+typedef enum {
+    NANOEXIF_COL_MAKE,
+    NANOEXIF_COL_MODEL,
+    NANOEXIF_COL_SOFTWARE,
+    NANOEXIF_COL_DATETIME_ORIGINAL,
+    NANOEXIF_COL_ORIENTATION,
+    NANOEXIF_COL_WIDTH,
+    NANOEXIF_COL_HEIGHT,
+    NANOEXIF_COL_EXPOSURE_TIME,
+    NANOEXIF_COL_F_NUMBER,
+    NANOEXIF_COL_ISO,
+    NANOEXIF_COL_FOCAL_LENGTH,
+    NANOEXIF_COL_FLASH,
+    NANOEXIF_COL_LATITUDE,
+    NANOEXIF_COL_LONGITUDE,
+    NANOEXIF_COL_ALTITUDE,
+    NANOEXIF_COL_COUNT
+} nanoexif_column;
+
+/**
+ * struct nanoexif_string_column is a variable length column.
+ * Row i is data[offsets[i]] .. data[offsets[i+1]], without the trailing NUL.
+ */
+typedef struct {
+    uint32_t * offsets;
+    char * data;
+    size_t data_len;
+    size_t data_cap;
+} nanoexif_string_column;
+
+/**
+ * struct nanoexif_columns holds the extracted tags as struct-of-arrays.
+ *
+ * valid[col] is a bitmap, bit (i&7) of byte i/8 is set when row i has a value.
+ * The value of a null row is 0.
+ */
+typedef struct {
+    size_t n;
+    size_t capacity;
+    uint8_t * valid[NANOEXIF_COL_COUNT];
+
+    nanoexif_string_column make;
+    nanoexif_string_column model;
+    nanoexif_string_column software;
+    nanoexif_string_column datetime_original;
+    uint16_t * orientation;
+    uint32_t * width;
+    uint32_t * height;
+    double * exposure_time;
+    double * f_number;
+    uint16_t * iso;
+    double * focal_length;
+    uint16_t * flash;
+    double * latitude;
+    double * longitude;
+    double * altitude;
+} nanoexif_columns;
+
+nanoexif_columns * nanoexif_columns_new(size_t capacity);
+void nanoexif_columns_free(nanoexif_columns * cols);
+void nanoexif_columns_clear(nanoexif_columns * cols);
+bool nanoexif_columns_is_valid(const nanoexif_columns * cols, nanoexif_column col, size_t row);
+bool nanoexif_columns_append(nanoexif_columns * cols, nanoexif * ne, uint32_t ifd0_offset);
+size_t nanoexif_batch_extract(nanoexif_columns * cols, FILE ** fps, size_t n);
+size_t nanoexif_batch_extract_memory(nanoexif_columns * cols, const uint8_t ** data, const size_t * lens, size_t n);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_BATCH_H__ */
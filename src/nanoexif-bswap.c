@@ -0,0 +1,202 @@
+#include <nanoexif-bswap.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file nanoexif-bswap.c
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NANOEXIF_BSWAP_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define NANOEXIF_BSWAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef __GNUC__
+#define BSWAP16(x) __builtin_bswap16(x)
+#define BSWAP32(x) __builtin_bswap32(x)
+#else
+#define BSWAP16(x) ((uint16_t)(((x)<<8) | ((x)>>8)))
+#define BSWAP32(x) ((((x)&0x000000ff)<<24) | (((x)&0x0000ff00)<<8) | (((x)&0x00ff0000)>>8) | (((x)&0xff000000)>>24))
+#endif
+
+/* the tails shorter than a vector, and the whole array for the scalar kernel.
+ * memcpy keeps the loads/stores legal for unaligned pointers; compilers turn them into plain moves. */
+static void swap16_scalar(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    size_t i;
+    for (i=0; i<n; i++) {
+        uint16_t v;
+        memcpy(&v, s+i*2, 2);
+        v = BSWAP16(v);
+        memcpy(d+i*2, &v, 2);
+    }
+}
+
+static void swap32_scalar(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    size_t i;
+    for (i=0; i<n; i++) {
+        uint32_t v;
+        memcpy(&v, s+i*4, 4);
+        v = BSWAP32(v);
+        memcpy(d+i*4, &v, 4);
+    }
+}
+
+#ifdef NANOEXIF_BSWAP_X86
+
+#define SHUF16_128 _mm_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14)
+#define SHUF32_128 _mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12)
+
+__attribute__((target("ssse3")))
+static void swap16_ssse3(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    const __m128i shuf = SHUF16_128;
+    size_t i = 0;
+    for (; i+8 <= n; i+=8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(s+i*2));
+        _mm_storeu_si128((__m128i*)(d+i*2), _mm_shuffle_epi8(v, shuf));
+    }
+    swap16_scalar(d+i*2, s+i*2, n-i);
+}
+
+__attribute__((target("ssse3")))
+static void swap32_ssse3(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    const __m128i shuf = SHUF32_128;
+    size_t i = 0;
+    for (; i+4 <= n; i+=4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(s+i*4));
+        _mm_storeu_si128((__m128i*)(d+i*4), _mm_shuffle_epi8(v, shuf));
+    }
+    swap32_scalar(d+i*4, s+i*4, n-i);
+}
+
+/* vpshufb shuffles within each 128 bit lane, so the mask is the sse one twice. */
+__attribute__((target("avx2")))
+static void swap16_avx2(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    const __m256i shuf = _mm256_broadcastsi128_si256(SHUF16_128);
+    size_t i = 0;
+    for (; i+16 <= n; i+=16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(s+i*2));
+        _mm256_storeu_si256((__m256i*)(d+i*2), _mm256_shuffle_epi8(v, shuf));
+    }
+    swap16_scalar(d+i*2, s+i*2, n-i);
+}
+
+__attribute__((target("avx2")))
+static void swap32_avx2(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    const __m256i shuf = _mm256_broadcastsi128_si256(SHUF32_128);
+    size_t i = 0;
+    for (; i+8 <= n; i+=8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(s+i*4));
+        _mm256_storeu_si256((__m256i*)(d+i*4), _mm256_shuffle_epi8(v, shuf));
+    }
+    swap32_scalar(d+i*4, s+i*4, n-i);
+}
+
+#endif /* NANOEXIF_BSWAP_X86 */
+
+#ifdef NANOEXIF_BSWAP_NEON
+
+static void swap16_neon(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    size_t i = 0;
+    for (; i+8 <= n; i+=8) {
+        vst1q_u8(d+i*2, vrev16q_u8(vld1q_u8(s+i*2)));
+    }
+    swap16_scalar(d+i*2, s+i*2, n-i);
+}
+
+static void swap32_neon(void * dst, const void * src, size_t n) {
+    uint8_t * d = dst;
+    const uint8_t * s = src;
+    size_t i = 0;
+    for (; i+4 <= n; i+=4) {
+        vst1q_u8(d+i*4, vrev32q_u8(vld1q_u8(s+i*4)));
+    }
+    swap32_scalar(d+i*4, s+i*4, n-i);
+}
+
+#endif /* NANOEXIF_BSWAP_NEON */
+
+/* ordered from the slowest to the fastest. */
+static const nanoexif_bswap_kernel KERNELS[] = {
+    { "scalar", swap16_scalar, swap32_scalar },
+#ifdef NANOEXIF_BSWAP_X86
+    { "ssse3",  swap16_ssse3,  swap32_ssse3  },
+    { "avx2",   swap16_avx2,   swap32_avx2   },
+#endif
+#ifdef NANOEXIF_BSWAP_NEON
+    { "neon",   swap16_neon,   swap32_neon   },
+#endif
+};
+
+static const nanoexif_bswap_kernel * SELECTED = NULL;
+
+static const nanoexif_bswap_kernel * select_kernel(void) {
+#ifdef NANOEXIF_BSWAP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))  { return &KERNELS[2]; }
+    if (__builtin_cpu_supports("ssse3")) { return &KERNELS[1]; }
+#endif
+#ifdef NANOEXIF_BSWAP_NEON
+    return &KERNELS[1];
+#endif
+    return &KERNELS[0];
+}
+
+/** the kernel picked for this cpu.
+ * @return pointer to the static kernel table entry.
+ *
+ * The cpu is probed on the first call. Concurrent first calls are harmless, they all pick the same entry.
+ */
+const nanoexif_bswap_kernel * nanoexif_bswap_selected(void) {
+#ifdef __GNUC__
+    const nanoexif_bswap_kernel * k = __atomic_load_n(&SELECTED, __ATOMIC_ACQUIRE);
+    if (!k) {
+        k = select_kernel();
+        __atomic_store_n(&SELECTED, k, __ATOMIC_RELEASE);
+    }
+    return k;
+#else
+    if (!SELECTED) { SELECTED = select_kernel(); }
+    return SELECTED;
+#endif
+}
+
+/** list the kernels which run on this cpu, for tests and benchmarks.
+ * @param size_t * n: the number of kernels will be set.
+ * @return array of kernels, ordered from the slowest to the fastest. the last one is nanoexif_bswap_selected().
+ */
+const nanoexif_bswap_kernel * nanoexif_bswap_kernels(size_t * n) {
+    *n = (size_t)(nanoexif_bswap_selected() - KERNELS) + 1;
+    return KERNELS;
+}
+
+/** copy n 16 bit values from src to dst, swapping the byte order of each.
+ * @param void * dst: destination. may be the same as src.
+ * @param const void * src: source.
+ * @param size_t n: the number of values.
+ */
+void nanoexif_bswap16(void * dst, const void * src, size_t n) {
+    nanoexif_bswap_selected()->swap16(dst, src, n);
+}
+
+/** ditto, for 32 bit values. RATIONAL is n*2 32 bit values.
+ */
+void nanoexif_bswap32(void * dst, const void * src, size_t n) {
+    nanoexif_bswap_selected()->swap32(dst, src, n);
+}
@@ -0,0 +1,32 @@
+#ifndef NANOEXIF_BSWAP_H__
+#define NANOEXIF_BSWAP_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * byte swapping kernels for arrays of 16/32 bit values.
+ * dst and src may be the same pointer(in place), but should not overlap otherwise.
+ * neither needs to be aligned.
+ */
+typedef void (*nanoexif_bswap_fn)(void * dst, const void * src, size_t n);
+
+typedef struct {
+    const char * name;
+    nanoexif_bswap_fn swap16;
+    nanoexif_bswap_fn swap32;
+} nanoexif_bswap_kernel;
+
+void nanoexif_bswap16(void * dst, const void * src, size_t n);
+void nanoexif_bswap32(void * dst, const void * src, size_t n);
+const nanoexif_bswap_kernel * nanoexif_bswap_selected(void);
+const nanoexif_bswap_kernel * nanoexif_bswap_kernels(size_t * n);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_BSWAP_H__ */
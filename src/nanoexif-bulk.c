@@ -0,0 +1,384 @@
+#define _GNU_SOURCE
+
+#include <nanoexif-bulk.h>
+#include <nanoexif.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define NANOEXIF_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+/**
+ * @file nanoexif-bulk.c
+ */
+
+/* follow-up reads for a file whose exif is not in the first window. each round reaches at least one more segment. */
+#define MAX_ROUNDS 16
+
+typedef struct {
+    int fd;
+    uint8_t * buf;
+    size_t cap;
+    size_t got;
+    size_t want;
+    int res;
+} slot;
+
+#ifdef NANOEXIF_HAVE_URING
+typedef struct {
+    int fd;
+    unsigned * sq_head;
+    unsigned * sq_tail;
+    unsigned * sq_mask;
+    unsigned * sq_array;
+    unsigned * cq_head;
+    unsigned * cq_tail;
+    unsigned * cq_mask;
+    struct io_uring_sqe * sqes;
+    struct io_uring_cqe * cqes;
+    void * sq_ptr;
+    void * cq_ptr;
+    size_t sq_len;
+    size_t cq_len;
+    size_t sqes_len;
+    unsigned queued;
+} ring;
+#endif
+
+struct nanoexif_bulk {
+    size_t window;
+    unsigned depth;
+    slot * slots;
+    bool uring;
+#ifdef NANOEXIF_HAVE_URING
+    ring ring;
+#endif
+};
+
+#ifdef NANOEXIF_HAVE_URING
+static void ring_exit(ring * r) {
+    if (r->sqes) { munmap(r->sqes, r->sqes_len); }
+    if (r->cq_ptr && r->cq_ptr != r->sq_ptr) { munmap(r->cq_ptr, r->cq_len); }
+    if (r->sq_ptr) { munmap(r->sq_ptr, r->sq_len); }
+    if (r->fd >= 0) { close(r->fd); }
+}
+
+static bool ring_init(ring * r, unsigned entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(r, 0, sizeof(*r));
+    r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (r->fd < 0) { return false; }
+
+    r->sq_len = p.sq_off.array + p.sq_entries*sizeof(unsigned);
+    r->cq_len = p.cq_off.cqes + p.cq_entries*sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (r->cq_len > r->sq_len) { r->sq_len = r->cq_len; }
+        r->cq_len = r->sq_len;
+    }
+    r->sq_ptr = mmap(NULL, r->sq_len, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQ_RING);
+    if (r->sq_ptr == MAP_FAILED) {
+        r->sq_ptr = NULL;
+        ring_exit(r);
+        return false;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        r->cq_ptr = r->sq_ptr;
+    } else {
+        r->cq_ptr = mmap(NULL, r->cq_len, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_CQ_RING);
+        if (r->cq_ptr == MAP_FAILED) {
+            r->cq_ptr = NULL;
+            ring_exit(r);
+            return false;
+        }
+    }
+    r->sqes_len = p.sq_entries*sizeof(struct io_uring_sqe);
+    r->sqes = mmap(NULL, r->sqes_len, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED) {
+        r->sqes = NULL;
+        ring_exit(r);
+        return false;
+    }
+
+    uint8_t * sq = r->sq_ptr;
+    uint8_t * cq = r->cq_ptr;
+    r->sq_head  = (unsigned*)(sq + p.sq_off.head);
+    r->sq_tail  = (unsigned*)(sq + p.sq_off.tail);
+    r->sq_mask  = (unsigned*)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned*)(sq + p.sq_off.array);
+    r->cq_head  = (unsigned*)(cq + p.cq_off.head);
+    r->cq_tail  = (unsigned*)(cq + p.cq_off.tail);
+    r->cq_mask  = (unsigned*)(cq + p.cq_off.ring_mask);
+    r->cqes     = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+    return true;
+}
+
+static struct io_uring_sqe * ring_sqe(ring * r, uint8_t opcode, int fd, uint64_t user_data) {
+    unsigned tail = *r->sq_tail;
+    unsigned idx  = (tail + r->queued) & *r->sq_mask;
+    struct io_uring_sqe * sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = opcode;
+    sqe->fd        = fd;
+    sqe->user_data = user_data;
+    r->sq_array[idx] = idx;
+    r->queued++;
+    return sqe;
+}
+
+/* submit the queued sqes, and wait for all of them. results go to slots[user_data].res. */
+static bool ring_run(ring * r, slot * slots) {
+    unsigned n = r->queued;
+    __atomic_store_n(r->sq_tail, *r->sq_tail + n, __ATOMIC_RELEASE);
+    r->queued = 0;
+
+    unsigned submitted = 0, reaped = 0;
+    while (reaped < n) {
+        int ret = (int)syscall(__NR_io_uring_enter, r->fd, n - submitted, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret < 0) {
+            if (errno == EINTR) { continue; }
+            return false;
+        }
+        submitted += ret;
+
+        unsigned head = *r->cq_head;
+        unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            struct io_uring_cqe * cqe = &r->cqes[head & *r->cq_mask];
+            slots[cqe->user_data].res = cqe->res;
+            head++;
+            reaped++;
+        }
+        __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+#endif
+
+/** create the bulk reader.
+ * @param size_t window: bytes read from the top of each file at first. 0 means NANOEXIF_BULK_WINDOW.
+ * @param unsigned depth: files in flight at once. 0 means NANOEXIF_BULK_DEPTH.
+ * @param bool use_uring: use io_uring if the system supports it.
+ * @return pointer of struct nanoexif_bulk. return NULL if error occurred.
+ *
+ * You should call nanoexif_bulk_free(b) if return value is not null. The reader is not thread safe;
+ * make one for each thread.
+ */
+nanoexif_bulk * nanoexif_bulk_new(size_t window, unsigned depth, bool use_uring) {
+    nanoexif_bulk * b = calloc(1, sizeof(nanoexif_bulk));
+    if (!b) { return NULL; }
+    b->window = window ? window : NANOEXIF_BULK_WINDOW;
+    b->depth  = depth ? depth : NANOEXIF_BULK_DEPTH;
+    b->slots  = calloc(b->depth, sizeof(slot));
+    if (!b->slots) {
+        free(b);
+        return NULL;
+    }
+    unsigned i;
+    for (i=0; i<b->depth; i++) {
+        b->slots[i].fd = -1;
+    }
+#ifdef NANOEXIF_HAVE_URING
+    b->uring = use_uring && ring_init(&b->ring, b->depth);
+#endif
+    return b;
+}
+
+/** destruct the bulk reader.
+ */
+void nanoexif_bulk_free(nanoexif_bulk * b) {
+    if (!b) { return; }
+#ifdef NANOEXIF_HAVE_URING
+    if (b->uring) { ring_exit(&b->ring); }
+#endif
+    unsigned i;
+    for (i=0; i<b->depth; i++) {
+        free(b->slots[i].buf);
+    }
+    free(b->slots);
+    free(b);
+}
+
+/** true if the reader uses io_uring, false if it falls back to pread(2).
+ */
+bool nanoexif_bulk_is_uring(const nanoexif_bulk * b) {
+    return b->uring;
+}
+
+static bool reserve(slot * s, size_t size) {
+    if (s->cap >= size) { return true; }
+    uint8_t * tmp = realloc(s->buf, size);
+    if (!tmp) { return false; }
+    s->buf = tmp;
+    s->cap = size;
+    return true;
+}
+
+/* account the result of a read, and decide whether the slot needs another one. */
+static void read_done(slot * s, int res) {
+    if (res <= 0) {
+        s->want = s->got; /* EOF or error. parse what we have. */
+        return;
+    }
+    s->got += res;
+    size_t extent = nanoexif_exif_extent(s->buf, s->got);
+    if (extent <= s->got) {
+        s->want = s->got; /* exif is complete, or there is none */
+    } else if (extent > s->want) {
+        s->want = extent;
+        if (!reserve(s, s->want)) { s->want = s->got; }
+    }
+}
+
+static void open_files(nanoexif_bulk * b, const char * const * paths, size_t k) {
+    size_t i;
+#ifdef NANOEXIF_HAVE_URING
+    if (b->uring) {
+        for (i=0; i<k; i++) {
+            struct io_uring_sqe * sqe = ring_sqe(&b->ring, IORING_OP_OPENAT, AT_FDCWD, i);
+            sqe->addr       = (uint64_t)(uintptr_t)paths[i];
+            sqe->open_flags = O_RDONLY|O_CLOEXEC;
+        }
+        if (ring_run(&b->ring, b->slots)) {
+            for (i=0; i<k; i++) {
+                slot * s = &b->slots[i];
+                if (s->res == -EINVAL) { /* the kernel doesn't know IORING_OP_OPENAT */
+                    s->fd = open(paths[i], O_RDONLY|O_CLOEXEC);
+                } else {
+                    s->fd = s->res >= 0 ? s->res : -1;
+                }
+            }
+            return;
+        }
+    }
+#endif
+    for (i=0; i<k; i++) {
+        b->slots[i].fd = open(paths[i], O_RDONLY|O_CLOEXEC);
+    }
+}
+
+static void read_files(nanoexif_bulk * b, size_t k) {
+    size_t i;
+    for (i=0; i<k; i++) {
+        slot * s = &b->slots[i];
+        s->got  = 0;
+        s->want = 0;
+        if (s->fd >= 0 && reserve(s, b->window)) {
+            s->want = b->window;
+        }
+    }
+
+    int round;
+    for (round=0; round<MAX_ROUNDS; round++) {
+        size_t pending = 0;
+#ifdef NANOEXIF_HAVE_URING
+        if (b->uring) {
+            for (i=0; i<k; i++) {
+                slot * s = &b->slots[i];
+                if (s->want <= s->got) { continue; }
+                struct io_uring_sqe * sqe = ring_sqe(&b->ring, IORING_OP_READ, s->fd, i);
+                sqe->addr = (uint64_t)(uintptr_t)(s->buf + s->got);
+                sqe->len  = s->want - s->got;
+                sqe->off  = s->got;
+                pending++;
+            }
+            if (pending == 0) { return; }
+            if (ring_run(&b->ring, b->slots)) {
+                for (i=0; i<k; i++) {
+                    slot * s = &b->slots[i];
+                    if (s->want <= s->got) { continue; }
+                    if (s->res == -EINVAL) { /* the kernel doesn't know IORING_OP_READ */
+                        s->res = pread(s->fd, s->buf + s->got, s->want - s->got, s->got);
+                    }
+                    read_done(s, s->res);
+                }
+                continue;
+            }
+            pending = 0;
+        }
+#endif
+        for (i=0; i<k; i++) {
+            slot * s = &b->slots[i];
+            if (s->want <= s->got) { continue; }
+            read_done(s, pread(s->fd, s->buf + s->got, s->want - s->got, s->got));
+            pending++;
+        }
+        if (pending == 0) { return; }
+    }
+}
+
+static void close_files(nanoexif_bulk * b, size_t k) {
+    size_t i;
+#ifdef NANOEXIF_HAVE_URING
+    if (b->uring) {
+        size_t n = 0;
+        for (i=0; i<k; i++) {
+            if (b->slots[i].fd >= 0) {
+                ring_sqe(&b->ring, IORING_OP_CLOSE, b->slots[i].fd, i);
+                n++;
+            }
+        }
+        if (n == 0) { return; }
+        if (ring_run(&b->ring, b->slots)) {
+            for (i=0; i<k; i++) {
+                slot * s = &b->slots[i];
+                if (s->fd >= 0 && s->res == -EINVAL) { /* the kernel doesn't know IORING_OP_CLOSE */
+                    close(s->fd);
+                }
+                s->fd = -1;
+            }
+            return;
+        }
+    }
+#endif
+    for (i=0; i<k; i++) {
+        if (b->slots[i].fd >= 0) {
+            close(b->slots[i].fd);
+            b->slots[i].fd = -1;
+        }
+    }
+}
+
+/** read the exif of the files.
+ * @param nanoexif_bulk * b: the reader
+ * @param const char * const * paths: paths of the jpeg files
+ * @param size_t n: number of paths
+ * @param nanoexif_bulk_cb cb: called once for each file, in the order of paths.
+ * @param void * ud: passed to cb.
+ * @return number of files which have exif.
+ *
+ * Files are opened and read in batches of depth files. The first read of each file is window bytes,
+ * and a follow-up read is issued only if its APP1 extends past that.
+ */
+size_t nanoexif_bulk_read(nanoexif_bulk * b, const char * const * paths, size_t n, nanoexif_bulk_cb cb, void * ud) {
+    size_t found = 0;
+    size_t base;
+    for (base=0; base<n; base+=b->depth) {
+        size_t k = n - base < b->depth ? n - base : b->depth;
+        open_files(b, paths + base, k);
+        read_files(b, k);
+
+        size_t i;
+        for (i=0; i<k; i++) {
+            slot * s = &b->slots[i];
+            uint32_t ifd0_offset = 0;
+            nanoexif * ne = s->fd >= 0 ? nanoexif_init_from_memory(s->buf, s->got, &ifd0_offset) : NULL;
+            if (ne) { found++; }
+            cb(base + i, ne, ifd0_offset, ud);
+            nanoexif_free(ne);
+        }
+
+        close_files(b, k);
+    }
+    return found;
+}
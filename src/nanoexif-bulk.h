@@ -0,0 +1,36 @@
+#ifndef NANOEXIF_BULK_H__
+#define NANOEXIF_BULK_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <nanoexif.h>
+
+/**
+ * struct nanoexif_bulk reads the headers of many files in batches.
+ * It uses io_uring on linux, and falls back to pread(2) where io_uring is not available.
+ */
+typedef struct nanoexif_bulk nanoexif_bulk;
+
+/**
+ * callback for nanoexif_bulk_read(). ne is NULL if the file has no exif or cannot be read.
+ * ne is valid only while the callback runs.
+ */
+typedef void (*nanoexif_bulk_cb)(size_t index, nanoexif * ne, uint32_t ifd0_offset, void * ud);
+
+#define NANOEXIF_BULK_WINDOW (64*1024)
+#define NANOEXIF_BULK_DEPTH  64
+
+nanoexif_bulk * nanoexif_bulk_new(size_t window, unsigned depth, bool use_uring);
+void nanoexif_bulk_free(nanoexif_bulk * b);
+bool nanoexif_bulk_is_uring(const nanoexif_bulk * b);
+size_t nanoexif_bulk_read(nanoexif_bulk * b, const char * const * paths, size_t n, nanoexif_bulk_cb cb, void * ud);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_BULK_H__ */
@@ -0,0 +1,318 @@
+#define _GNU_SOURCE
+#include <nanoexif-cache.h>
+#include <nanoexif.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @file nanoexif-cache.c
+ */
+
+#define CACHE_MAGIC   "NXCACHE1"
+#define CACHE_VERSION 1
+
+/* a slot is free, being filled by a writer, or done. it never goes back. */
+#define SLOT_FREE  0
+#define SLOT_BUSY  1
+#define SLOT_READY 2
+
+/* inserts stop at 70% of the slots, so that a probe stays short and always ends at a free slot. */
+#define CACHE_MAX_COUNT(slots) ((uint64_t)(slots) * 7 / 10)
+
+/* the file is the header, the slots, and the data, each 64 byte aligned. */
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t slots;     /* a power of 2 */
+    uint64_t data_size;
+    uint64_t data_used; /* atomic, never above data_size */
+    uint64_t count;     /* atomic, never above CACHE_MAX_COUNT(slots) */
+    uint8_t  pad[24];
+} cache_header;
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    uint64_t mtime_ns;
+    uint64_t offset; /* from the head of the data */
+    uint32_t len;    /* 0 for a file without exif */
+    uint32_t state;  /* atomic */
+} cache_slot;
+
+struct nanoexif_cache {
+    uint8_t * map;
+    size_t map_len;
+    cache_header * header;
+    cache_slot * slots;
+    uint8_t * data;
+};
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    uint64_t mtime_ns;
+} cache_key;
+
+static size_t cache_file_size(uint32_t slots, uint64_t data_size) {
+    return sizeof(cache_header) + (size_t)slots * sizeof(cache_slot) + data_size;
+}
+
+static bool cache_file_fits(uint32_t slots, uint64_t data_size) {
+    uint64_t head = sizeof(cache_header) + (uint64_t)slots * sizeof(cache_slot);
+    return head <= SIZE_MAX && data_size <= SIZE_MAX - head;
+}
+
+static bool attach(nanoexif_cache * c, int fd, size_t len) {
+    void * map = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) { return false; }
+    c->map     = map;
+    c->map_len = len;
+    c->header  = map;
+    c->slots   = (cache_slot*)(c->map + sizeof(cache_header));
+    c->data    = c->map + sizeof(cache_header) + (size_t)c->header->slots * sizeof(cache_slot);
+    return true;
+}
+
+/** open the cache file, creating it if it does not exist.
+ * @param const char *path: the cache file.
+ * @param uint32_t slots: the most entries, rounded up to a power of 2. 0 means NANOEXIF_CACHE_SLOTS.
+ * @param uint64_t data_size: bytes for the exif of all the entries. 0 means NANOEXIF_CACHE_DATA_SIZE.
+ * @return pointer of struct nanoexif_cache if succeeded, return NULL otherwise.
+ *
+ * slots and data_size are used only to create the file; an existing file keeps its own.
+ * The file is created sparse, and never grows. It holds up to 70% of slots entries; once those or the
+ * data are used up, new files are parsed but not stored, with NANOEXIF_CACHE_FULL.
+ * You should call nanoexif_cache_close(cache) if return value is not null.
+ *
+ * Entries are never removed: those of changed or deleted files stay until the file is rebuilt. To rebuild
+ * or compact the cache, fill a new one at a temporary path with nanoexif_cache_init() over the live files,
+ * and rename(2) it over the old one. Processes which have the old one open keep reading it until they
+ * reopen the path. Removing the file starts it over empty.
+ */
+nanoexif_cache * nanoexif_cache_open(const char *path, uint32_t slots, uint64_t data_size) {
+    if (slots == 0)     { slots = NANOEXIF_CACHE_SLOTS; }
+    if (data_size == 0) { data_size = NANOEXIF_CACHE_DATA_SIZE; }
+    if (slots > (1u<<31)) { return NULL; }
+    uint32_t n = 1;
+    while (n < slots) { n <<= 1; }
+    data_size = (data_size + 63) & ~(uint64_t)63;
+    if (!cache_file_fits(n, data_size)) { return NULL; }
+
+    nanoexif_cache * c = malloc(sizeof(nanoexif_cache));
+    if (!c) { return NULL; }
+    int fd = open(path, O_RDWR|O_CREAT|O_CLOEXEC, 0644);
+    if (fd < 0) {
+        free(c);
+        return NULL;
+    }
+
+    /* the lock is held only while the file is set up. it does not guard the entries. */
+    bool ok = false;
+    struct stat st;
+    while (flock(fd, LOCK_EX) != 0) {
+        if (errno != EINTR) { goto done; }
+    }
+    if (fstat(fd, &st) != 0) { goto done; }
+
+    if (st.st_size == 0) {
+        size_t len = cache_file_size(n, data_size);
+        if (ftruncate(fd, len) != 0) { goto done; }
+        void * map = mmap(NULL, sizeof(cache_header), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) { goto done; }
+        cache_header * h = map;
+        h->version   = CACHE_VERSION;
+        h->slots     = n;
+        h->data_size = data_size;
+        /* the magic goes last, so a crash leaves a file that is not taken for a cache */
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(h->magic, CACHE_MAGIC, 8);
+        munmap(map, sizeof(cache_header));
+    } else if ((size_t)st.st_size < sizeof(cache_header)) {
+        goto done;
+    }
+
+    {
+        cache_header h;
+        if (pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)) { goto done; }
+        if (memcmp(h.magic, CACHE_MAGIC, 8) != 0 || h.version != CACHE_VERSION ||
+            h.slots == 0 || (h.slots & (h.slots-1)) != 0 || !cache_file_fits(h.slots, h.data_size)) { goto done; }
+        size_t len = cache_file_size(h.slots, h.data_size);
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size != len) { goto done; }
+        ok = attach(c, fd, len);
+    }
+
+done:
+    flock(fd, LOCK_UN);
+    close(fd);
+    if (!ok) {
+        free(c);
+        return NULL;
+    }
+    return c;
+}
+
+/** release the cache. the handles returned by nanoexif_cache_init() must be freed before.
+ * @param nanoexif_cache * cache: the cache. may be NULL.
+ */
+void nanoexif_cache_close(nanoexif_cache * cache) {
+    if (!cache) { return; }
+    munmap(cache->map, cache->map_len);
+    free(cache);
+}
+
+/** number of the entries stored, by any process.
+ * @param const nanoexif_cache * cache: the cache.
+ */
+size_t nanoexif_cache_count(const nanoexif_cache * cache) {
+    return __atomic_load_n(&cache->header->count, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t mix(uint64_t h, uint64_t v) {
+    /* splitmix64 finalizer over the running value */
+    h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+static inline uint64_t key_hash(const cache_key * k) {
+    return mix(mix(mix(mix(0, k->dev), k->ino), k->size), k->mtime_ns);
+}
+
+static inline bool key_eq(const cache_slot * s, const cache_key * k) {
+    return s->dev == k->dev && s->ino == k->ino && s->size == k->size && s->mtime_ns == k->mtime_ns;
+}
+
+/* the ready slot of the key, or NULL. takes no lock: a slot is read only after its state is READY. */
+static cache_slot * lookup(nanoexif_cache * c, const cache_key * k) {
+    uint32_t mask = c->header->slots - 1;
+    uint32_t i = key_hash(k) & mask;
+    uint32_t n;
+    for (n=0; n<=mask; n++, i=(i+1)&mask) {
+        cache_slot * s = &c->slots[i];
+        uint32_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+        if (state == SLOT_FREE) { return NULL; }
+        if (state == SLOT_READY && key_eq(s, k)) { return s; }
+    }
+    return NULL;
+}
+
+/* add n to the counter unless it would go above max. the counter is left as is when it does not fit. */
+static bool reserve(uint64_t * counter, uint64_t max, uint64_t n, uint64_t * before) {
+    uint64_t cur = __atomic_load_n(counter, __ATOMIC_RELAXED);
+    do {
+        if (cur > max || n > max - cur) { return false; }
+    } while (!__atomic_compare_exchange_n(counter, &cur, cur + n, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    *before = cur;
+    return true;
+}
+
+/* copy the exif into the data, and publish it in a free slot. NULL if the cache is full. */
+static cache_slot * insert(nanoexif_cache * c, const cache_key * k, const uint8_t * buf, uint32_t len) {
+    /* the slot is counted first; it is given back if the key turns out to be stored already */
+    uint64_t offset = 0;
+    if (!reserve(&c->header->count, CACHE_MAX_COUNT(c->header->slots), 1, &offset)) { return NULL; }
+    if (len) {
+        uint64_t need = (len + 7) & ~(uint64_t)7;
+        if (!reserve(&c->header->data_used, c->header->data_size, need, &offset)) {
+            __atomic_fetch_sub(&c->header->count, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        memcpy(c->data + offset, buf, len);
+    }
+
+    uint32_t mask = c->header->slots - 1;
+    uint32_t i = key_hash(k) & mask;
+    uint32_t n;
+    for (n=0; n<=mask; n++, i=(i+1)&mask) {
+        cache_slot * s = &c->slots[i];
+        uint32_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+        if (state == SLOT_FREE) {
+            if (!__atomic_compare_exchange_n(&s->state, &state, SLOT_BUSY, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+                /* another writer took it first. look at what it holds. */
+                if (state == SLOT_BUSY) { continue; }
+            } else {
+                s->dev      = k->dev;
+                s->ino      = k->ino;
+                s->size     = k->size;
+                s->mtime_ns = k->mtime_ns;
+                s->offset   = offset;
+                s->len      = len;
+                __atomic_store_n(&s->state, SLOT_READY, __ATOMIC_RELEASE);
+                return s;
+            }
+        }
+        /* stored by another process meanwhile. its copy is used, and ours is left unused in the data. */
+        if (state == SLOT_READY && key_eq(s, k)) { break; }
+    }
+    __atomic_fetch_sub(&c->header->count, 1, __ATOMIC_RELAXED);
+    return n <= mask ? &c->slots[i] : NULL;
+}
+
+/* the slot's exif, or NULL for a file without exif, or a slot pointing out of the data of a broken file. */
+static nanoexif * slot_exif(nanoexif_cache * c, const cache_slot * s, uint32_t * ifd_offset) {
+    if (s->len == 0) { return NULL; }
+    if (s->offset > c->header->data_size || s->len > c->header->data_size - s->offset) { return NULL; }
+    return nanoexif_init_tiff(c->data + s->offset, s->len, ifd_offset);
+}
+
+/** initialize nanoexif struct from the jpeg file, through the cache.
+ * @param nanoexif_cache * cache: the cache.
+ * @param const char *path: the jpeg file.
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @param nanoexif_cache_status * status: how the exif was found will be set. may be NULL.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * A file which has the same device, inode, size and mtime as when it was stored is answered with one
+ * stat(2); the file is not opened. Otherwise it is read with nanoexif_init_fd(), and its exif is stored.
+ * Files without exif are stored too, so NULL comes with NANOEXIF_CACHE_HIT for them the next time.
+ * The handle points into the cache, and is valid until nanoexif_cache_close(). You should call nanoexif_free(ne) if return value is not null.
+ *
+ * A file rewritten within the resolution of its file system's mtime, keeping its size, is not noticed.
+ */
+nanoexif * nanoexif_cache_init(nanoexif_cache * cache, const char *path, uint32_t *ifd_offset, nanoexif_cache_status *status) {
+    nanoexif_cache_status local;
+    if (!status) { status = &local; }
+    *status = NANOEXIF_CACHE_ERROR;
+
+    struct stat st;
+    if (stat(path, &st) != 0) { return NULL; }
+    cache_key k = { st.st_dev, st.st_ino, st.st_size, (uint64_t)st.st_mtim.tv_sec * 1000000000ULL + st.st_mtim.tv_nsec };
+
+    cache_slot * s = lookup(cache, &k);
+    if (s) {
+        nanoexif * ne = slot_exif(cache, s, ifd_offset);
+        if (ne || s->len == 0) { *status = NANOEXIF_CACHE_HIT; }
+        return ne;
+    }
+
+    int fd = open(path, O_RDONLY|O_CLOEXEC);
+    if (fd < 0) { return NULL; }
+    nanoexif * ne = nanoexif_init_fd(fd, 0, ifd_offset, NULL);
+    close(fd);
+
+    /* the exif is the whole of ne->buf, as nanoexif_init_fd() reads all the APP1 */
+    s = insert(cache, &k, ne ? ne->buf : NULL, ne ? (uint32_t)ne->len : 0);
+    if (!s) {
+        *status = NANOEXIF_CACHE_FULL;
+        return ne;
+    }
+    *status = NANOEXIF_CACHE_STORED;
+    if (!ne) { return NULL; }
+    nanoexif * cached = slot_exif(cache, s, ifd_offset);
+    if (!cached) { return ne; }
+    nanoexif_free(ne);
+    return cached;
+}
@@ -0,0 +1,40 @@
+#ifndef NANOEXIF_CACHE_H__
+#define NANOEXIF_CACHE_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <nanoexif.h>
+
+/**
+ * struct nanoexif_cache is the exif of many files, kept in one memory mapped file across runs.
+ * Entries are keyed by (device, inode, size, mtime in ns), so a file which did not change is
+ * answered from stat(2) alone. Any number of threads and processes may share the cache file:
+ * lookups take no lock, and inserts claim their slot and their bytes with atomic operations.
+ */
+typedef struct nanoexif_cache nanoexif_cache;
+
+typedef enum {
+    NANOEXIF_CACHE_ERROR,  /* cannot stat or read the file, or its entry in the cache is broken */
+    NANOEXIF_CACHE_HIT,    /* from the cache, the file was not opened */
+    NANOEXIF_CACHE_STORED, /* parsed, and stored for the next time */
+    NANOEXIF_CACHE_FULL,   /* parsed, but there was no room to store it. see nanoexif_cache_open() */
+} nanoexif_cache_status;
+
+/* the default geometry of a new cache file: 10M files, at 70% of the slots and 27KB of exif each.
+ * the file is sparse; pages are used as entries are stored. */
+#define NANOEXIF_CACHE_SLOTS     (1u<<24)
+#define NANOEXIF_CACHE_DATA_SIZE ((uint64_t)1<<38)
+
+nanoexif_cache * nanoexif_cache_open(const char *path, uint32_t slots, uint64_t data_size);
+void nanoexif_cache_close(nanoexif_cache * cache);
+nanoexif * nanoexif_cache_init(nanoexif_cache * cache, const char *path, uint32_t *ifd_offset, nanoexif_cache_status *status);
+size_t nanoexif_cache_count(const nanoexif_cache * cache);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_CACHE_H__ */
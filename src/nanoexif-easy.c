@@ -19,118 +19,69 @@ char * nanoexif_easy_thumbnail(FILE * fp, uint16_t *orientation, uint32_t *jpeg_
     nanoexif * ne = nanoexif_init(fp, &ifd0_offset);
     if (!ne) { return NULL; }
 
+    const uint8_t * view = nanoexif_easy_thumbnail_view(ne, ifd0_offset, orientation, jpeg_byte_count);
+    if (!view) {
+        nanoexif_free(ne);
+        return NULL;
+    }
+
+    char * thumb = (char*)malloc(*jpeg_byte_count);
+    if (!thumb) {
+        nanoexif_free(ne);
+        return NULL;
+    }
+    memcpy(thumb, view, *jpeg_byte_count);
+
+    nanoexif_free(ne);
+    return thumb;
+}
+
+/** find thumbnail in the exif, without copying it.
+ * @args nanoexif * ne: the exif
+ * @args uint32_t ifd0_offset: offset bytes for first ifd entry, given by nanoexif_init*()
+ * @args uint16_t * orientation: jpeg file orientation from exif
+ * @args jpeg_byte_count : byte count for thumbnail will set.
+ * @return pointer to the thumbnail in the exif data. return NULL if error occurred.
+ *
+ * The pointer is valid until nanoexif_free(ne). You should not free(2) it.
+ * With nanoexif_init_mmap() this is a view into the file mapping.
+ */
+const uint8_t * nanoexif_easy_thumbnail_view(nanoexif *ne, uint32_t ifd0_offset, uint16_t *orientation, uint32_t *jpeg_byte_count) {
     // initialize
     *orientation     = 0;
     *jpeg_byte_count = 0;
 
-    // ifd0
-    uint32_t ifd1_offset;
-    {
-        uint16_t cnt;
-        nanoexif_ifd_entry* entries = nanoexif_read_ifd(ne, ifd0_offset, &ifd1_offset, &cnt);
-        if (!entries) { /* some error was occurred */
-            nanoexif_free(ne);
-            return NULL;
-        }
-        if (ifd1_offset == 0) { /* this jpeg does not contains ifd1. */
-            nanoexif_free(ne);
-            return NULL;
-        }
-        int i;
-        for (i=0; i<cnt; i++) {
-            switch (entries[i].tag) {
-            case NANOEXIF_TAG_ORIENTATION:
-                {
-                    uint16_t *x = nanoexif_get_ifd_entry_data_short(ne, &entries[i]);
-                    if (!x) {
-                        free(entries);
-                        nanoexif_free(ne);
-                        return NULL;
-                    }
-                    *orientation = *x;
-                    free(x);
-                }
-                break;
-            }
-        }
-        free(entries);
-    }
+    nanoexif_tag_key keys[] = {
+        { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION },
+        { NANOEXIF_IFD_1, NANOEXIF_TAG_COMPRESSION },
+        { NANOEXIF_IFD_1, NANOEXIF_TAG_JPEG_IF_OFFSET },
+        { NANOEXIF_IFD_1, NANOEXIF_TAG_JPEG_IF_BYTE_COUNT },
+    };
+    nanoexif_query_result results[4];
+    nanoexif_query(ne, ifd0_offset, keys, 4, results);
 
-    // ifd1
-    uint8_t * thumb = NULL; 
-    {
-        uint16_t cnt;
-        uint32_t ifd2_offset;
-        nanoexif_ifd_entry* entries = nanoexif_read_ifd(ne, ifd1_offset, &ifd2_offset, &cnt);
-        if (!entries) {
-            nanoexif_free(ne);
+    uint32_t value;
+    if (results[0].found) {
+        if (!nanoexif_get_ifd_entry_uint(ne, &results[0].entry, 0, &value)) {
             return NULL;
         }
+        *orientation = value;
+    }
 
-        int i;
-        bool compression_ok      = false;
-        uint32_t jpeg_offset     = 0;
-        for (i=0; i<cnt; i++) {
-            switch (entries[i].tag) {
-            case NANOEXIF_TAG_COMPRESSION:
-                {
-                    uint16_t * o = nanoexif_get_ifd_entry_data_short(ne, &entries[i]);
-                    if (!o) {
-                        free(entries);
-                        nanoexif_free(ne);
-                        return NULL;
-                    }
-                    if (*o!=6) {
-                        free(o);
-                        free(entries);
-                        nanoexif_free(ne);
-                        return NULL;
-                    }
-                    free(o);
-                    compression_ok = true;
-                    break;
-                }
-            case NANOEXIF_TAG_JPEG_IF_OFFSET:
-                {
-                    uint32_t *offset = nanoexif_get_ifd_entry_data_long(ne, &entries[i]);
-                    if (!offset) {
-                        free(entries);
-                        nanoexif_free(ne);
-                        return NULL;
-                    }
-                    jpeg_offset = *offset;
-                    free(offset);
-                    break;
-                }
-            case NANOEXIF_TAG_JPEG_IF_BYTE_COUNT:
-                {
-                    uint32_t *offset = nanoexif_get_ifd_entry_data_long(ne, &entries[i]);
-                    if (!offset) {
-                        free(entries);
-                        nanoexif_free(ne);
-                        return NULL;
-                    }
-                    *jpeg_byte_count = *offset;
-                    free(offset);
-                    break;
-                }
-            }
-        }
-        free(entries);
-
-        if (!(compression_ok && jpeg_offset && *jpeg_byte_count)) {
-            nanoexif_free(ne);
-            return NULL;
-        }
+    if (!results[1].found || !nanoexif_get_ifd_entry_uint(ne, &results[1].entry, 0, &value) || value != 6) {
+        return NULL; /* not a jpeg thumbnail */
+    }
 
-        thumb = (uint8_t*)malloc(*jpeg_byte_count);
-        if (!thumb) {
-            nanoexif_free(ne);
-            return NULL;
-        }
-        memcpy(thumb, ne->buf + jpeg_offset, *jpeg_byte_count);
+    uint32_t jpeg_offset = 0;
+    if (!results[2].found || !nanoexif_get_ifd_entry_uint(ne, &results[2].entry, 0, &jpeg_offset)) {
+        return NULL;
+    }
+    if (!results[3].found || !nanoexif_get_ifd_entry_uint(ne, &results[3].entry, 0, jpeg_byte_count)) {
+        return NULL;
+    }
+    if (!(jpeg_offset && *jpeg_byte_count)) {
+        return NULL;
     }
 
-    nanoexif_free(ne);
-    return thumb;
+    return nanoexif_range(ne, jpeg_offset, *jpeg_byte_count);
 }
@@ -7,8 +7,10 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdio.h>
+#include <nanoexif.h>
 
 char * nanoexif_easy_thumbnail(FILE * fp, uint16_t *orientation, uint32_t *jpeg_byte_count);
+const uint8_t * nanoexif_easy_thumbnail_view(nanoexif *ne, uint32_t ifd0_offset, uint16_t *orientation, uint32_t *jpeg_byte_count);
 
 #ifdef __cplusplus
 }
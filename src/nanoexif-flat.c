@@ -0,0 +1,310 @@
+#include <nanoexif-flat.h>
+#include <nanoexif-bswap.h>
+#include <nanoexif.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file nanoexif-flat.c
+ */
+
+#define FLAT_MAGIC "NXFLAT"
+
+typedef struct {
+    nanoexif_ifd_kind kind;
+    uint32_t from;  /* offset of the directory in the source */
+    uint32_t to;    /* offset of the directory in the flat tiff */
+    size_t first;   /* index of the first entry */
+    uint16_t count;
+} flat_ifd;
+
+typedef struct {
+    nanoexif * ne;
+    flat_ifd ifds[NANOEXIF_WALK_MAX_IFDS];
+    size_t nifds;
+    nanoexif_ifd_entry * entries;
+    size_t nentries;
+    size_t cap;
+    const uint8_t * thumb;
+    uint32_t thumb_len;
+    uint32_t thumb_to;
+} flat;
+
+static inline size_t align(size_t pos, size_t a) {
+    return (pos + a - 1) & ~(a - 1);
+}
+
+/* values are aligned to their elements, so the readers may load them in place. rationals are pairs of 32 bit values. */
+static size_t value_align(uint16_t type) {
+    switch (type) {
+    case NANOEXIF_TYPE_SHORT:
+    case NANOEXIF_TYPE_SSHORT:
+        return 2;
+    case NANOEXIF_TYPE_LONG:
+    case NANOEXIF_TYPE_SLONG:
+    case NANOEXIF_TYPE_FLOAT:
+    case NANOEXIF_TYPE_RATIONAL:
+    case NANOEXIF_TYPE_SRATIONAL:
+        return 4;
+    case NANOEXIF_TYPE_DFLOAT:
+        return 8;
+    }
+    return 1;
+}
+
+/* the sub ifd an entry points to, as nanoexif_walker_next() follows it */
+static bool is_pointer(nanoexif_ifd_kind kind, uint16_t tag) {
+    return (kind == NANOEXIF_IFD_0 && (tag == NANOEXIF_TAG_EXIF_OFFSET || tag == NANOEXIF_TAG_GPS_INFO))
+        || (kind == NANOEXIF_IFD_EXIF && tag == NANOEXIF_TAG_INTEROP_OFFSET);
+}
+
+static const flat_ifd * find_ifd(const flat * f, uint32_t from) {
+    size_t i;
+    for (i=1; i<f->nifds; i++) {
+        if (f->ifds[i].from == from) { return &f->ifds[i]; }
+    }
+    return NULL;
+}
+
+static const flat_ifd * find_kind(const flat * f, nanoexif_ifd_kind kind) {
+    size_t i;
+    for (i=0; i<f->nifds; i++) {
+        if (f->ifds[i].kind == kind) { return &f->ifds[i]; }
+    }
+    return NULL;
+}
+
+/* walk the ifds, keeping their entries in the order of the walk. */
+static bool collect(flat * f, uint32_t ifd0_offset) {
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    nanoexif_walk_status st;
+
+    /* IFD0 is written even if it is empty, as the tiff header points to it */
+    f->ifds[0].kind  = NANOEXIF_IFD_0;
+    f->ifds[0].from  = ifd0_offset;
+    f->ifds[0].first = 0;
+    f->ifds[0].count = 0;
+    f->nifds = 1;
+
+    nanoexif_walker_init(&w, f->ne, ifd0_offset);
+    while ((st = nanoexif_walker_next(&w, &entry)) == NANOEXIF_WALK_ENTRY) {
+        if (w.ifd_offset != f->ifds[f->nifds-1].from) {
+            flat_ifd * ifd = &f->ifds[f->nifds++];
+            ifd->kind  = w.kind;
+            ifd->from  = w.ifd_offset;
+            ifd->first = f->nentries;
+            ifd->count = 0;
+        }
+        if (f->nentries == f->cap) {
+            size_t cap = f->cap ? f->cap*2 : 64;
+            nanoexif_ifd_entry * tmp = realloc(f->entries, cap*sizeof(nanoexif_ifd_entry));
+            if (!tmp) { return false; }
+            f->entries = tmp;
+            f->cap     = cap;
+        }
+        f->entries[f->nentries++] = entry;
+        f->ifds[f->nifds-1].count++;
+    }
+    /* a broken sub ifd ends the walk, but what was walked is kept */
+    return st == NANOEXIF_WALK_END || f->nentries > 0;
+}
+
+/* drop the entries which cannot be carried over: unknown types, values out of the data, and pointers
+ * to ifds which were not walked. the thumbnail is picked up here. */
+static void filter(flat * f) {
+    const flat_ifd * ifd1 = find_kind(f, NANOEXIF_IFD_1);
+    if (ifd1) {
+        uint32_t offset = 0, len = 0;
+        size_t i;
+        for (i=ifd1->first; i<ifd1->first+ifd1->count; i++) {
+            nanoexif_ifd_entry * e = &f->entries[i];
+            if (e->tag == NANOEXIF_TAG_JPEG_IF_OFFSET)     { nanoexif_get_ifd_entry_uint(f->ne, e, 0, &offset); }
+            if (e->tag == NANOEXIF_TAG_JPEG_IF_BYTE_COUNT) { nanoexif_get_ifd_entry_uint(f->ne, e, 0, &len); }
+        }
+        if (offset && len) {
+            f->thumb     = nanoexif_range(f->ne, offset, len);
+            f->thumb_len = f->thumb ? len : 0;
+        }
+    }
+
+    size_t i, j, n = 0;
+    for (i=0; i<f->nifds; i++) {
+        flat_ifd * ifd = &f->ifds[i];
+        size_t first = n;
+        for (j=ifd->first; j<ifd->first+ifd->count; j++) {
+            nanoexif_ifd_entry * e = &f->entries[j];
+            uint32_t sub;
+            if (!nanoexif_get_ifd_entry_data(f->ne, e)) { continue; }
+            if (is_pointer(ifd->kind, e->tag) &&
+                !(nanoexif_get_ifd_entry_uint(f->ne, e, 0, &sub) && find_ifd(f, sub))) { continue; }
+            if (ifd->kind == NANOEXIF_IFD_1 && e->tag == NANOEXIF_TAG_JPEG_IF_OFFSET && !f->thumb) { continue; }
+            f->entries[n++] = *e;
+        }
+        ifd->first = first;
+        ifd->count = n - first;
+    }
+    f->nentries = n;
+}
+
+/* place the directories, the values after each, and the thumbnail. return the bytes of the tiff. */
+static size_t layout(flat * f) {
+    size_t pos = 8, i, j;
+    for (i=0; i<f->nifds; i++) {
+        flat_ifd * ifd = &f->ifds[i];
+        pos = align(pos, 4);
+        ifd->to = pos;
+        pos += 2 + sizeof(nanoexif_ifd_entry)*ifd->count + 4;
+        for (j=ifd->first; j<ifd->first+ifd->count; j++) {
+            nanoexif_ifd_entry * e = &f->entries[j];
+            size_t unit = nanoexif_type_size(e->type);
+            size_t size = unit * e->count;
+            if (size > 4) {
+                pos = align(pos, value_align(e->type)) + size;
+            }
+        }
+    }
+    if (f->thumb) {
+        f->thumb_to = pos;
+        pos += f->thumb_len;
+    }
+    return pos;
+}
+
+/* copy count values of type into dst, in the machine's endian. */
+static void put_values(const flat * f, uint8_t * dst, const uint8_t * src, uint16_t type, size_t count) {
+    size_t size = nanoexif_type_size(type) * count, i;
+    if (f->ne->endian == NANOEXIF_MACHINE_ENDIAN) {
+        memcpy(dst, src, size);
+        return;
+    }
+    switch (type) {
+    case NANOEXIF_TYPE_SHORT:
+    case NANOEXIF_TYPE_SSHORT:
+        nanoexif_bswap16(dst, src, count);
+        break;
+    case NANOEXIF_TYPE_LONG:
+    case NANOEXIF_TYPE_SLONG:
+    case NANOEXIF_TYPE_FLOAT:
+    case NANOEXIF_TYPE_RATIONAL:
+    case NANOEXIF_TYPE_SRATIONAL:
+        nanoexif_bswap32(dst, src, size/4);
+        break;
+    case NANOEXIF_TYPE_DFLOAT:
+        for (i=0; i<size; i++) {
+            dst[i] = src[(i & ~(size_t)7) + 7 - (i & 7)];
+        }
+        break;
+    default:
+        memcpy(dst, src, size);
+    }
+}
+
+static inline void put16(uint8_t * p, uint16_t v) { memcpy(p, &v, 2); }
+static inline void put32(uint8_t * p, uint32_t v) { memcpy(p, &v, 4); }
+
+static void emit(const flat * f, uint8_t * tiff) {
+    memcpy(tiff, NANOEXIF_MACHINE_ENDIAN == NANOEXIF_LITTLE_ENDIAN ? "II" : "MM", 2);
+    put16(tiff+2, 0x2A);
+    put32(tiff+4, f->ifds[0].to);
+
+    const flat_ifd * ifd1 = find_kind(f, NANOEXIF_IFD_1);
+    size_t i, j;
+    for (i=0; i<f->nifds; i++) {
+        const flat_ifd * ifd = &f->ifds[i];
+        uint8_t * p = tiff + ifd->to;
+        size_t pos = ifd->to + 2 + sizeof(nanoexif_ifd_entry)*ifd->count + 4;
+        put16(p, ifd->count);
+        p += 2;
+        for (j=ifd->first; j<ifd->first+ifd->count; j++, p+=sizeof(nanoexif_ifd_entry)) {
+            nanoexif_ifd_entry e = f->entries[j];
+            uint32_t sub;
+            put16(p, e.tag);
+            if (is_pointer(ifd->kind, e.tag) && nanoexif_get_ifd_entry_uint(f->ne, &e, 0, &sub)) {
+                put16(p+2, NANOEXIF_TYPE_LONG);
+                put32(p+4, 1);
+                put32(p+8, find_ifd(f, sub)->to);
+                continue;
+            }
+            if (ifd->kind == NANOEXIF_IFD_1 && e.tag == NANOEXIF_TAG_JPEG_IF_OFFSET) {
+                put16(p+2, NANOEXIF_TYPE_LONG);
+                put32(p+4, 1);
+                put32(p+8, f->thumb_to);
+                continue;
+            }
+            put16(p+2, e.type);
+            put32(p+4, e.count);
+            size_t unit = nanoexif_type_size(e.type);
+            const uint8_t * src = nanoexif_get_ifd_entry_data(f->ne, &e);
+            if (unit * e.count <= 4) {
+                memset(p+8, 0, 4);
+                put_values(f, p+8, src, e.type, e.count);
+            } else {
+                pos = align(pos, value_align(e.type));
+                put32(p+8, pos);
+                put_values(f, tiff+pos, src, e.type, e.count);
+                pos += unit * e.count;
+            }
+        }
+        put32(p, (i == 0 && ifd1) ? ifd1->to : 0);
+    }
+    if (f->thumb) {
+        memcpy(tiff + f->thumb_to, f->thumb, f->thumb_len);
+    }
+}
+
+/** write the flat form of the exif.
+ * @param nanoexif * ne: pointer for struct nanoexif.
+ * @param uint32_t ifd0_offset: offset bytes for first ifd entry, given by nanoexif_init*()
+ * @param uint8_t * out: the flat form will be written, if cap is enough. may be NULL.
+ * @param size_t cap: bytes of out.
+ * @return bytes of the flat form, which may be more than cap. return 0 if the exif is broken.
+ *
+ * Call it with cap 0 to learn the size, then again with a buffer that large; out should be 8 byte aligned
+ * for the values to be aligned. Entries whose values cannot be read, of unknown types, or pointing to
+ * ifds which are not walked are left out. Offsets other than the sub ifds and the jpeg thumbnail
+ * (StripOffsets, MakerNote internals, ...) are copied as they are, and point to nothing in the flat form.
+ */
+size_t nanoexif_flatten(nanoexif * ne, uint32_t ifd0_offset, uint8_t * out, size_t cap) {
+    flat f;
+    memset(&f, 0, sizeof(f));
+    f.ne = ne;
+    size_t len = 0;
+    if (collect(&f, ifd0_offset)) {
+        filter(&f);
+        len = layout(&f);
+        if (len > UINT32_MAX) { len = 0; }
+    }
+    if (len && out && cap >= NANOEXIF_FLAT_HEADER_SIZE + len) {
+        memset(out, 0, NANOEXIF_FLAT_HEADER_SIZE + len);
+        memcpy(out, FLAT_MAGIC, 6);
+        out[6] = NANOEXIF_FLAT_VERSION;
+        out[8]  = len;
+        out[9]  = len >> 8;
+        out[10] = len >> 16;
+        out[11] = len >> 24;
+        emit(&f, out + NANOEXIF_FLAT_HEADER_SIZE);
+    }
+    free(f.entries);
+    return len ? NANOEXIF_FLAT_HEADER_SIZE + len : 0;
+}
+
+/** initialize nanoexif struct from the flat form, in place.
+ * @param const uint8_t * data: the flat form, written by nanoexif_flatten().
+ * @param size_t len: bytes of data
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The data is not copied, as nanoexif_init_tiff(), and nothing is swapped when it was written on a machine
+ * of the same endian. A flat form from the other endian is read too, swapping as a tiff of that endian.
+ * You should call nanoexif_free(ne) if return value is not null.
+ */
+nanoexif * nanoexif_init_flat(const uint8_t * data, size_t len, uint32_t * ifd_offset) {
+    if (len < NANOEXIF_FLAT_HEADER_SIZE || memcmp(data, FLAT_MAGIC, 6) != 0 || data[6] != NANOEXIF_FLAT_VERSION) {
+        return NULL;
+    }
+    uint32_t tiff_len = data[8] | data[9] << 8 | data[10] << 16 | (uint32_t)data[11] << 24;
+    if (tiff_len > len - NANOEXIF_FLAT_HEADER_SIZE) { return NULL; }
+    return nanoexif_init_tiff(data + NANOEXIF_FLAT_HEADER_SIZE, tiff_len, ifd_offset);
+}
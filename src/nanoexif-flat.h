@@ -0,0 +1,28 @@
+#ifndef NANOEXIF_FLAT_H__
+#define NANOEXIF_FLAT_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <nanoexif.h>
+
+/*
+ * the flat form of a parsed exif, for handing it to another process or storing it.
+ * It is a 16 byte header("NXFLAT", the version, the tiff length in little endian) followed by a tiff in the
+ * machine's endian, holding IFD0, IFD1, the Exif, GPS and Interop ifds and the jpeg thumbnail, laid out one
+ * after another with each value aligned to its type. nanoexif_init_flat() reads it in place, so it can be
+ * handed over in a shared memory segment or mapped from a file, and read with the usual accessors.
+ */
+#define NANOEXIF_FLAT_VERSION     1
+#define NANOEXIF_FLAT_HEADER_SIZE 16
+
+size_t nanoexif_flatten(nanoexif * ne, uint32_t ifd0_offset, uint8_t * out, size_t cap);
+nanoexif * nanoexif_init_flat(const uint8_t * data, size_t len, uint32_t * ifd_offset);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_FLAT_H__ */
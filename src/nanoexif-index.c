@@ -0,0 +1,132 @@
+#include <nanoexif-index.h>
+#include <nanoexif.h>
+#include <nanoexif-private.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file nanoexif-index.c
+ */
+
+static inline uint32_t record_key(const nanoexif_index_record * r) {
+    return ((uint32_t)r->ifd << 16) | r->tag;
+}
+
+/* by (ifd, tag). duplicated tags keep the file order. */
+static int compare_record(const void * a, const void * b) {
+    const nanoexif_index_record * x = a;
+    const nanoexif_index_record * y = b;
+    uint32_t kx = record_key(x), ky = record_key(y);
+    if (kx != ky) { return kx < ky ? -1 : 1; }
+    if (x->dir != y->dir) { return x->dir < y->dir ? -1 : 1; }
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+/** build the index of every entry reachable from IFD0.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param uint32_t ifd0_offset: offset of IFD0.
+ * @return the index, or NULL if error occurred. entries whose values are out of the exif are not indexed.
+ *
+ * You should call nanoexif_index_free(idx) if return value is not null.
+ */
+nanoexif_index * nanoexif_index_build(nanoexif * ne, uint32_t ifd0_offset) {
+    size_t cap = 32;
+    nanoexif_index * idx = malloc(sizeof(nanoexif_index) + sizeof(nanoexif_index_record)*cap);
+    if (!idx) { return NULL; }
+    idx->ne      = ne;
+    idx->n       = 0;
+    idx->records = (nanoexif_index_record *)(idx + 1);
+
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    nanoexif_walk_status st;
+    nanoexif_walker_init(&w, ne, ifd0_offset);
+    while ((st = nanoexif_walker_next(&w, &entry)) == NANOEXIF_WALK_ENTRY) {
+        uint64_t size = (uint64_t)nanoexif_type_size(entry.type) * entry.count;
+        uint32_t value_offset;
+        if (size <= 4) {
+            value_offset = w.ifd_offset + 2 + sizeof(nanoexif_ifd_entry)*(w.index-1) + 8;
+        } else {
+            if (!nanoexif_get_ifd_entry_data(ne, &entry)) { continue; }
+            value_offset = read_32(ne->endian, entry.offset);
+        }
+        if (idx->n == cap) {
+            nanoexif_index * tmp = realloc(idx, sizeof(nanoexif_index) + sizeof(nanoexif_index_record)*cap*2);
+            if (!tmp) { free(idx); return NULL; }
+            idx = tmp;
+            idx->records = (nanoexif_index_record *)(idx + 1);
+            cap *= 2;
+        }
+        nanoexif_index_record * r = &idx->records[idx->n++];
+        r->count        = entry.count;
+        r->value_offset = value_offset;
+        r->tag          = entry.tag;
+        r->type         = entry.type;
+        r->ifd          = w.kind;
+        r->dir          = w.nvisited - 1;
+        r->index        = w.index - 1;
+    }
+    if (st == NANOEXIF_WALK_ERROR && idx->n == 0) {
+        free(idx);
+        return NULL;
+    }
+
+    qsort(idx->records, idx->n, sizeof(nanoexif_index_record), compare_record);
+    return idx;
+}
+
+/** destruct the index. ne is not freed.
+ */
+void nanoexif_index_free(nanoexif_index * idx) {
+    free(idx);
+}
+
+/** find the tag in the ifd by binary search.
+ * @param const nanoexif_index * idx
+ * @param nanoexif_ifd_kind ifd: the ifd which has the tag
+ * @param uint16_t tag
+ * @return the record, or NULL if not found. if the tag is duplicated, the first one in the file.
+ */
+const nanoexif_index_record * nanoexif_index_find(const nanoexif_index * idx, nanoexif_ifd_kind ifd, uint16_t tag) {
+    uint32_t key = ((uint32_t)ifd << 16) | tag;
+    size_t lo = 0, hi = idx->n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (record_key(&idx->records[mid]) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < idx->n && record_key(&idx->records[lo]) == key) {
+        return &idx->records[lo];
+    }
+    return NULL;
+}
+
+/** restore the ifd entry of the record, to read values with nanoexif_get_ifd_entry_*().
+ * @param const nanoexif_index * idx
+ * @param const nanoexif_index_record * r: a record in idx
+ * @param nanoexif_ifd_entry * entry: the entry will be set.
+ */
+void nanoexif_index_entry(const nanoexif_index * idx, const nanoexif_index_record * r, nanoexif_ifd_entry * entry) {
+    nanoexif * ne = idx->ne;
+    entry->tag   = r->tag;
+    entry->type  = r->type;
+    entry->count = r->count;
+    if ((uint64_t)nanoexif_type_size(r->type) * r->count <= 4) {
+        /* inline values are in the directory, which is in range */
+        memcpy(entry->offset, nanoexif_range(ne, r->value_offset, 4), 4);
+    } else if (ne->endian == NANOEXIF_LITTLE_ENDIAN) {
+        entry->offset[0] = r->value_offset;
+        entry->offset[1] = r->value_offset >> 8;
+        entry->offset[2] = r->value_offset >> 16;
+        entry->offset[3] = r->value_offset >> 24;
+    } else {
+        entry->offset[0] = r->value_offset >> 24;
+        entry->offset[1] = r->value_offset >> 16;
+        entry->offset[2] = r->value_offset >> 8;
+        entry->offset[3] = r->value_offset;
+    }
+}
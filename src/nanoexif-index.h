@@ -0,0 +1,44 @@
+#ifndef NANOEXIF_INDEX_H__
+#define NANOEXIF_INDEX_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <nanoexif.h>
+
+/**
+ * struct nanoexif_index_record describe one entry of every ifd, with its value located.
+ * 16 bytes, four records per cache line.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t value_offset; /* offset of the value bytes in the tiff, for nanoexif_range(). inline values point into the entry itself */
+    uint16_t tag;
+    uint16_t type;
+    uint8_t  ifd;          /* nanoexif_ifd_kind */
+    uint8_t  dir;          /* the order of its ifd in the walk */
+    uint16_t index;        /* the position in its ifd. dir and index keep the file order of duplicated tags */
+} nanoexif_index_record;
+
+/**
+ * struct nanoexif_index is the entries of every reachable ifd, sorted by (ifd, tag).
+ * It refers the buffer of ne, so it is valid while ne is.
+ */
+typedef struct {
+    nanoexif * ne;
+    size_t n;
+    nanoexif_index_record * records; /* in the same allocation */
+} nanoexif_index;
+
+nanoexif_index * nanoexif_index_build(nanoexif * ne, uint32_t ifd0_offset);
+void nanoexif_index_free(nanoexif_index * idx);
+const nanoexif_index_record * nanoexif_index_find(const nanoexif_index * idx, nanoexif_ifd_kind ifd, uint16_t tag);
+void nanoexif_index_entry(const nanoexif_index * idx, const nanoexif_index_record * r, nanoexif_ifd_entry * entry);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_INDEX_H__ */
@@ -0,0 +1,46 @@
+#define _POSIX_C_SOURCE 200809L
+#include <nanoexif-io.h>
+#include <nanoexif.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @file nanoexif-io.c
+ */
+
+/* unlike pread(2), a range read gives all of len unless the file ends. */
+static int64_t file_read_at(void * ctx, uint64_t offset, size_t len, uint8_t * buf) {
+    nanoexif_file_io * f = ctx;
+    if (f->latency_us) {
+        struct timespec ts = { f->latency_us / 1000000, (long)(f->latency_us % 1000000) * 1000 };
+        while (nanosleep(&ts, &ts) != 0 && errno == EINTR) { }
+    }
+    f->calls++;
+
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = pread(f->fd, buf+got, len-got, offset+got);
+        if (r < 0 && errno == EINTR) { continue; }
+        if (r < 0) { return -1; }
+        if (r == 0) { break; }
+        got += r;
+    }
+    f->bytes += got;
+    return got;
+}
+
+/** set up the file backed io.
+ * @param nanoexif_file_io * f: will be set. pass &f->io to nanoexif_init_io().
+ * @param int fd: the file. it is not closed.
+ * @param unsigned latency_us: microseconds to sleep in each read_at. 0 for none.
+ */
+void nanoexif_file_io_init(nanoexif_file_io * f, int fd, unsigned latency_us) {
+    f->io.read_at    = file_read_at;
+    f->io.ctx        = f;
+    f->fd            = fd;
+    f->latency_us    = latency_us;
+    f->calls         = 0;
+    f->bytes         = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef NANOEXIF_IO_H__
+#define NANOEXIF_IO_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <nanoexif.h>
+
+/**
+ * struct nanoexif_file_io is a nanoexif_io over a local file, standing in for a remote store in tests and benchmarks.
+ * Each read_at sleeps latency_us first, as a round trip would take, and counts itself.
+ */
+typedef struct {
+    nanoexif_io io;
+    int fd;
+    unsigned latency_us;
+    unsigned calls;
+    uint64_t bytes;
+} nanoexif_file_io;
+
+void nanoexif_file_io_init(nanoexif_file_io * f, int fd, unsigned latency_us);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_IO_H__ */
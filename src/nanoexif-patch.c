@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
+#include <nanoexif-patch.h>
+#include <nanoexif.h>
+#include <nanoexif-private.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/**
+ * @file nanoexif-patch.c
+ */
+
+/* the value to write, and the types it may overwrite. */
+typedef struct {
+    uint16_t types[2];
+    size_t width; /* bytes of each word */
+    size_t n;     /* words */
+    uint32_t v[2];
+} patch_value;
+
+static size_t encode(const patch_value * pv, nanoexif_endian endian, uint8_t * out) {
+    size_t i, j;
+    for (i=0; i<pv->n; i++) {
+        for (j=0; j<pv->width; j++) {
+            size_t shift = endian == NANOEXIF_LITTLE_ENDIAN ? j : pv->width-1-j;
+            out[i*pv->width+j] = pv->v[i] >> (shift*8);
+        }
+    }
+    return pv->n * pv->width;
+}
+
+/* find the entry, check its type, and return the offset of its first value in the tiff. */
+static bool locate(nanoexif * ne, uint32_t ifd0_offset, nanoexif_ifd_kind ifd, uint16_t tag, const patch_value * pv, uint32_t * value_offset) {
+    nanoexif_tag_key key = { ifd, tag };
+    nanoexif_query_result res;
+    if (!nanoexif_query(ne, ifd0_offset, &key, 1, &res)) { return false; }
+    if (res.entry.type != pv->types[0] && res.entry.type != pv->types[1]) { return false; }
+    if (res.entry.count == 0) { return false; }
+
+    if ((uint64_t)nanoexif_type_size(res.entry.type) * res.entry.count <= 4) {
+        *value_offset = res.offset + 8;
+    } else {
+        *value_offset = read_32(ne->endian, res.entry.offset);
+    }
+    return nanoexif_range(ne, *value_offset, pv->n * pv->width) != NULL;
+}
+
+static bool is_tiff(const uint8_t * data, size_t len) {
+    return len >= 2 && (memcmp(data, "II", 2) == 0 || memcmp(data, "MM", 2) == 0);
+}
+
+static bool patch_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, const patch_value * pv) {
+    uint32_t ifd0_offset, value_offset;
+    nanoexif * ne = is_tiff(data, len)
+        ? nanoexif_init_tiff(data, len, &ifd0_offset)
+        : nanoexif_init_from_memory(data, len, &ifd0_offset);
+    if (!ne) { return false; }
+    bool ok = locate(ne, ifd0_offset, ifd, tag, pv, &value_offset);
+    if (ok) {
+        /* ne->buf points into data */
+        encode(pv, ne->endian, data + (ne->buf - data) + value_offset);
+    }
+    nanoexif_free(ne);
+    return ok;
+}
+
+static bool patch_fd(int fd, nanoexif_ifd_kind ifd, uint16_t tag, const patch_value * pv) {
+    uint8_t magic[2];
+    if (pread(fd, magic, 2, 0) != 2) { return false; }
+
+    uint32_t ifd0_offset, value_offset;
+    uint8_t * buf = NULL;
+    nanoexif * ne;
+    off_t base = 0;
+    if (is_tiff(magic, 2)) {
+        ne = nanoexif_init_tiff_fd(fd, 0, &ifd0_offset, NULL);
+    } else {
+        /* read the head of the jpeg up to the end of APP1 */
+        size_t len = 0, want = NANOEXIF_PREFIX_SIZE;
+        ne = NULL;
+        while (want > len) {
+            uint8_t * tmp = realloc(buf, want);
+            if (!tmp) { break; }
+            buf = tmp;
+            ssize_t r = pread(fd, buf+len, want-len, len);
+            if (r < 0 && errno == EINTR) { continue; }
+            if (r <= 0) { break; }
+            len += r;
+            size_t extent = nanoexif_exif_extent(buf, len);
+            if (extent == 0) { break; }
+            if (extent <= len) {
+                ne = nanoexif_init_from_memory(buf, len, &ifd0_offset);
+                break;
+            }
+            want = extent > len + NANOEXIF_PREFIX_SIZE ? extent : len + NANOEXIF_PREFIX_SIZE;
+        }
+        if (ne) { base = ne->buf - buf; }
+    }
+    if (!ne) {
+        free(buf);
+        return false;
+    }
+
+    bool ok = locate(ne, ifd0_offset, ifd, tag, pv, &value_offset);
+    if (ok) {
+        uint8_t bytes[8];
+        size_t n = encode(pv, ne->endian, bytes);
+        ok = pwrite(fd, bytes, n, base + value_offset) == (ssize_t)n;
+    }
+    nanoexif_free(ne);
+    free(buf);
+    return ok;
+}
+
+static patch_value short_value(uint16_t value) {
+    patch_value pv = { { NANOEXIF_TYPE_SHORT, NANOEXIF_TYPE_SSHORT }, 2, 1, { value, 0 } };
+    return pv;
+}
+
+static patch_value long_value(uint32_t value) {
+    patch_value pv = { { NANOEXIF_TYPE_LONG, NANOEXIF_TYPE_SLONG }, 4, 1, { value, 0 } };
+    return pv;
+}
+
+static patch_value rational_value(uint32_t numerator, uint32_t denominator) {
+    patch_value pv = { { NANOEXIF_TYPE_RATIONAL, NANOEXIF_TYPE_SRATIONAL }, 4, 2, { numerator, denominator } };
+    return pv;
+}
+
+/** overwrite the SHORT value of the entry in the file, with one pwrite(2).
+ * @param int fd: file descriptor opened for reading and writing. the file offset is not changed.
+ * @param nanoexif_ifd_kind ifd: the ifd which has the tag
+ * @param uint16_t tag: the tag to patch. e.g. NANOEXIF_TAG_ORIENTATION
+ * @param uint16_t value: the new value. if the entry has several values, the first one is overwritten.
+ * @return true if succeeded. false if the entry is not found, is not SHORT or SSHORT, or the write failed.
+ */
+bool nanoexif_patch_short(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint16_t value) {
+    patch_value pv = short_value(value);
+    return patch_fd(fd, ifd, tag, &pv);
+}
+
+/** ditto, for LONG or SLONG.
+ */
+bool nanoexif_patch_long(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t value) {
+    patch_value pv = long_value(value);
+    return patch_fd(fd, ifd, tag, &pv);
+}
+
+/** ditto, for RATIONAL or SRATIONAL.
+ */
+bool nanoexif_patch_rational(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t numerator, uint32_t denominator) {
+    patch_value pv = rational_value(numerator, denominator);
+    return patch_fd(fd, ifd, tag, &pv);
+}
+
+/** overwrite the SHORT value of the entry in the jpeg or tiff file image on memory.
+ * @param uint8_t * data: whole file, or the head of it up to the end of APP1. a writable mmap(MAP_SHARED) of the file patches the file.
+ * @param size_t len: bytes of data
+ * @return true if succeeded.
+ *
+ * Same as nanoexif_patch_short(), but writes into data.
+ */
+bool nanoexif_patch_short_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint16_t value) {
+    patch_value pv = short_value(value);
+    return patch_memory(data, len, ifd, tag, &pv);
+}
+
+/** ditto, for LONG or SLONG.
+ */
+bool nanoexif_patch_long_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t value) {
+    patch_value pv = long_value(value);
+    return patch_memory(data, len, ifd, tag, &pv);
+}
+
+/** ditto, for RATIONAL or SRATIONAL.
+ */
+bool nanoexif_patch_rational_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t numerator, uint32_t denominator) {
+    patch_value pv = rational_value(numerator, denominator);
+    return patch_memory(data, len, ifd, tag, &pv);
+}
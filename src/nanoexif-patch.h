@@ -0,0 +1,28 @@
+#ifndef NANOEXIF_PATCH_H__
+#define NANOEXIF_PATCH_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <nanoexif.h>
+
+/*
+ * overwrite the first value of an existing entry in place, in the file's endian.
+ * The entry should already have the type(SHORT, LONG, RATIONAL; or the signed one); nothing is added or moved,
+ * so the rest of the file stays byte for byte the same. Works on jpeg and tiff.
+ */
+bool nanoexif_patch_short(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint16_t value);
+bool nanoexif_patch_long(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t value);
+bool nanoexif_patch_rational(int fd, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t numerator, uint32_t denominator);
+bool nanoexif_patch_short_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint16_t value);
+bool nanoexif_patch_long_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t value);
+bool nanoexif_patch_rational_memory(uint8_t * data, size_t len, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t numerator, uint32_t denominator);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_PATCH_H__ */
@@ -0,0 +1,50 @@
+#ifndef NANOEXIF_PRIVATE_H__
+#define NANOEXIF_PRIVATE_H__
+
+/*
+ * helpers shared by the sources of the library. not installed, and not a part of the api.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <nanoexif.h>
+
+static inline uint16_t swap_endian_16(uint16_t i) {
+    return ((i&0xff)<<8) | ((i&0xff00)>>8);
+}
+static inline uint32_t swap_endian_32(uint32_t i) {
+    return ((i&0x000000ff)<<24) | ((i&0x0000ff00)<<8) | ((i&0x00ff0000)>>8) | ((i&0xff000000)>>24);
+}
+
+/* NANOEXIF_MACHINE_ENDIAN is a constant, so each of these compiles to an unaligned load, plus a bswap for the foreign endian. */
+static inline uint16_t le_16(const uint8_t *buf) {
+    uint16_t v;
+    memcpy(&v, buf, 2);
+    return NANOEXIF_MACHINE_ENDIAN == NANOEXIF_LITTLE_ENDIAN ? v : swap_endian_16(v);
+}
+static inline uint16_t be_16(const uint8_t *buf) {
+    uint16_t v;
+    memcpy(&v, buf, 2);
+    return NANOEXIF_MACHINE_ENDIAN == NANOEXIF_BIG_ENDIAN ? v : swap_endian_16(v);
+}
+static inline uint32_t le_32(const uint8_t *buf) {
+    uint32_t v;
+    memcpy(&v, buf, 4);
+    return NANOEXIF_MACHINE_ENDIAN == NANOEXIF_LITTLE_ENDIAN ? v : swap_endian_32(v);
+}
+static inline uint32_t be_32(const uint8_t *buf) {
+    uint32_t v;
+    memcpy(&v, buf, 4);
+    return NANOEXIF_MACHINE_ENDIAN == NANOEXIF_BIG_ENDIAN ? v : swap_endian_32(v);
+}
+
+/* for single fields. loops over entries and values in nanoexif.c use the decoders specialized by endian. */
+static inline uint32_t read_32(nanoexif_endian endian, const uint8_t *buf) {
+    return endian == NANOEXIF_LITTLE_ENDIAN ? le_32(buf) : be_32(buf);
+}
+
+static inline uint16_t read_16(nanoexif_endian endian, const uint8_t *buf) {
+    return endian == NANOEXIF_LITTLE_ENDIAN ? le_16(buf) : be_16(buf);
+}
+
+#endif  /* NANOEXIF_PRIVATE_H__ */
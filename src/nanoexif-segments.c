@@ -0,0 +1,126 @@
+#include <nanoexif-segments.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file nanoexif-segments.c
+ */
+
+/** list the marker segments of the jpeg header, from SOI to SOS, in one pass.
+ * @param const uint8_t * data: the head of the jpeg file
+ * @param size_t len: bytes of data
+ * @param nanoexif_segment * segs: the segments will be set, up to cap.
+ * @param size_t cap: the number of elements of segs
+ * @param nanoexif_segments_status * status: how the scan ended will be set. may be NULL.
+ * @return the number of segments in the header. if it is greater than cap, only the first cap are stored; call again with a larger array.
+ *
+ * A segment is listed only if all of its payload is in data. Nothing is copied; the payloads are in data.
+ * NANOEXIF_SEGMENTS_MORE means the header may complete with more of the file; NANOEXIF_SEGMENTS_STOPPED means it never will.
+ */
+size_t nanoexif_segments(const uint8_t * data, size_t len, nanoexif_segment * segs, size_t cap, nanoexif_segments_status * status) {
+    nanoexif_segments_status local;
+    if (!status) { status = &local; }
+    size_t n = 0;
+    *status = NANOEXIF_SEGMENTS_STOPPED;
+    if ((len >= 1 && data[0] != 0xFF) || (len >= 2 && data[1] != 0xD8)) { return 0; }
+    *status = NANOEXIF_SEGMENTS_MORE;
+    if (len < 2) { return 0; }
+
+    size_t pos = 2;
+    while (pos + 2 <= len) {
+        if (data[pos] != 0xFF) {
+            *status = NANOEXIF_SEGMENTS_STOPPED;
+            return n;
+        }
+        uint8_t marker = data[pos+1];
+        if (marker == 0xFF) { /* fill byte */
+            pos++;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) { /* TEM, RSTn: no length */
+            pos += 2;
+            continue;
+        }
+        if (marker == 0xD9) { /* EOI before any scan */
+            *status = NANOEXIF_SEGMENTS_STOPPED;
+            return n;
+        }
+        if (pos + 4 > len) { return n; }
+
+        /* marker length is always big endian */
+        uint16_t seg_len = (data[pos+2]<<8) | data[pos+3];
+        if (seg_len < 2) {
+            *status = NANOEXIF_SEGMENTS_STOPPED;
+            return n;
+        }
+        if (pos + 2 + seg_len > len) { return n; }
+        if (n < cap) {
+            segs[n].marker = marker;
+            segs[n].offset = pos;
+            segs[n].length = seg_len;
+        }
+        n++;
+        if (marker == 0xDA) { /* SOS: entropy coded data follows */
+            *status = NANOEXIF_SEGMENTS_COMPLETE;
+            return n;
+        }
+        pos += 2 + seg_len;
+    }
+    return n;
+}
+
+/* the payload starts with the NUL terminated signature. */
+static bool has_signature(const uint8_t * data, const nanoexif_segment * seg, const char * sig, size_t sig_len) {
+    return seg->length - 2 >= sig_len && memcmp(data + seg->offset + 4, sig, sig_len) == 0;
+}
+
+/** tell what the segment holds, from its marker and the signature at the top of its payload.
+ * @param const uint8_t * data: the data given to nanoexif_segments()
+ * @param const nanoexif_segment * seg
+ * @return the kind. NANOEXIF_SEG_UNKNOWN for the others.
+ */
+nanoexif_segment_kind nanoexif_segment_identify(const uint8_t * data, const nanoexif_segment * seg) {
+    switch (seg->marker) {
+    case 0xE0:
+        return has_signature(data, seg, "JFIF", 5) ? NANOEXIF_SEG_JFIF : NANOEXIF_SEG_UNKNOWN;
+    case 0xE1:
+        if (has_signature(data, seg, "Exif\0", 6)) { return NANOEXIF_SEG_EXIF; }
+        if (has_signature(data, seg, "http://ns.adobe.com/xap/1.0/", 29)) { return NANOEXIF_SEG_XMP; }
+        return NANOEXIF_SEG_UNKNOWN;
+    case 0xE2:
+        if (has_signature(data, seg, "ICC_PROFILE", 12)) { return NANOEXIF_SEG_ICC; }
+        if (has_signature(data, seg, "MPF", 4)) { return NANOEXIF_SEG_MPF; }
+        return NANOEXIF_SEG_UNKNOWN;
+    case 0xED:
+        return has_signature(data, seg, "Photoshop 3.0", 14) ? NANOEXIF_SEG_IPTC : NANOEXIF_SEG_UNKNOWN;
+    case 0xEE:
+        return has_signature(data, seg, "Adobe", 5) ? NANOEXIF_SEG_ADOBE : NANOEXIF_SEG_UNKNOWN;
+    case 0xC4: return NANOEXIF_SEG_DHT;
+    case 0xC8: return NANOEXIF_SEG_UNKNOWN; /* JPG */
+    case 0xCC: return NANOEXIF_SEG_UNKNOWN; /* DAC */
+    case 0xDB: return NANOEXIF_SEG_DQT;
+    case 0xDD: return NANOEXIF_SEG_DRI;
+    case 0xDA: return NANOEXIF_SEG_SOS;
+    case 0xFE: return NANOEXIF_SEG_COM;
+    }
+    if (seg->marker >= 0xC0 && seg->marker <= 0xCF) { return NANOEXIF_SEG_SOF; }
+    return NANOEXIF_SEG_UNKNOWN;
+}
+
+/** read the image size from SOF segment.
+ * @param const uint8_t * data: the data given to nanoexif_segments()
+ * @param const nanoexif_segment * seg: SOF segment
+ * @param uint16_t * width: will be set.
+ * @param uint16_t * height: will be set. 0 means it is defined by DNL after the first scan.
+ * @param uint8_t * components: the number of color components will be set. may be NULL.
+ * @return true if seg is SOF.
+ */
+bool nanoexif_sof_dimensions(const uint8_t * data, const nanoexif_segment * seg, uint16_t * width, uint16_t * height, uint8_t * components) {
+    if (nanoexif_segment_identify(data, seg) != NANOEXIF_SEG_SOF || seg->length < 8) { return false; }
+    const uint8_t * p = data + seg->offset + 4;
+    /* precision(1) height(2) width(2) components(1) */
+    *height = (p[1]<<8) | p[2];
+    *width  = (p[3]<<8) | p[4];
+    if (components) { *components = p[5]; }
+    return true;
+}
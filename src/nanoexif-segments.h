@@ -0,0 +1,55 @@
+#ifndef NANOEXIF_SEGMENTS_H__
+#define NANOEXIF_SEGMENTS_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * struct nanoexif_segment locates one marker segment in the jpeg header.
+ * The payload is data[offset+4 .. offset+2+length). SOS is the last one, its payload is the scan header.
+ */
+typedef struct {
+    uint8_t  marker;  /* the byte after 0xFF: 0xE1 for APP1, 0xC0 for SOF0, ... */
+    uint32_t offset;  /* position of the 0xFF from the top of the file */
+    uint32_t length;  /* the length field, which counts itself but not the marker */
+} nanoexif_segment;
+
+/**
+ * enum nanoexif_segment_kind is what nanoexif_segment_identify() tells.
+ */
+typedef enum {
+    NANOEXIF_SEG_UNKNOWN,
+    NANOEXIF_SEG_JFIF,    /* APP0 "JFIF" */
+    NANOEXIF_SEG_EXIF,    /* APP1 "Exif" */
+    NANOEXIF_SEG_XMP,     /* APP1 "http://ns.adobe.com/xap/1.0/" */
+    NANOEXIF_SEG_ICC,     /* APP2 "ICC_PROFILE", may be split in several segments */
+    NANOEXIF_SEG_MPF,     /* APP2 "MPF" */
+    NANOEXIF_SEG_IPTC,    /* APP13 "Photoshop 3.0" */
+    NANOEXIF_SEG_ADOBE,   /* APP14 "Adobe" */
+    NANOEXIF_SEG_SOF,     /* SOF0-SOF15, except DHT, JPG and DAC */
+    NANOEXIF_SEG_DQT,
+    NANOEXIF_SEG_DHT,
+    NANOEXIF_SEG_DRI,
+    NANOEXIF_SEG_COM,
+    NANOEXIF_SEG_SOS,
+} nanoexif_segment_kind;
+
+typedef enum {
+    NANOEXIF_SEGMENTS_STOPPED  = -1, /* not a jpeg, a broken marker, or EOI before any scan. more data does not help */
+    NANOEXIF_SEGMENTS_MORE     = 0,  /* data ends in the header */
+    NANOEXIF_SEGMENTS_COMPLETE = 1,  /* reached SOS */
+} nanoexif_segments_status;
+
+size_t nanoexif_segments(const uint8_t * data, size_t len, nanoexif_segment * segs, size_t cap, nanoexif_segments_status * status);
+nanoexif_segment_kind nanoexif_segment_identify(const uint8_t * data, const nanoexif_segment * seg);
+bool nanoexif_sof_dimensions(const uint8_t * data, const nanoexif_segment * seg, uint16_t * width, uint16_t * height, uint8_t * components);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_SEGMENTS_H__ */
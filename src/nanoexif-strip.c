@@ -0,0 +1,157 @@
+#define _GNU_SOURCE
+#include <nanoexif-strip.h>
+#include <nanoexif-segments.h>
+#include <nanoexif.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+/**
+ * @file nanoexif-strip.c
+ */
+
+/* bytes per copy_file_range/sendfile call. the kernel caps a call at about 2GB anyway. */
+#define NANOEXIF_COPY_CHUNK (1<<30)
+
+/* the most bytes read for the header. the segments are 64KB at most, but there may be many of them(a split ICC profile, ...). */
+#define NANOEXIF_STRIP_HEADER_MAX (16*1024*1024)
+
+static bool write_all(int fd, const uint8_t * buf, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, buf, len);
+        if (w < 0 && errno == EINTR) { continue; }
+        if (w <= 0) { return false; }
+        buf += w;
+        len -= w;
+    }
+    return true;
+}
+
+/* read from the top of the file until the header is complete, up to SOS. NULL if it is not a jpeg, or the header is too large. */
+static uint8_t * read_header(int fd, size_t * len) {
+    uint8_t * buf = NULL;
+    size_t got = 0, cap = 0;
+    while (1) {
+        if (got == cap) {
+            if (cap >= NANOEXIF_STRIP_HEADER_MAX) { break; }
+            cap = cap ? cap*2 : NANOEXIF_PREFIX_SIZE;
+            uint8_t * tmp = realloc(buf, cap);
+            if (!tmp) { break; }
+            buf = tmp;
+        }
+        ssize_t r = pread(fd, buf+got, cap-got, got);
+        if (r < 0 && errno == EINTR) { continue; }
+        if (r <= 0) { break; }
+        got += r;
+
+        nanoexif_segments_status status;
+        nanoexif_segments(buf, got, NULL, 0, &status);
+        if (status == NANOEXIF_SEGMENTS_COMPLETE) {
+            *len = got;
+            return buf;
+        }
+        if (status == NANOEXIF_SEGMENTS_STOPPED) { break; }
+    }
+    free(buf);
+    return NULL;
+}
+
+/* the errors which mean "this pair of fds is not supported", not "the copy failed". */
+static bool unsupported(int err) {
+    return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == EBADF;
+}
+
+/* copy [offset, EOF) of in_fd to out_fd. the data stays in the kernel if it can. */
+static bool copy_rest(int in_fd, int out_fd, off_t offset) {
+#ifdef __linux__
+    /* copy_file_range: file to file, and may share the extents on reflink capable filesystems */
+    bool first = true;
+    while (1) {
+        off_t off = offset;
+        ssize_t n = copy_file_range(in_fd, &off, out_fd, NULL, NANOEXIF_COPY_CHUNK, 0);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n < 0 && first && unsupported(errno)) { break; }
+        if (n < 0) { return false; }
+        if (n == 0) { return true; }
+        offset = off;
+        first = false;
+    }
+
+    /* sendfile: file to anything, pipes and sockets too */
+    first = true;
+    while (1) {
+        off_t off = offset;
+        ssize_t n = sendfile(out_fd, in_fd, &off, NANOEXIF_COPY_CHUNK);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n < 0 && first && unsupported(errno)) { break; }
+        if (n < 0) { return false; }
+        if (n == 0) { return true; }
+        offset = off;
+        first = false;
+    }
+#endif
+
+    uint8_t * buf = malloc(NANOEXIF_PREFIX_SIZE);
+    if (!buf) { return false; }
+    bool ok = true;
+    while (ok) {
+        ssize_t r = pread(in_fd, buf, NANOEXIF_PREFIX_SIZE, offset);
+        if (r < 0 && errno == EINTR) { continue; }
+        if (r <= 0) {
+            ok = r == 0;
+            break;
+        }
+        ok = write_all(out_fd, buf, r);
+        offset += r;
+    }
+    free(buf);
+    return ok;
+}
+
+/** copy the jpeg, dropping the metadata segments which the policy does not keep.
+ * @param int in_fd: the jpeg file, opened for reading. its file offset is not changed.
+ * @param int out_fd: the output. written at its file offset; a file, a pipe or a socket.
+ * @param uint32_t keep: mask of NANOEXIF_STRIP_KEEP(kind), or NANOEXIF_STRIP_DEFAULT.
+ * @return true if succeeded. false if in_fd is not a jpeg, or on I/O errors. out_fd may have been written partially.
+ *
+ * Only the header, up to SOS, is read and rewritten. The entropy coded data after it is copied by the kernel
+ * with copy_file_range(2) or sendfile(2), and falls back to read/write where they are not available.
+ * Bytes after EOI(e.g. the secondary images of MPF) are copied as is. Keeping MPF while dropping a segment after it
+ * breaks the offsets in MPF.
+ */
+bool nanoexif_strip(int in_fd, int out_fd, uint32_t keep) {
+    size_t len;
+    uint8_t * buf = read_header(in_fd, &len);
+    if (!buf) { return false; }
+
+    size_t n = nanoexif_segments(buf, len, NULL, 0, NULL);
+    nanoexif_segment * segs = malloc(sizeof(nanoexif_segment) * n);
+    if (!segs) {
+        free(buf);
+        return false;
+    }
+    nanoexif_segments(buf, len, segs, n, NULL);
+
+    /* pack SOI and the kept segments at the top of buf. the output is never longer than the input. */
+    size_t out = 2, i;
+    for (i=0; i<n; i++) {
+        uint8_t m = segs[i].marker;
+        if ((m >= 0xE0 && m <= 0xEF) || m == 0xFE) {
+            if (!(keep & NANOEXIF_STRIP_KEEP(nanoexif_segment_identify(buf, &segs[i])))) { continue; }
+        }
+        memmove(buf + out, buf + segs[i].offset, 2 + segs[i].length);
+        out += 2 + segs[i].length;
+    }
+    off_t scan = segs[n-1].offset + 2 + segs[n-1].length;
+    free(segs);
+
+    bool ok = write_all(out_fd, buf, out);
+    free(buf);
+    return ok && copy_rest(in_fd, out_fd, scan);
+}
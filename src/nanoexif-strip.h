@@ -0,0 +1,27 @@
+#ifndef NANOEXIF_STRIP_H__
+#define NANOEXIF_STRIP_H__
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <nanoexif-segments.h>
+
+/**
+ * the policy of nanoexif_strip() is a mask of the segment kinds to keep.
+ * It decides on APP0-APP15 and COM segments(NANOEXIF_SEG_UNKNOWN for APPn with an unknown signature).
+ * DQT, SOF, DHT, DRI and SOS are needed to decode the image and are always kept.
+ */
+#define NANOEXIF_STRIP_KEEP(kind) (1u<<(kind))
+
+/* keeps what changes how the image looks: JFIF, the color profile and the Adobe color transform. */
+#define NANOEXIF_STRIP_DEFAULT (NANOEXIF_STRIP_KEEP(NANOEXIF_SEG_JFIF) | NANOEXIF_STRIP_KEEP(NANOEXIF_SEG_ICC) | NANOEXIF_STRIP_KEEP(NANOEXIF_SEG_ADOBE))
+
+bool nanoexif_strip(int in_fd, int out_fd, uint32_t keep);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
+#endif  /* NANOEXIF_STRIP_H__ */
@@ -1,366 +1,913 @@
+/* generated by tools/tag-name.pl. do not edit. */
 #include <stdint.h>
-#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nanoexif.h"
 
-const char *nanoexif_tag_name(uint32_t n) {
-    switch (n) {
-    case 0x0001: return "InteropIndex";
-    case 0x0002: return "InteropVersion";
-    case 0x000B: return "ProcessingSoftware";
-    case 0x00FE: return "SubfileType";
-    case 0x00FF: return "OldSubfileType";
-    case 0x0100: return "ImageWidth";
-    case 0x0101: return "ImageHeight";
-    case 0x0102: return "BitsPerSample";
-    case 0x0103: return "Compression";
-    case 0x0106: return "PhotometricInterpretation";
-    case 0x0107: return "Thresholding";
-    case 0x0108: return "CellWidth";
-    case 0x0109: return "CellLength";
-    case 0x010A: return "FillOrder";
-    case 0x010D: return "DocumentName";
-    case 0x010E: return "ImageDescription";
-    case 0x010F: return "Make";
-    case 0x0110: return "Model";
-    case 0x0112: return "Orientation";
-    case 0x0115: return "SamplesPerPixel";
-    case 0x0116: return "RowsPerStrip";
-    case 0x0118: return "MinSampleValue";
-    case 0x0119: return "MaxSampleValue";
-    case 0x011A: return "XResolution";
-    case 0x011B: return "YResolution";
-    case 0x011C: return "PlanarConfiguration";
-    case 0x011D: return "PageName";
-    case 0x011E: return "XPosition";
-    case 0x011F: return "YPosition";
-    case 0x0120: return "FreeOffsets";
-    case 0x0121: return "FreeByteCounts";
-    case 0x0122: return "GrayResponseUnit";
-    case 0x0123: return "GrayResponseCurve";
-    case 0x0124: return "T4Options";
-    case 0x0125: return "T6Options";
-    case 0x0128: return "ResolutionUnit";
-    case 0x0129: return "PageNumber";
-    case 0x012C: return "ColorResponseUnit";
-    case 0x012D: return "TransferFunction";
-    case 0x0131: return "Software";
-    case 0x0132: return "ModifyDate";
-    case 0x013B: return "Artist";
-    case 0x013C: return "HostComputer";
-    case 0x013D: return "Predictor";
-    case 0x013E: return "WhitePoint";
-    case 0x013F: return "PrimaryChromaticities";
-    case 0x0140: return "ColorMap";
-    case 0x0141: return "HalftoneHints";
-    case 0x0142: return "TileWidth";
-    case 0x0143: return "TileLength";
-    case 0x0144: return "TileOffsets";
-    case 0x0145: return "TileByteCounts";
-    case 0x0146: return "BadFaxLines";
-    case 0x0147: return "CleanFaxData";
-    case 0x0148: return "ConsecutiveBadFaxLines";
-    case 0x014C: return "InkSet";
-    case 0x014D: return "InkNames";
-    case 0x014E: return "NumberofInks";
-    case 0x0150: return "DotRange";
-    case 0x0151: return "TargetPrinter";
-    case 0x0152: return "ExtraSamples";
-    case 0x0153: return "SampleFormat";
-    case 0x0154: return "SMinSampleValue";
-    case 0x0155: return "SMaxSampleValue";
-    case 0x0156: return "TransferRange";
-    case 0x0157: return "ClipPath";
-    case 0x0158: return "XClipPathUnits";
-    case 0x0159: return "YClipPathUnits";
-    case 0x015A: return "Indexed";
-    case 0x015B: return "JPEGTables";
-    case 0x015F: return "OPIProxy";
-    case 0x0190: return "GlobalParametersIFD";
-    case 0x0191: return "ProfileType";
-    case 0x0192: return "FaxProfile";
-    case 0x0193: return "CodingMethods";
-    case 0x0194: return "VersionYear";
-    case 0x0195: return "ModeNumber";
-    case 0x01B1: return "Decode";
-    case 0x01B2: return "DefaultImageColor";
-    case 0x01B5: return "JPEGTables";
-    case 0x0200: return "JPEGProc";
-    case 0x0203: return "JPEGRestartInterval";
-    case 0x0205: return "JPEGLosslessPredictors";
-    case 0x0206: return "JPEGPointTransforms";
-    case 0x0207: return "JPEGQTables";
-    case 0x0208: return "JPEGDCTables";
-    case 0x0209: return "JPEGACTables";
-    case 0x0211: return "YCbCrCoefficients";
-    case 0x0212: return "YCbCrSubSampling";
-    case 0x0213: return "YCbCrPositioning";
-    case 0x0214: return "ReferenceBlackWhite";
-    case 0x022F: return "StripRowCounts";
-    case 0x02BC: return "ApplicationNotes";
-    case 0x1000: return "RelatedImageFileFormat";
-    case 0x1001: return "RelatedImageWidth";
-    case 0x1002: return "RelatedImageHeight";
-    case 0x4746: return "Rating";
-    case 0x4749: return "RatingPercent";
-    case 0x800D: return "ImageID";
-    case 0x80A4: return "WangAnnotation";
-    case 0x80E3: return "Matteing";
-    case 0x80E4: return "DataType";
-    case 0x80E5: return "ImageDepth";
-    case 0x80E6: return "TileDepth";
-    case 0x827D: return "Model2";
-    case 0x828D: return "CFARepeatPatternDim";
-    case 0x828E: return "CFAPattern2";
-    case 0x828F: return "BatteryLevel";
-    case 0x8290: return "KodakIFD";
-    case 0x8298: return "Copyright";
-    case 0x829A: return "ExposureTime";
-    case 0x829D: return "FNumber";
-    case 0x82A5: return "MDFileTag";
-    case 0x82A6: return "MDScalePixel";
-    case 0x82A7: return "MDColorTable";
-    case 0x82A8: return "MDLabName";
-    case 0x82A9: return "MDSampleInfo";
-    case 0x82AA: return "MDPrepDate";
-    case 0x82AB: return "MDPrepTime";
-    case 0x82AC: return "MDFileUnits";
-    case 0x830E: return "PixelScale";
-    case 0x83BB: return "IPTC-NAA";
-    case 0x847E: return "IntergraphPacketData";
-    case 0x847F: return "IntergraphFlagRegisters";
-    case 0x8480: return "IntergraphMatrix";
-    case 0x8482: return "ModelTiePoint";
-    case 0x84E0: return "Site";
-    case 0x84E1: return "ColorSequence";
-    case 0x84E2: return "IT8Header";
-    case 0x84E3: return "RasterPadding";
-    case 0x84E4: return "BitsPerRunLength";
-    case 0x84E5: return "BitsPerExtendedRunLength";
-    case 0x84E6: return "ColorTable";
-    case 0x84E7: return "ImageColorIndicator";
-    case 0x84E8: return "BackgroundColorIndicator";
-    case 0x84E9: return "ImageColorValue";
-    case 0x84EA: return "BackgroundColorValue";
-    case 0x84EB: return "PixelIntensityRange";
-    case 0x84EC: return "TransparencyIndicator";
-    case 0x84ED: return "ColorCharacterization";
-    case 0x84EE: return "HCUsage";
-    case 0x84EF: return "TrapIndicator";
-    case 0x84F0: return "CMYKEquivalent";
-    case 0x8546: return "SEMInfo";
-    case 0x8568: return "AFCP_IPTC";
-    case 0x85D8: return "ModelTransform";
-    case 0x8602: return "WB_GRGBLevels";
-    case 0x8606: return "LeafData";
-    case 0x8649: return "PhotoshopSettings";
-    case 0x8769: return "ExifOffset";
-    case 0x8773: return "ICC_Profile";
-    case 0x87AC: return "ImageLayer";
-    case 0x87AF: return "GeoTiffDirectory";
-    case 0x87B0: return "GeoTiffDoubleParams";
-    case 0x87B1: return "GeoTiffAsciiParams";
-    case 0x8822: return "ExposureProgram";
-    case 0x8824: return "SpectralSensitivity";
-    case 0x8825: return "GPSInfo";
-    case 0x8827: return "ISO";
-    case 0x8828: return "Opto-ElectricConvFactor";
-    case 0x8829: return "Interlace";
-    case 0x882A: return "TimeZoneOffset";
-    case 0x882B: return "SelfTimerMode";
-    case 0x885C: return "FaxRecvParams";
-    case 0x885D: return "FaxSubAddress";
-    case 0x885E: return "FaxRecvTime";
-    case 0x888A: return "LeafSubIFD";
-    case 0x9000: return "ExifVersion";
-    case 0x9003: return "DateTimeOriginal";
-    case 0x9004: return "CreateDate";
-    case 0x9101: return "ComponentsConfiguration";
-    case 0x9102: return "CompressedBitsPerPixel";
-    case 0x9201: return "ShutterSpeedValue";
-    case 0x9202: return "ApertureValue";
-    case 0x9203: return "BrightnessValue";
-    case 0x9204: return "ExposureCompensation";
-    case 0x9205: return "MaxApertureValue";
-    case 0x9206: return "SubjectDistance";
-    case 0x9207: return "MeteringMode";
-    case 0x9208: return "LightSource";
-    case 0x9209: return "Flash";
-    case 0x920A: return "FocalLength";
-    case 0x920B: return "FlashEnergy";
-    case 0x920C: return "SpatialFrequencyResponse";
-    case 0x920D: return "Noise";
-    case 0x920E: return "FocalPlaneXResolution";
-    case 0x920F: return "FocalPlaneYResolution";
-    case 0x9210: return "FocalPlaneResolutionUnit";
-    case 0x9211: return "ImageNumber";
-    case 0x9212: return "SecurityClassification";
-    case 0x9213: return "ImageHistory";
-    case 0x9214: return "SubjectArea";
-    case 0x9215: return "ExposureIndex";
-    case 0x9216: return "TIFF-EPStandardID";
-    case 0x9217: return "SensingMethod";
-    case 0x923F: return "StoNits";
-    case 0x9286: return "UserComment";
-    case 0x9290: return "SubSecTime";
-    case 0x9291: return "SubSecTimeOriginal";
-    case 0x9292: return "SubSecTimeDigitized";
-    case 0x932F: return "MSDocumentText";
-    case 0x9330: return "MSPropertySetStorage";
-    case 0x9331: return "MSDocumentTextPosition";
-    case 0x935C: return "ImageSourceData";
-    case 0x9C9B: return "XPTitle";
-    case 0x9C9C: return "XPComment";
-    case 0x9C9D: return "XPAuthor";
-    case 0x9C9E: return "XPKeywords";
-    case 0x9C9F: return "XPSubject";
-    case 0xA000: return "FlashpixVersion";
-    case 0xA001: return "ColorSpace";
-    case 0xA002: return "ExifImageWidth";
-    case 0xA003: return "ExifImageHeight";
-    case 0xA004: return "RelatedSoundFile";
-    case 0xA005: return "InteropOffset";
-    case 0xA20B: return "FlashEnergy";
-    case 0xA20C: return "SpatialFrequencyResponse";
-    case 0xA20D: return "Noise";
-    case 0xA20E: return "FocalPlaneXResolution";
-    case 0xA20F: return "FocalPlaneYResolution";
-    case 0xA210: return "FocalPlaneResolutionUnit";
-    case 0xA211: return "ImageNumber";
-    case 0xA212: return "SecurityClassification";
-    case 0xA213: return "ImageHistory";
-    case 0xA214: return "SubjectLocation";
-    case 0xA215: return "ExposureIndex";
-    case 0xA216: return "TIFF-EPStandardID";
-    case 0xA217: return "SensingMethod";
-    case 0xA300: return "FileSource";
-    case 0xA301: return "SceneType";
-    case 0xA302: return "CFAPattern";
-    case 0xA401: return "CustomRendered";
-    case 0xA402: return "ExposureMode";
-    case 0xA403: return "WhiteBalance";
-    case 0xA404: return "DigitalZoomRatio";
-    case 0xA405: return "FocalLengthIn35mmFormat";
-    case 0xA406: return "SceneCaptureType";
-    case 0xA407: return "GainControl";
-    case 0xA408: return "Contrast";
-    case 0xA409: return "Saturation";
-    case 0xA40A: return "Sharpness";
-    case 0xA40B: return "DeviceSettingDescription";
-    case 0xA40C: return "SubjectDistanceRange";
-    case 0xA420: return "ImageUniqueID";
-    case 0xA480: return "GDALMetadata";
-    case 0xA481: return "GDALNoData";
-    case 0xA500: return "Gamma";
-    case 0xAFC0: return "ExpandSoftware";
-    case 0xAFC1: return "ExpandLens";
-    case 0xAFC2: return "ExpandFilm";
-    case 0xAFC3: return "ExpandFilterLens";
-    case 0xAFC4: return "ExpandScanner";
-    case 0xAFC5: return "ExpandFlashLamp";
-    case 0xBC01: return "PixelFormat";
-    case 0xBC02: return "Transformation";
-    case 0xBC03: return "Uncompressed";
-    case 0xBC04: return "ImageType";
-    case 0xBC80: return "ImageWidth";
-    case 0xBC81: return "ImageHeight";
-    case 0xBC82: return "WidthResolution";
-    case 0xBC83: return "HeightResolution";
-    case 0xBCC0: return "ImageOffset";
-    case 0xBCC1: return "ImageByteCount";
-    case 0xBCC2: return "AlphaOffset";
-    case 0xBCC3: return "AlphaByteCount";
-    case 0xBCC4: return "ImageDataDiscard";
-    case 0xBCC5: return "AlphaDataDiscard";
-    case 0xC427: return "OceScanjobDesc";
-    case 0xC428: return "OceApplicationSelector";
-    case 0xC429: return "OceIDNumber";
-    case 0xC42A: return "OceImageLogic";
-    case 0xC44F: return "Annotations";
-    case 0xC4A5: return "PrintIM";
-    case 0xC612: return "DNGVersion";
-    case 0xC613: return "DNGBackwardVersion";
-    case 0xC614: return "UniqueCameraModel";
-    case 0xC615: return "LocalizedCameraModel";
-    case 0xC616: return "CFAPlaneColor";
-    case 0xC617: return "CFALayout";
-    case 0xC618: return "LinearizationTable";
-    case 0xC619: return "BlackLevelRepeatDim";
-    case 0xC61A: return "BlackLevel";
-    case 0xC61B: return "BlackLevelDeltaH";
-    case 0xC61C: return "BlackLevelDeltaV";
-    case 0xC61D: return "WhiteLevel";
-    case 0xC61E: return "DefaultScale";
-    case 0xC61F: return "DefaultCropOrigin";
-    case 0xC620: return "DefaultCropSize";
-    case 0xC621: return "ColorMatrix1";
-    case 0xC622: return "ColorMatrix2";
-    case 0xC623: return "CameraCalibration1";
-    case 0xC624: return "CameraCalibration2";
-    case 0xC625: return "ReductionMatrix1";
-    case 0xC626: return "ReductionMatrix2";
-    case 0xC627: return "AnalogBalance";
-    case 0xC628: return "AsShotNeutral";
-    case 0xC629: return "AsShotWhiteXY";
-    case 0xC62A: return "BaselineExposure";
-    case 0xC62B: return "BaselineNoise";
-    case 0xC62C: return "BaselineSharpness";
-    case 0xC62D: return "BayerGreenSplit";
-    case 0xC62E: return "LinearResponseLimit";
-    case 0xC62F: return "CameraSerialNumber";
-    case 0xC630: return "DNGLensInfo";
-    case 0xC631: return "ChromaBlurRadius";
-    case 0xC632: return "AntiAliasStrength";
-    case 0xC633: return "ShadowScale";
-    case 0xC635: return "MakerNoteSafety";
-    case 0xC640: return "RawImageSegmentation";
-    case 0xC65A: return "CalibrationIlluminant1";
-    case 0xC65B: return "CalibrationIlluminant2";
-    case 0xC65C: return "BestQualityScale";
-    case 0xC65D: return "RawDataUniqueID";
-    case 0xC660: return "AliasLayerMetadata";
-    case 0xC68B: return "OriginalRawFileName";
-    case 0xC68C: return "OriginalRawFileData";
-    case 0xC68D: return "ActiveArea";
-    case 0xC68E: return "MaskedAreas";
-    case 0xC68F: return "AsShotICCProfile";
-    case 0xC690: return "AsShotPreProfileMatrix";
-    case 0xC691: return "CurrentICCProfile";
-    case 0xC692: return "CurrentPreProfileMatrix";
-    case 0xC6BF: return "ColorimetricReference";
-    case 0xC6D2: return "PanasonicTitle";
-    case 0xC6D3: return "PanasonicTitle2";
-    case 0xC6F3: return "CameraCalibrationSig";
-    case 0xC6F4: return "ProfileCalibrationSig";
-    case 0xC6F5: return "ProfileIFD";
-    case 0xC6F6: return "AsShotProfileName";
-    case 0xC6F7: return "NoiseReductionApplied";
-    case 0xC6F8: return "ProfileName";
-    case 0xC6F9: return "ProfileHueSatMapDims";
-    case 0xC6FA: return "ProfileHueSatMapData1";
-    case 0xC6FB: return "ProfileHueSatMapData2";
-    case 0xC6FC: return "ProfileToneCurve";
-    case 0xC6FD: return "ProfileEmbedPolicy";
-    case 0xC6FE: return "ProfileCopyright";
-    case 0xC714: return "ForwardMatrix1";
-    case 0xC715: return "ForwardMatrix2";
-    case 0xC716: return "PreviewApplicationName";
-    case 0xC717: return "PreviewApplicationVersion";
-    case 0xC718: return "PreviewSettingsName";
-    case 0xC719: return "PreviewSettingsDigest";
-    case 0xC71A: return "PreviewColorSpace";
-    case 0xC71B: return "PreviewDateTime";
-    case 0xC71C: return "RawImageDigest";
-    case 0xC71D: return "OriginalRawFileDigest";
-    case 0xC71E: return "SubTileBlockSize";
-    case 0xC71F: return "RowInterleaveFactor";
-    case 0xC725: return "ProfileLookTableDims";
-    case 0xC726: return "ProfileLookTableData";
-    case 0xC740: return "OpcodeList1";
-    case 0xC741: return "OpcodeList2";
-    case 0xC74E: return "OpcodeList3";
-    case 0xC761: return "NoiseProfile";
-    case 0xEA1C: return "Padding";
-    case 0xEA1D: return "OffsetSchema";
-    case 0xFE00: return "KDC_IFD";
+/**
+ * @file nanoexif-tagname.c
+ */
+
+typedef struct {
+    uint16_t tag;
+    uint8_t  ns;   /* 0: IFD0, IFD1, Exif and Interop. 1: GPS */
+    uint8_t  ifd;  /* nanoexif_ifd_kind the tag is defined in */
+    uint16_t name; /* offset in NAMES */
+} tag_info;
+
+static const char NAMES[] =
+    "BayerGreenSplit\0"
+    "ProfileCopyright\0"
+    "ForwardMatrix2\0"
+    "TimeZoneOffset\0"
+    "GPSImgDirection\0"
+    "ExposureIndex\0"
+    "ProfileLookTableData\0"
+    "ProfileCalibrationSig\0"
+    "Compression\0"
+    "Interlace\0"
+    "NoiseProfile\0"
+    "LocalizedCameraModel\0"
+    "BlackLevelDeltaH\0"
+    "Orientation\0"
+    "Rating\0"
+    "BackgroundColorIndicator\0"
+    "CalibrationIlluminant2\0"
+    "JPEGProc\0"
+    "AsShotICCProfile\0"
+    "CameraCalibrationSig\0"
+    "DateTimeOriginal\0"
+    "ComponentsConfiguration\0"
+    "AlphaByteCount\0"
+    "GPSImgDirectionRef\0"
+    "ProfileIFD\0"
+    "ProfileToneCurve\0"
+    "ImageHeight\0"
+    "JPEGQTables\0"
+    "PrimaryChromaticities\0"
+    "NoiseReductionApplied\0"
+    "ApertureValue\0"
+    "YClipPathUnits\0"
+    "AsShotWhiteXY\0"
+    "ShutterSpeedValue\0"
+    "PreviewSettingsDigest\0"
+    "Matteing\0"
+    "OceApplicationSelector\0"
+    "SpatialFrequencyResponse\0"
+    "RelatedImageFileFormat\0"
+    "OffsetSchema\0"
+    "TileByteCounts\0"
+    "MDColorTable\0"
+    "CleanFaxData\0"
+    "InteropIndex\0"
+    "StripRowCounts\0"
+    "JPEGRestartInterval\0"
+    "OceScanjobDesc\0"
+    "OpcodeList1\0"
+    "ColorCharacterization\0"
+    "GPSAreaInformation\0"
+    "XResolution\0"
+    "GPSLatitude\0"
+    "ModelTiePoint\0"
+    "ProfileName\0"
+    "MeteringMode\0"
+    "GeoTiffAsciiParams\0"
+    "BatteryLevel\0"
+    "ReductionMatrix1\0"
+    "ProcessingSoftware\0"
+    "FaxRecvTime\0"
+    "InkNames\0"
+    "CFALayout\0"
+    "MDLabName\0"
+    "ReductionMatrix2\0"
+    "OpcodeList2\0"
+    "BrightnessValue\0"
+    "RatingPercent\0"
+    "DigitalZoomRatio\0"
+    "GPSTrack\0"
+    "JPEGTables\0"
+    "GPSDestLongitudeRef\0"
+    "AsShotNeutral\0"
+    "MSPropertySetStorage\0"
+    "ModeNumber\0"
+    "FNumber\0"
+    "ColorSpace\0"
+    "GPSStatus\0"
+    "ImageID\0"
+    "ExpandLens\0"
+    "ExifOffset\0"
+    "SceneType\0"
+    "Software\0"
+    "AlphaOffset\0"
+    "ExposureCompensation\0"
+    "Thresholding\0"
+    "GPSLongitudeRef\0"
+    "YCbCrCoefficients\0"
+    "XPTitle\0"
+    "FreeByteCounts\0"
+    "SMaxSampleValue\0"
+    "ImageUniqueID\0"
+    "ImageLayer\0"
+    "DefaultCropOrigin\0"
+    "FillOrder\0"
+    "Copyright\0"
+    "ProfileHueSatMapDims\0"
+    "SubTileBlockSize\0"
+    "GrayResponseUnit\0"
+    "FocalPlaneResolutionUnit\0"
+    "IntergraphFlagRegisters\0"
+    "GPSDestLatitudeRef\0"
+    "ResolutionUnit\0"
+    "ImageOffset\0"
+    "SubSecTime\0"
+    "OpcodeList3\0"
+    "Opto-ElectricConvFactor\0"
+    "FlashEnergy\0"
+    "OriginalRawFileData\0"
+    "RowInterleaveFactor\0"
+    "ProfileHueSatMapData1\0"
+    "TransparencyIndicator\0"
+    "CreateDate\0"
+    "ImageWidth\0"
+    "GDALNoData\0"
+    "GPSMeasureMode\0"
+    "ExpandScanner\0"
+    "FocalLength\0"
+    "KDC_IFD\0"
+    "BaselineNoise\0"
+    "SampleFormat\0"
+    "SubjectDistance\0"
+    "CellLength\0"
+    "ChromaBlurRadius\0"
+    "GPSDestLatitude\0"
+    "WhiteBalance\0"
+    "Gamma\0"
+    "PreviewApplicationVersion\0"
+    "Padding\0"
+    "ICC_Profile\0"
+    "ExtraSamples\0"
+    "Contrast\0"
+    "XPKeywords\0"
+    "GPSSpeed\0"
+    "GPSMapDatum\0"
+    "BitsPerRunLength\0"
+    "CMYKEquivalent\0"
+    "ImageHistory\0"
+    "ReferenceBlackWhite\0"
+    "ImageType\0"
+    "CurrentICCProfile\0"
+    "RawImageSegmentation\0"
+    "FaxProfile\0"
+    "SelfTimerMode\0"
+    "DefaultScale\0"
+    "GPSAltitudeRef\0"
+    "TileDepth\0"
+    "SecurityClassification\0"
+    "Saturation\0"
+    "MDPrepTime\0"
+    "DNGVersion\0"
+    "ColorResponseUnit\0"
+    "XPosition\0"
+    "JPEGACTables\0"
+    "ExpandSoftware\0"
+    "WhiteLevel\0"
+    "HeightResolution\0"
+    "PageName\0"
+    "ImageNumber\0"
+    "FocalPlaneYResolution\0"
+    "WangAnnotation\0"
+    "RawImageDigest\0"
+    "CameraCalibration1\0"
+    "GPSSatellites\0"
+    "ProfileLookTableDims\0"
+    "Indexed\0"
+    "GPSDateStamp\0"
+    "Decode\0"
+    "PreviewDateTime\0"
+    "ExposureProgram\0"
+    "ShadowScale\0"
+    "GPSVersionID\0"
+    "ColorMatrix2\0"
+    "PanasonicTitle\0"
+    "ISO\0"
+    "AsShotPreProfileMatrix\0"
+    "ClipPath\0"
+    "GPSProcessingMethod\0"
+    "CFAPlaneColor\0"
+    "MSDocumentText\0"
+    "ImageSourceData\0"
+    "UniqueCameraModel\0"
+    "MaxSampleValue\0"
+    "OceIDNumber\0"
+    "IPTC-NAA\0"
+    "VersionYear\0"
+    "Uncompressed\0"
+    "ProfileHueSatMapData2\0"
+    "Make\0"
+    "ColorMap\0"
+    "TIFF-EPStandardID\0"
+    "SubfileType\0"
+    "BitsPerSample\0"
+    "FlashpixVersion\0"
+    "FileSource\0"
+    "ColorMatrix1\0"
+    "GPSDestBearingRef\0"
+    "FocalPlaneXResolution\0"
+    "CustomRendered\0"
+    "PixelScale\0"
+    "OldSubfileType\0"
+    "SamplesPerPixel\0"
+    "MinSampleValue\0"
+    "OriginalRawFileDigest\0"
+    "DefaultImageColor\0"
+    "GPSLongitude\0"
+    "IntergraphMatrix\0"
+    "Model\0"
+    "WidthResolution\0"
+    "GeoTiffDoubleParams\0"
+    "KodakIFD\0"
+    "TargetPrinter\0"
+    "ExposureMode\0"
+    "CellWidth\0"
+    "BackgroundColorValue\0"
+    "ImageColorValue\0"
+    "InteropVersion\0"
+    "BlackLevelRepeatDim\0"
+    "SMinSampleValue\0"
+    "SEMInfo\0"
+    "PrintIM\0"
+    "GeoTiffDirectory\0"
+    "BaselineSharpness\0"
+    "ExifImageHeight\0"
+    "TileLength\0"
+    "CurrentPreProfileMatrix\0"
+    "GPSDOP\0"
+    "ExpandFilterLens\0"
+    "DocumentName\0"
+    "SubjectLocation\0"
+    "ExifImageWidth\0"
+    "TransferFunction\0"
+    "Noise\0"
+    "RelatedImageWidth\0"
+    "Transformation\0"
+    "FaxRecvParams\0"
+    "GPSHPositioningError\0"
+    "MDFileUnits\0"
+    "AntiAliasStrength\0"
+    "MDPrepDate\0"
+    "StoNits\0"
+    "RasterPadding\0"
+    "CodingMethods\0"
+    "DefaultCropSize\0"
+    "XPAuthor\0"
+    "JPEGLosslessPredictors\0"
+    "GainControl\0"
+    "SensingMethod\0"
+    "LeafSubIFD\0"
+    "MaskedAreas\0"
+    "YCbCrSubSampling\0"
+    "MSDocumentTextPosition\0"
+    "PixelFormat\0"
+    "GPSSpeedRef\0"
+    "GrayResponseCurve\0"
+    "AlphaDataDiscard\0"
+    "WhitePoint\0"
+    "LinearResponseLimit\0"
+    "MDFileTag\0"
+    "GPSDestDistanceRef\0"
+    "GPSInfo\0"
+    "ProfileEmbedPolicy\0"
+    "FocalLengthIn35mmFormat\0"
+    "ProfileType\0"
+    "ImageDescription\0"
+    "HalftoneHints\0"
+    "CameraCalibration2\0"
+    "SubjectArea\0"
+    "SubSecTimeOriginal\0"
+    "ForwardMatrix1\0"
+    "MakerNoteSafety\0"
+    "BestQualityScale\0"
+    "T6Options\0"
+    "GPSDestDistance\0"
+    "DNGBackwardVersion\0"
+    "ConsecutiveBadFaxLines\0"
+    "PreviewSettingsName\0"
+    "GlobalParametersIFD\0"
+    "PreviewApplicationName\0"
+    "SubjectDistanceRange\0"
+    "DeviceSettingDescription\0"
+    "DotRange\0"
+    "GPSDestLongitude\0"
+    "JPEGPointTransforms\0"
+    "ExpandFilm\0"
+    "ActiveArea\0"
+    "PanasonicTitle2\0"
+    "Site\0"
+    "TileOffsets\0"
+    "PlanarConfiguration\0"
+    "InkSet\0"
+    "ImageColorIndicator\0"
+    "ExifVersion\0"
+    "GPSTimeStamp\0"
+    "Predictor\0"
+    "YPosition\0"
+    "Flash\0"
+    "TransferRange\0"
+    "PhotometricInterpretation\0"
+    "WB_GRGBLevels\0"
+    "GPSLatitudeRef\0"
+    "InteropOffset\0"
+    "ColorTable\0"
+    "SubSecTimeDigitized\0"
+    "AliasLayerMetadata\0"
+    "FaxSubAddress\0"
+    "T4Options\0"
+    "ColorimetricReference\0"
+    "CFAPattern2\0"
+    "ApplicationNotes\0"
+    "YResolution\0"
+    "XPComment\0"
+    "PageNumber\0"
+    "MDScalePixel\0"
+    "CompressedBitsPerPixel\0"
+    "OPIProxy\0"
+    "BadFaxLines\0"
+    "GPSAltitude\0"
+    "ImageDepth\0"
+    "TrapIndicator\0"
+    "RelatedImageHeight\0"
+    "NumberofInks\0"
+    "ExpandFlashLamp\0"
+    "SpectralSensitivity\0"
+    "GPSDestBearing\0"
+    "ImageByteCount\0"
+    "Model2\0"
+    "Sharpness\0"
+    "PixelIntensityRange\0"
+    "SceneCaptureType\0"
+    "CFAPattern\0"
+    "FreeOffsets\0"
+    "ModifyDate\0"
+    "CameraSerialNumber\0"
+    "GPSDifferential\0"
+    "ModelTransform\0"
+    "HCUsage\0"
+    "RowsPerStrip\0"
+    "AnalogBalance\0"
+    "LeafData\0"
+    "BaselineExposure\0"
+    "GDALMetadata\0"
+    "Annotations\0"
+    "UserComment\0"
+    "TileWidth\0"
+    "ColorSequence\0"
+    "LinearizationTable\0"
+    "RelatedSoundFile\0"
+    "PhotoshopSettings\0"
+    "JPEGDCTables\0"
+    "MaxApertureValue\0"
+    "XClipPathUnits\0"
+    "IT8Header\0"
+    "DataType\0"
+    "ImageDataDiscard\0"
+    "CalibrationIlluminant1\0"
+    "OceImageLogic\0"
+    "PreviewColorSpace\0"
+    "HostComputer\0"
+    "YCbCrPositioning\0"
+    "BlackLevelDeltaV\0"
+    "MDSampleInfo\0"
+    "Artist\0"
+    "IntergraphPacketData\0"
+    "OriginalRawFileName\0"
+    "GPSTrackRef\0"
+    "BitsPerExtendedRunLength\0"
+    "ExposureTime\0"
+    "CFARepeatPatternDim\0"
+    "AFCP_IPTC\0"
+    "RawDataUniqueID\0"
+    "LightSource\0"
+    "DNGLensInfo\0"
+    "AsShotProfileName\0"
+    "BlackLevel\0"
+    "XPSubject\0"
+    ;
+
+static const uint16_t TAG_DISP[130] = {
+    1, 11, 10, 4, 1, 22, 20, 2, 6, 27, 7, 5,
+    1, 5, 86, 0, 4, 7, 16, 8, 13, 8, 6, 31,
+    5, 38, 2, 5, 71, 4, 13, 0, 22, 1, 2, 3,
+    12, 16, 6, 3, 62, 1, 28, 35, 198, 13, 12, 63,
+    2, 31, 15, 25, 6, 10, 6, 7, 58, 4, 3, 8,
+    148, 13, 5, 7, 27, 92, 2, 2, 1, 6, 0, 3,
+    1, 2, 126, 7, 8, 182, 14, 2, 1, 2, 21, 71,
+    4, 1, 3, 116, 114, 1, 17, 47, 23, 8, 9, 7,
+    136, 6, 2, 71, 10, 76, 127, 16, 139, 147, 36, 179,
+    9, 41, 26, 3, 0, 103, 74, 153, 76, 182, 56, 1,
+    410, 20, 11, 6, 519, 177, 70, 207, 1, 76,
+};
+
+static const tag_info TAGS[390] = {
+    { 0xC62D, 0, NANOEXIF_IFD_0, 0 },
+    { 0xC6FE, 0, NANOEXIF_IFD_0, 16 },
+    { 0xC715, 0, NANOEXIF_IFD_0, 33 },
+    { 0x882A, 0, NANOEXIF_IFD_EXIF, 48 },
+    { 0x0011, 1, NANOEXIF_IFD_GPS, 63 },
+    { 0x9215, 0, NANOEXIF_IFD_0, 79 },
+    { 0xC726, 0, NANOEXIF_IFD_0, 93 },
+    { 0xC6F4, 0, NANOEXIF_IFD_0, 114 },
+    { 0x0103, 0, NANOEXIF_IFD_0, 136 },
+    { 0x8829, 0, NANOEXIF_IFD_EXIF, 148 },
+    { 0xC761, 0, NANOEXIF_IFD_0, 158 },
+    { 0xC615, 0, NANOEXIF_IFD_0, 171 },
+    { 0xC61B, 0, NANOEXIF_IFD_0, 192 },
+    { 0x0112, 0, NANOEXIF_IFD_0, 209 },
+    { 0x4746, 0, NANOEXIF_IFD_0, 221 },
+    { 0x84E8, 0, NANOEXIF_IFD_0, 228 },
+    { 0xC65B, 0, NANOEXIF_IFD_0, 253 },
+    { 0x0200, 0, NANOEXIF_IFD_0, 276 },
+    { 0xC68F, 0, NANOEXIF_IFD_0, 285 },
+    { 0xC6F3, 0, NANOEXIF_IFD_0, 302 },
+    { 0x9003, 0, NANOEXIF_IFD_EXIF, 323 },
+    { 0x9101, 0, NANOEXIF_IFD_EXIF, 340 },
+    { 0xBCC3, 0, NANOEXIF_IFD_0, 364 },
+    { 0x0010, 1, NANOEXIF_IFD_GPS, 379 },
+    { 0xC6F5, 0, NANOEXIF_IFD_0, 398 },
+    { 0xC6FC, 0, NANOEXIF_IFD_0, 409 },
+    { 0x0101, 0, NANOEXIF_IFD_0, 426 },
+    { 0x0207, 0, NANOEXIF_IFD_0, 438 },
+    { 0x013F, 0, NANOEXIF_IFD_0, 450 },
+    { 0xC6F7, 0, NANOEXIF_IFD_0, 472 },
+    { 0x9202, 0, NANOEXIF_IFD_EXIF, 494 },
+    { 0x0159, 0, NANOEXIF_IFD_0, 508 },
+    { 0xC629, 0, NANOEXIF_IFD_0, 523 },
+    { 0x9201, 0, NANOEXIF_IFD_EXIF, 537 },
+    { 0xC719, 0, NANOEXIF_IFD_0, 555 },
+    { 0x80E3, 0, NANOEXIF_IFD_0, 577 },
+    { 0xC428, 0, NANOEXIF_IFD_0, 586 },
+    { 0x920C, 0, NANOEXIF_IFD_0, 609 },
+    { 0x1000, 0, NANOEXIF_IFD_INTEROP, 634 },
+    { 0xEA1D, 0, NANOEXIF_IFD_0, 657 },
+    { 0x0145, 0, NANOEXIF_IFD_0, 670 },
+    { 0x82A7, 0, NANOEXIF_IFD_0, 685 },
+    { 0x0147, 0, NANOEXIF_IFD_0, 698 },
+    { 0x0001, 0, NANOEXIF_IFD_INTEROP, 711 },
+    { 0x022F, 0, NANOEXIF_IFD_0, 724 },
+    { 0x0203, 0, NANOEXIF_IFD_0, 739 },
+    { 0xC427, 0, NANOEXIF_IFD_0, 759 },
+    { 0xC740, 0, NANOEXIF_IFD_0, 774 },
+    { 0x84ED, 0, NANOEXIF_IFD_0, 786 },
+    { 0x001C, 1, NANOEXIF_IFD_GPS, 808 },
+    { 0x011A, 0, NANOEXIF_IFD_0, 827 },
+    { 0xA215, 0, NANOEXIF_IFD_EXIF, 79 },
+    { 0x0002, 1, NANOEXIF_IFD_GPS, 839 },
+    { 0x8482, 0, NANOEXIF_IFD_0, 851 },
+    { 0xC6F8, 0, NANOEXIF_IFD_0, 865 },
+    { 0x9207, 0, NANOEXIF_IFD_EXIF, 877 },
+    { 0x87B1, 0, NANOEXIF_IFD_0, 890 },
+    { 0x828F, 0, NANOEXIF_IFD_0, 909 },
+    { 0xC625, 0, NANOEXIF_IFD_0, 922 },
+    { 0x000B, 0, NANOEXIF_IFD_0, 939 },
+    { 0x885E, 0, NANOEXIF_IFD_0, 958 },
+    { 0x014D, 0, NANOEXIF_IFD_0, 970 },
+    { 0xC617, 0, NANOEXIF_IFD_0, 979 },
+    { 0x82A8, 0, NANOEXIF_IFD_0, 989 },
+    { 0xC626, 0, NANOEXIF_IFD_0, 999 },
+    { 0xC741, 0, NANOEXIF_IFD_0, 1016 },
+    { 0x9203, 0, NANOEXIF_IFD_EXIF, 1028 },
+    { 0x4749, 0, NANOEXIF_IFD_0, 1044 },
+    { 0xA404, 0, NANOEXIF_IFD_EXIF, 1058 },
+    { 0x000F, 1, NANOEXIF_IFD_GPS, 1075 },
+    { 0x01B5, 0, NANOEXIF_IFD_0, 1084 },
+    { 0x0015, 1, NANOEXIF_IFD_GPS, 1095 },
+    { 0xC628, 0, NANOEXIF_IFD_0, 1115 },
+    { 0x9330, 0, NANOEXIF_IFD_EXIF, 1129 },
+    { 0x0195, 0, NANOEXIF_IFD_0, 1150 },
+    { 0x829D, 0, NANOEXIF_IFD_EXIF, 1161 },
+    { 0xA001, 0, NANOEXIF_IFD_EXIF, 1169 },
+    { 0x0009, 1, NANOEXIF_IFD_GPS, 1180 },
+    { 0x800D, 0, NANOEXIF_IFD_0, 1190 },
+    { 0xAFC1, 0, NANOEXIF_IFD_EXIF, 1198 },
+    { 0x8769, 0, NANOEXIF_IFD_0, 1209 },
+    { 0xA301, 0, NANOEXIF_IFD_EXIF, 1220 },
+    { 0x0131, 0, NANOEXIF_IFD_0, 1230 },
+    { 0xBCC2, 0, NANOEXIF_IFD_0, 1239 },
+    { 0x9204, 0, NANOEXIF_IFD_EXIF, 1251 },
+    { 0x0107, 0, NANOEXIF_IFD_0, 1272 },
+    { 0x0003, 1, NANOEXIF_IFD_GPS, 1285 },
+    { 0x0211, 0, NANOEXIF_IFD_0, 1301 },
+    { 0x9C9B, 0, NANOEXIF_IFD_0, 1319 },
+    { 0x0121, 0, NANOEXIF_IFD_0, 1327 },
+    { 0x0155, 0, NANOEXIF_IFD_0, 1342 },
+    { 0xA420, 0, NANOEXIF_IFD_EXIF, 1358 },
+    { 0x87AC, 0, NANOEXIF_IFD_0, 1372 },
+    { 0xC61F, 0, NANOEXIF_IFD_0, 1383 },
+    { 0x010A, 0, NANOEXIF_IFD_0, 1401 },
+    { 0x8298, 0, NANOEXIF_IFD_0, 1411 },
+    { 0xC6F9, 0, NANOEXIF_IFD_0, 1421 },
+    { 0xC71E, 0, NANOEXIF_IFD_0, 1442 },
+    { 0x0122, 0, NANOEXIF_IFD_0, 1459 },
+    { 0x9210, 0, NANOEXIF_IFD_0, 1476 },
+    { 0x847F, 0, NANOEXIF_IFD_0, 1501 },
+    { 0x0013, 1, NANOEXIF_IFD_GPS, 1525 },
+    { 0x0128, 0, NANOEXIF_IFD_0, 1544 },
+    { 0xBCC0, 0, NANOEXIF_IFD_0, 1559 },
+    { 0x9290, 0, NANOEXIF_IFD_EXIF, 1571 },
+    { 0xC74E, 0, NANOEXIF_IFD_0, 1582 },
+    { 0x8828, 0, NANOEXIF_IFD_EXIF, 1594 },
+    { 0x920B, 0, NANOEXIF_IFD_0, 1618 },
+    { 0xC68C, 0, NANOEXIF_IFD_0, 1630 },
+    { 0xC71F, 0, NANOEXIF_IFD_0, 1650 },
+    { 0xC6FA, 0, NANOEXIF_IFD_0, 1670 },
+    { 0x84EC, 0, NANOEXIF_IFD_0, 1692 },
+    { 0x9004, 0, NANOEXIF_IFD_EXIF, 1714 },
+    { 0xBC80, 0, NANOEXIF_IFD_0, 1725 },
+    { 0xA481, 0, NANOEXIF_IFD_0, 1736 },
+    { 0x000A, 1, NANOEXIF_IFD_GPS, 1747 },
+    { 0xAFC4, 0, NANOEXIF_IFD_EXIF, 1762 },
+    { 0x920A, 0, NANOEXIF_IFD_EXIF, 1776 },
+    { 0xFE00, 0, NANOEXIF_IFD_0, 1788 },
+    { 0xC62B, 0, NANOEXIF_IFD_0, 1796 },
+    { 0x0153, 0, NANOEXIF_IFD_0, 1810 },
+    { 0x9206, 0, NANOEXIF_IFD_EXIF, 1823 },
+    { 0x0109, 0, NANOEXIF_IFD_0, 1839 },
+    { 0xC631, 0, NANOEXIF_IFD_0, 1850 },
+    { 0x0014, 1, NANOEXIF_IFD_GPS, 1867 },
+    { 0xA403, 0, NANOEXIF_IFD_EXIF, 1883 },
+    { 0xA500, 0, NANOEXIF_IFD_EXIF, 1896 },
+    { 0xC717, 0, NANOEXIF_IFD_0, 1902 },
+    { 0xEA1C, 0, NANOEXIF_IFD_0, 1928 },
+    { 0x8773, 0, NANOEXIF_IFD_0, 1936 },
+    { 0x0152, 0, NANOEXIF_IFD_0, 1948 },
+    { 0xA408, 0, NANOEXIF_IFD_EXIF, 1961 },
+    { 0x9C9E, 0, NANOEXIF_IFD_0, 1970 },
+    { 0x000D, 1, NANOEXIF_IFD_GPS, 1981 },
+    { 0x0012, 1, NANOEXIF_IFD_GPS, 1990 },
+    { 0x84E4, 0, NANOEXIF_IFD_0, 2002 },
+    { 0x84F0, 0, NANOEXIF_IFD_0, 2019 },
+    { 0x9213, 0, NANOEXIF_IFD_0, 2034 },
+    { 0x0214, 0, NANOEXIF_IFD_0, 2047 },
+    { 0xBC04, 0, NANOEXIF_IFD_0, 2067 },
+    { 0xC691, 0, NANOEXIF_IFD_0, 2077 },
+    { 0xC640, 0, NANOEXIF_IFD_0, 2095 },
+    { 0x0192, 0, NANOEXIF_IFD_0, 2116 },
+    { 0x882B, 0, NANOEXIF_IFD_EXIF, 2127 },
+    { 0xC61E, 0, NANOEXIF_IFD_0, 2141 },
+    { 0x0005, 1, NANOEXIF_IFD_GPS, 2154 },
+    { 0x80E6, 0, NANOEXIF_IFD_0, 2169 },
+    { 0xA212, 0, NANOEXIF_IFD_EXIF, 2179 },
+    { 0xA409, 0, NANOEXIF_IFD_EXIF, 2202 },
+    { 0x82AB, 0, NANOEXIF_IFD_0, 2213 },
+    { 0xC612, 0, NANOEXIF_IFD_0, 2224 },
+    { 0x012C, 0, NANOEXIF_IFD_0, 2235 },
+    { 0xBC81, 0, NANOEXIF_IFD_0, 426 },
+    { 0x011E, 0, NANOEXIF_IFD_0, 2253 },
+    { 0x0209, 0, NANOEXIF_IFD_0, 2263 },
+    { 0xAFC0, 0, NANOEXIF_IFD_EXIF, 2276 },
+    { 0xC61D, 0, NANOEXIF_IFD_0, 2291 },
+    { 0xBC83, 0, NANOEXIF_IFD_0, 2302 },
+    { 0x011D, 0, NANOEXIF_IFD_0, 2319 },
+    { 0x9211, 0, NANOEXIF_IFD_0, 2328 },
+    { 0x920F, 0, NANOEXIF_IFD_0, 2340 },
+    { 0x80A4, 0, NANOEXIF_IFD_0, 2362 },
+    { 0xC71C, 0, NANOEXIF_IFD_0, 2377 },
+    { 0xC623, 0, NANOEXIF_IFD_0, 2392 },
+    { 0x0008, 1, NANOEXIF_IFD_GPS, 2411 },
+    { 0xC725, 0, NANOEXIF_IFD_0, 2425 },
+    { 0x015A, 0, NANOEXIF_IFD_0, 2446 },
+    { 0x001D, 1, NANOEXIF_IFD_GPS, 2454 },
+    { 0x01B1, 0, NANOEXIF_IFD_0, 2467 },
+    { 0xC71B, 0, NANOEXIF_IFD_0, 2474 },
+    { 0x8822, 0, NANOEXIF_IFD_EXIF, 2490 },
+    { 0xC633, 0, NANOEXIF_IFD_0, 2506 },
+    { 0x0000, 1, NANOEXIF_IFD_GPS, 2518 },
+    { 0xC622, 0, NANOEXIF_IFD_0, 2531 },
+    { 0xC6D2, 0, NANOEXIF_IFD_0, 2544 },
+    { 0x8827, 0, NANOEXIF_IFD_EXIF, 2559 },
+    { 0xC690, 0, NANOEXIF_IFD_0, 2563 },
+    { 0x0157, 0, NANOEXIF_IFD_0, 2586 },
+    { 0x001B, 1, NANOEXIF_IFD_GPS, 2595 },
+    { 0xC616, 0, NANOEXIF_IFD_0, 2615 },
+    { 0x932F, 0, NANOEXIF_IFD_EXIF, 2629 },
+    { 0x935C, 0, NANOEXIF_IFD_EXIF, 2644 },
+    { 0xC614, 0, NANOEXIF_IFD_0, 2660 },
+    { 0x0119, 0, NANOEXIF_IFD_0, 2678 },
+    { 0xC429, 0, NANOEXIF_IFD_0, 2693 },
+    { 0xA20F, 0, NANOEXIF_IFD_EXIF, 2340 },
+    { 0x83BB, 0, NANOEXIF_IFD_0, 2705 },
+    { 0x0194, 0, NANOEXIF_IFD_0, 2714 },
+    { 0xBC03, 0, NANOEXIF_IFD_0, 2726 },
+    { 0xC6FB, 0, NANOEXIF_IFD_0, 2739 },
+    { 0x010F, 0, NANOEXIF_IFD_0, 2761 },
+    { 0x0140, 0, NANOEXIF_IFD_0, 2766 },
+    { 0xA216, 0, NANOEXIF_IFD_EXIF, 2775 },
+    { 0x00FE, 0, NANOEXIF_IFD_0, 2793 },
+    { 0x0102, 0, NANOEXIF_IFD_0, 2805 },
+    { 0xA000, 0, NANOEXIF_IFD_EXIF, 2819 },
+    { 0xA300, 0, NANOEXIF_IFD_EXIF, 2835 },
+    { 0xC621, 0, NANOEXIF_IFD_0, 2846 },
+    { 0x0017, 1, NANOEXIF_IFD_GPS, 2859 },
+    { 0x920E, 0, NANOEXIF_IFD_0, 2877 },
+    { 0xA401, 0, NANOEXIF_IFD_EXIF, 2899 },
+    { 0x830E, 0, NANOEXIF_IFD_0, 2914 },
+    { 0x00FF, 0, NANOEXIF_IFD_0, 2925 },
+    { 0x0115, 0, NANOEXIF_IFD_0, 2940 },
+    { 0xA210, 0, NANOEXIF_IFD_EXIF, 1476 },
+    { 0x0118, 0, NANOEXIF_IFD_0, 2956 },
+    { 0xC71D, 0, NANOEXIF_IFD_0, 2971 },
+    { 0x01B2, 0, NANOEXIF_IFD_0, 2993 },
+    { 0x0004, 1, NANOEXIF_IFD_GPS, 3011 },
+    { 0x8480, 0, NANOEXIF_IFD_0, 3024 },
+    { 0xA213, 0, NANOEXIF_IFD_EXIF, 2034 },
+    { 0x0110, 0, NANOEXIF_IFD_0, 3041 },
+    { 0xBC82, 0, NANOEXIF_IFD_0, 3047 },
+    { 0x87B0, 0, NANOEXIF_IFD_0, 3063 },
+    { 0x8290, 0, NANOEXIF_IFD_0, 3083 },
+    { 0x0151, 0, NANOEXIF_IFD_0, 3092 },
+    { 0xA402, 0, NANOEXIF_IFD_EXIF, 3106 },
+    { 0x0108, 0, NANOEXIF_IFD_0, 3119 },
+    { 0x84EA, 0, NANOEXIF_IFD_0, 3129 },
+    { 0x9212, 0, NANOEXIF_IFD_0, 2179 },
+    { 0x84E9, 0, NANOEXIF_IFD_0, 3150 },
+    { 0x0002, 0, NANOEXIF_IFD_INTEROP, 3166 },
+    { 0xC619, 0, NANOEXIF_IFD_0, 3181 },
+    { 0x0154, 0, NANOEXIF_IFD_0, 3201 },
+    { 0x8546, 0, NANOEXIF_IFD_0, 3217 },
+    { 0xC4A5, 0, NANOEXIF_IFD_0, 3225 },
+    { 0x87AF, 0, NANOEXIF_IFD_0, 3233 },
+    { 0x9216, 0, NANOEXIF_IFD_0, 2775 },
+    { 0xC62C, 0, NANOEXIF_IFD_0, 3250 },
+    { 0xA003, 0, NANOEXIF_IFD_EXIF, 3268 },
+    { 0x0143, 0, NANOEXIF_IFD_0, 3284 },
+    { 0xC692, 0, NANOEXIF_IFD_0, 3295 },
+    { 0x000B, 1, NANOEXIF_IFD_GPS, 3319 },
+    { 0xAFC3, 0, NANOEXIF_IFD_EXIF, 3326 },
+    { 0x010D, 0, NANOEXIF_IFD_0, 3343 },
+    { 0xA214, 0, NANOEXIF_IFD_EXIF, 3356 },
+    { 0xA002, 0, NANOEXIF_IFD_EXIF, 3372 },
+    { 0x012D, 0, NANOEXIF_IFD_0, 3387 },
+    { 0xA20D, 0, NANOEXIF_IFD_EXIF, 3404 },
+    { 0x1001, 0, NANOEXIF_IFD_INTEROP, 3410 },
+    { 0xBC02, 0, NANOEXIF_IFD_0, 3428 },
+    { 0xA20C, 0, NANOEXIF_IFD_EXIF, 609 },
+    { 0x885C, 0, NANOEXIF_IFD_0, 3443 },
+    { 0x001F, 1, NANOEXIF_IFD_GPS, 3457 },
+    { 0x82AC, 0, NANOEXIF_IFD_0, 3478 },
+    { 0xC632, 0, NANOEXIF_IFD_0, 3490 },
+    { 0x82AA, 0, NANOEXIF_IFD_0, 3508 },
+    { 0x923F, 0, NANOEXIF_IFD_EXIF, 3519 },
+    { 0x84E3, 0, NANOEXIF_IFD_0, 3527 },
+    { 0x0193, 0, NANOEXIF_IFD_0, 3541 },
+    { 0xC620, 0, NANOEXIF_IFD_0, 3555 },
+    { 0x9C9D, 0, NANOEXIF_IFD_0, 3571 },
+    { 0x0205, 0, NANOEXIF_IFD_0, 3580 },
+    { 0xA407, 0, NANOEXIF_IFD_EXIF, 3603 },
+    { 0x9217, 0, NANOEXIF_IFD_0, 3615 },
+    { 0x888A, 0, NANOEXIF_IFD_0, 3629 },
+    { 0xC68E, 0, NANOEXIF_IFD_0, 3640 },
+    { 0x0212, 0, NANOEXIF_IFD_0, 3652 },
+    { 0x9331, 0, NANOEXIF_IFD_EXIF, 3669 },
+    { 0xBC01, 0, NANOEXIF_IFD_0, 3692 },
+    { 0x000C, 1, NANOEXIF_IFD_GPS, 3704 },
+    { 0x0123, 0, NANOEXIF_IFD_0, 3716 },
+    { 0xBCC5, 0, NANOEXIF_IFD_0, 3734 },
+    { 0x013E, 0, NANOEXIF_IFD_0, 3751 },
+    { 0xC62E, 0, NANOEXIF_IFD_0, 3762 },
+    { 0x82A5, 0, NANOEXIF_IFD_0, 3782 },
+    { 0x0019, 1, NANOEXIF_IFD_GPS, 3792 },
+    { 0x8825, 0, NANOEXIF_IFD_EXIF, 3811 },
+    { 0xC6FD, 0, NANOEXIF_IFD_0, 3819 },
+    { 0xA405, 0, NANOEXIF_IFD_EXIF, 3838 },
+    { 0x0191, 0, NANOEXIF_IFD_0, 3862 },
+    { 0x010E, 0, NANOEXIF_IFD_0, 3874 },
+    { 0x0141, 0, NANOEXIF_IFD_0, 3891 },
+    { 0xC624, 0, NANOEXIF_IFD_0, 3905 },
+    { 0x9214, 0, NANOEXIF_IFD_EXIF, 3924 },
+    { 0x9291, 0, NANOEXIF_IFD_EXIF, 3936 },
+    { 0xC714, 0, NANOEXIF_IFD_0, 3955 },
+    { 0xC635, 0, NANOEXIF_IFD_0, 3970 },
+    { 0xC65C, 0, NANOEXIF_IFD_0, 3986 },
+    { 0x0125, 0, NANOEXIF_IFD_0, 4003 },
+    { 0x001A, 1, NANOEXIF_IFD_GPS, 4013 },
+    { 0xC613, 0, NANOEXIF_IFD_0, 4029 },
+    { 0x0148, 0, NANOEXIF_IFD_0, 4048 },
+    { 0xC718, 0, NANOEXIF_IFD_0, 4071 },
+    { 0x0190, 0, NANOEXIF_IFD_0, 4091 },
+    { 0xA211, 0, NANOEXIF_IFD_EXIF, 2328 },
+    { 0xC716, 0, NANOEXIF_IFD_0, 4111 },
+    { 0xA40C, 0, NANOEXIF_IFD_EXIF, 4134 },
+    { 0xA40B, 0, NANOEXIF_IFD_EXIF, 4155 },
+    { 0x0150, 0, NANOEXIF_IFD_0, 4180 },
+    { 0x0016, 1, NANOEXIF_IFD_GPS, 4189 },
+    { 0x0206, 0, NANOEXIF_IFD_0, 4206 },
+    { 0xAFC2, 0, NANOEXIF_IFD_EXIF, 4226 },
+    { 0xC68D, 0, NANOEXIF_IFD_0, 4237 },
+    { 0x0100, 0, NANOEXIF_IFD_0, 1725 },
+    { 0x920D, 0, NANOEXIF_IFD_0, 3404 },
+    { 0xC6D3, 0, NANOEXIF_IFD_0, 4248 },
+    { 0x84E0, 0, NANOEXIF_IFD_0, 4264 },
+    { 0x0144, 0, NANOEXIF_IFD_0, 4269 },
+    { 0x011C, 0, NANOEXIF_IFD_0, 4281 },
+    { 0x014C, 0, NANOEXIF_IFD_0, 4301 },
+    { 0x84E7, 0, NANOEXIF_IFD_0, 4308 },
+    { 0x9000, 0, NANOEXIF_IFD_EXIF, 4328 },
+    { 0x0007, 1, NANOEXIF_IFD_GPS, 4340 },
+    { 0x013D, 0, NANOEXIF_IFD_0, 4353 },
+    { 0x011F, 0, NANOEXIF_IFD_0, 4363 },
+    { 0x9209, 0, NANOEXIF_IFD_EXIF, 4373 },
+    { 0x0156, 0, NANOEXIF_IFD_0, 4379 },
+    { 0x0106, 0, NANOEXIF_IFD_0, 4393 },
+    { 0xA20E, 0, NANOEXIF_IFD_EXIF, 2877 },
+    { 0x8602, 0, NANOEXIF_IFD_0, 4419 },
+    { 0xA217, 0, NANOEXIF_IFD_EXIF, 3615 },
+    { 0x0001, 1, NANOEXIF_IFD_GPS, 4433 },
+    { 0xA005, 0, NANOEXIF_IFD_EXIF, 4448 },
+    { 0x84E6, 0, NANOEXIF_IFD_0, 4462 },
+    { 0x9292, 0, NANOEXIF_IFD_EXIF, 4473 },
+    { 0xC660, 0, NANOEXIF_IFD_0, 4493 },
+    { 0x885D, 0, NANOEXIF_IFD_0, 4512 },
+    { 0x0124, 0, NANOEXIF_IFD_0, 4526 },
+    { 0xC6BF, 0, NANOEXIF_IFD_0, 4536 },
+    { 0x828E, 0, NANOEXIF_IFD_0, 4558 },
+    { 0x02BC, 0, NANOEXIF_IFD_0, 4570 },
+    { 0x011B, 0, NANOEXIF_IFD_0, 4587 },
+    { 0x9C9C, 0, NANOEXIF_IFD_0, 4599 },
+    { 0x0129, 0, NANOEXIF_IFD_0, 4609 },
+    { 0x82A6, 0, NANOEXIF_IFD_0, 4620 },
+    { 0x9102, 0, NANOEXIF_IFD_EXIF, 4633 },
+    { 0x015F, 0, NANOEXIF_IFD_0, 4656 },
+    { 0x0146, 0, NANOEXIF_IFD_0, 4665 },
+    { 0x0006, 1, NANOEXIF_IFD_GPS, 4677 },
+    { 0x80E5, 0, NANOEXIF_IFD_0, 4689 },
+    { 0x84EF, 0, NANOEXIF_IFD_0, 4700 },
+    { 0x1002, 0, NANOEXIF_IFD_INTEROP, 4714 },
+    { 0x014E, 0, NANOEXIF_IFD_0, 4733 },
+    { 0xAFC5, 0, NANOEXIF_IFD_EXIF, 4746 },
+    { 0x8824, 0, NANOEXIF_IFD_EXIF, 4762 },
+    { 0x0018, 1, NANOEXIF_IFD_GPS, 4782 },
+    { 0xBCC1, 0, NANOEXIF_IFD_0, 4797 },
+    { 0x827D, 0, NANOEXIF_IFD_0, 4812 },
+    { 0xA40A, 0, NANOEXIF_IFD_EXIF, 4819 },
+    { 0x84EB, 0, NANOEXIF_IFD_0, 4829 },
+    { 0xA406, 0, NANOEXIF_IFD_EXIF, 4849 },
+    { 0xA302, 0, NANOEXIF_IFD_EXIF, 4866 },
+    { 0x0120, 0, NANOEXIF_IFD_0, 4877 },
+    { 0x0132, 0, NANOEXIF_IFD_0, 4889 },
+    { 0xC62F, 0, NANOEXIF_IFD_0, 4900 },
+    { 0x001E, 1, NANOEXIF_IFD_GPS, 4919 },
+    { 0x85D8, 0, NANOEXIF_IFD_0, 4935 },
+    { 0x84EE, 0, NANOEXIF_IFD_0, 4950 },
+    { 0x0116, 0, NANOEXIF_IFD_0, 4958 },
+    { 0xC627, 0, NANOEXIF_IFD_0, 4971 },
+    { 0x8606, 0, NANOEXIF_IFD_0, 4985 },
+    { 0xC62A, 0, NANOEXIF_IFD_0, 4994 },
+    { 0xA480, 0, NANOEXIF_IFD_0, 5011 },
+    { 0xC44F, 0, NANOEXIF_IFD_0, 5024 },
+    { 0x9286, 0, NANOEXIF_IFD_EXIF, 5036 },
+    { 0x0142, 0, NANOEXIF_IFD_0, 5048 },
+    { 0x84E1, 0, NANOEXIF_IFD_0, 5058 },
+    { 0xC618, 0, NANOEXIF_IFD_0, 5072 },
+    { 0xA004, 0, NANOEXIF_IFD_EXIF, 5091 },
+    { 0x8649, 0, NANOEXIF_IFD_0, 5108 },
+    { 0x0208, 0, NANOEXIF_IFD_0, 5126 },
+    { 0x9205, 0, NANOEXIF_IFD_EXIF, 5139 },
+    { 0x0158, 0, NANOEXIF_IFD_0, 5156 },
+    { 0x84E2, 0, NANOEXIF_IFD_0, 5171 },
+    { 0x80E4, 0, NANOEXIF_IFD_0, 5181 },
+    { 0xBCC4, 0, NANOEXIF_IFD_0, 5190 },
+    { 0xC65A, 0, NANOEXIF_IFD_0, 5207 },
+    { 0xC42A, 0, NANOEXIF_IFD_0, 5230 },
+    { 0xC71A, 0, NANOEXIF_IFD_0, 5244 },
+    { 0x013C, 0, NANOEXIF_IFD_0, 5262 },
+    { 0x0213, 0, NANOEXIF_IFD_0, 5275 },
+    { 0xC61C, 0, NANOEXIF_IFD_0, 5292 },
+    { 0x82A9, 0, NANOEXIF_IFD_0, 5309 },
+    { 0xA20B, 0, NANOEXIF_IFD_EXIF, 1618 },
+    { 0x013B, 0, NANOEXIF_IFD_0, 5322 },
+    { 0x847E, 0, NANOEXIF_IFD_0, 5329 },
+    { 0xC68B, 0, NANOEXIF_IFD_0, 5350 },
+    { 0x000E, 1, NANOEXIF_IFD_GPS, 5370 },
+    { 0x84E5, 0, NANOEXIF_IFD_0, 5382 },
+    { 0x829A, 0, NANOEXIF_IFD_EXIF, 5407 },
+    { 0x828D, 0, NANOEXIF_IFD_0, 5420 },
+    { 0x8568, 0, NANOEXIF_IFD_0, 5440 },
+    { 0xC65D, 0, NANOEXIF_IFD_0, 5450 },
+    { 0x9208, 0, NANOEXIF_IFD_EXIF, 5466 },
+    { 0x015B, 0, NANOEXIF_IFD_0, 1084 },
+    { 0xC630, 0, NANOEXIF_IFD_0, 5478 },
+    { 0xC6F6, 0, NANOEXIF_IFD_0, 5490 },
+    { 0xC61A, 0, NANOEXIF_IFD_0, 5508 },
+    { 0x9C9F, 0, NANOEXIF_IFD_0, 5519 },
+};
+
+static const uint16_t NAME_DISP[125] = {
+    3, 4, 44, 22, 8, 72, 1, 1, 25, 3, 2, 5,
+    142, 1, 59, 29, 41, 2, 2, 5, 16, 50, 3, 28,
+    5, 4, 9, 70, 1, 40, 6, 37, 1, 3, 37, 3,
+    23, 10, 7, 0, 7, 1, 5, 2, 24, 4, 36, 3,
+    9, 8, 5, 277, 0, 3, 6, 10, 8, 19, 12, 5,
+    43, 37, 1, 7, 0, 49, 14, 3, 29, 177, 5, 9,
+    1, 6, 54, 16, 42, 2, 0, 64, 2, 2, 263, 35,
+    19, 87, 35, 49, 115, 43, 15, 9, 130, 0, 60, 34,
+    65, 91, 10, 18, 186, 1, 0, 36, 2, 93, 3, 5,
+    5, 69, 27, 47, 12, 145, 13, 2, 169, 192, 1, 8,
+    95, 51, 215, 107, 7,
+};
+
+static const uint16_t NAME_SLOT[375] = {
+    251, 90, 247, 333, 226, 58, 214, 231, 135, 195, 310, 357,
+    232, 371, 263, 128, 329, 293, 298, 326, 246, 319, 15, 64,
+    20, 190, 25, 138, 156, 59, 32, 180, 49, 146, 101, 337,
+    301, 383, 176, 266, 386, 150, 191, 42, 271, 269, 132, 276,
+    387, 388, 147, 327, 312, 336, 19, 192, 368, 208, 88, 74,
+    245, 315, 262, 374, 242, 364, 384, 78, 377, 267, 278, 272,
+    360, 162, 275, 332, 228, 79, 2, 324, 230, 149, 221, 330,
+    7, 108, 361, 34, 356, 3, 127, 353, 122, 80, 130, 143,
+    299, 36, 240, 185, 270, 33, 347, 372, 151, 61, 71, 359,
+    103, 41, 8, 56, 250, 81, 244, 212, 50, 268, 340, 218,
+    297, 53, 292, 38, 265, 189, 202, 177, 288, 63, 378, 317,
+    119, 123, 29, 222, 322, 284, 355, 89, 144, 354, 175, 161,
+    373, 68, 220, 334, 16, 238, 98, 104, 235, 60, 139, 145,
+    376, 4, 203, 166, 363, 141, 256, 77, 303, 86, 224, 82,
+    22, 305, 313, 115, 92, 346, 351, 335, 136, 281, 308, 306,
+    249, 206, 153, 316, 237, 211, 94, 261, 114, 47, 54, 331,
+    121, 129, 95, 26, 344, 380, 45, 296, 194, 17, 109, 117,
+    233, 341, 204, 110, 72, 125, 379, 9, 39, 259, 196, 163,
+    304, 170, 381, 91, 280, 75, 13, 365, 352, 169, 260, 248,
+    133, 164, 294, 106, 126, 1, 179, 157, 348, 67, 345, 217,
+    111, 300, 69, 241, 229, 120, 0, 83, 225, 385, 350, 134,
+    44, 11, 252, 188, 243, 30, 257, 182, 24, 165, 197, 40,
+    255, 201, 27, 178, 382, 277, 213, 362, 118, 52, 223, 18,
+    309, 174, 100, 239, 131, 307, 318, 389, 291, 290, 6, 369,
+    173, 279, 102, 124, 367, 23, 10, 172, 253, 181, 184, 338,
+    116, 287, 142, 84, 73, 205, 207, 187, 375, 193, 273, 358,
+    105, 65, 289, 343, 148, 35, 370, 314, 234, 186, 48, 87,
+    285, 62, 366, 93, 236, 14, 325, 57, 154, 55, 215, 282,
+    200, 274, 321, 216, 286, 342, 46, 31, 323, 28, 12, 43,
+    339, 96, 264, 167, 21, 302, 97, 66, 283, 349, 183, 198,
+    328, 258, 51, 140, 155, 171, 320, 85, 210, 311, 168, 76,
+    209, 158, 112,
+};
+
+static inline uint32_t hash_key(uint32_t key, uint32_t seed) {
+    uint32_t h = key ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline uint32_t hash_name(const char *s, uint32_t seed) {
+    uint32_t h = 0x811C9DC5u ^ (seed * 0x9E3779B9u);
+    for (; *s; s++) {
+        h ^= (uint8_t)*s;
+        h *= 0x01000193u;
     }
-    return NULL;
+    return h;
+}
+
+#define NTAGS  (sizeof(TAGS)/sizeof(TAGS[0]))
+#define NNAMES (sizeof(NAME_SLOT)/sizeof(NAME_SLOT[0]))
+
+static const tag_info * find_tag(uint8_t ns, uint16_t tag) {
+    uint32_t key = ((uint32_t)ns << 16) | tag;
+    uint16_t d = TAG_DISP[hash_key(key, 0) % (sizeof(TAG_DISP)/sizeof(TAG_DISP[0]))];
+    const tag_info * t = &TAGS[hash_key(key, d) % NTAGS];
+    return t->tag == tag && t->ns == ns ? t : NULL;
+}
+
+/** name of the tag in IFD0, IFD1, Exif or Interop ifd.
+ * @param uint32_t n: tag number
+ * @return the name, or NULL for unknown tags.
+ */
+const char *nanoexif_tag_name(uint32_t n) {
+    if (n > 0xFFFF) { return NULL; }
+    const tag_info * t = find_tag(0, n);
+    return t ? NAMES + t->name : NULL;
+}
+
+/** name of the tag in the ifd. GPS tags have their own numbers.
+ * @param nanoexif_ifd_kind kind: the ifd which has the tag
+ * @param uint16_t tag: tag number
+ * @return the name, or NULL for unknown tags.
+ */
+const char *nanoexif_ifd_tag_name(nanoexif_ifd_kind kind, uint16_t tag) {
+    const tag_info * t = find_tag(kind == NANOEXIF_IFD_GPS ? 1 : 0, tag);
+    return t ? NAMES + t->name : NULL;
+}
+
+/** look up the tag by name.
+ * @param const char * name: the name, as returned by nanoexif_ifd_tag_name()
+ * @param nanoexif_tag_key * key: the tag and the ifd it is defined in will be set.
+ * @return true if the name is known.
+ */
+bool nanoexif_tag_by_name(const char *name, nanoexif_tag_key *key) {
+    uint16_t d = NAME_DISP[hash_name(name, 0) % (sizeof(NAME_DISP)/sizeof(NAME_DISP[0]))];
+    const tag_info * t = &TAGS[NAME_SLOT[hash_name(name, d) % NNAMES]];
+    if (strcmp(NAMES + t->name, name) != 0) { return false; }
+    key->ifd = t->ifd;
+    key->tag = t->tag;
+    return true;
 }
@@ -0,0 +1,164 @@
+/* generated by tools/tag-name.pl. do not edit. */
+#ifndef NANOEXIF_TAGS_HPP__
+#define NANOEXIF_TAGS_HPP__
+
+/**
+ * @file nanoexif-tags.hpp
+ *
+ * The common tags with the type and count of their value, for nanoexifpp::get<>().
+ * Names are ExifTool's; a name used by two tags is the one nanoexif_tag_by_name() returns.
+ */
+
+#include <nanoexif.hpp>
+
+namespace nanoexifpp {
+namespace tags {
+
+/* IFD0, IFD1, Exif and Interop */
+using InteropIndex = Tag<0x0001, NANOEXIF_IFD_INTEROP, NANOEXIF_TYPE_ASCII, 0>;
+using InteropVersion = Tag<0x0002, NANOEXIF_IFD_INTEROP, NANOEXIF_TYPE_UNDEFINED, 4>;
+using SubfileType = Tag<0x00FE, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using ImageWidth = Tag<0x0100, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using ImageHeight = Tag<0x0101, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using BitsPerSample = Tag<0x0102, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 0>;
+using Compression = Tag<0x0103, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using PhotometricInterpretation = Tag<0x0106, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using ImageDescription = Tag<0x010E, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using Make = Tag<0x010F, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using Model = Tag<0x0110, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using Orientation = Tag<0x0112, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using SamplesPerPixel = Tag<0x0115, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using RowsPerStrip = Tag<0x0116, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using XResolution = Tag<0x011A, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 1>;
+using YResolution = Tag<0x011B, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 1>;
+using PlanarConfiguration = Tag<0x011C, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using ResolutionUnit = Tag<0x0128, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using TransferFunction = Tag<0x012D, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 768>;
+using Software = Tag<0x0131, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using ModifyDate = Tag<0x0132, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using Artist = Tag<0x013B, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using HostComputer = Tag<0x013C, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using Predictor = Tag<0x013D, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using WhitePoint = Tag<0x013E, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 2>;
+using PrimaryChromaticities = Tag<0x013F, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 6>;
+using TileWidth = Tag<0x0142, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using TileLength = Tag<0x0143, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using YCbCrCoefficients = Tag<0x0211, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 3>;
+using YCbCrSubSampling = Tag<0x0212, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 2>;
+using YCbCrPositioning = Tag<0x0213, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using ReferenceBlackWhite = Tag<0x0214, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 6>;
+using RelatedImageFileFormat = Tag<0x1000, NANOEXIF_IFD_INTEROP, NANOEXIF_TYPE_ASCII, 0>;
+using RelatedImageWidth = Tag<0x1001, NANOEXIF_IFD_INTEROP, NANOEXIF_TYPE_SHORT, 1>;
+using RelatedImageHeight = Tag<0x1002, NANOEXIF_IFD_INTEROP, NANOEXIF_TYPE_SHORT, 1>;
+using Rating = Tag<0x4746, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using RatingPercent = Tag<0x4749, NANOEXIF_IFD_0, NANOEXIF_TYPE_SHORT, 1>;
+using Copyright = Tag<0x8298, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using ExposureTime = Tag<0x829A, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using FNumber = Tag<0x829D, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using ExifOffset = Tag<0x8769, NANOEXIF_IFD_0, NANOEXIF_TYPE_LONG, 1>;
+using ExposureProgram = Tag<0x8822, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using SpectralSensitivity = Tag<0x8824, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using GPSInfo = Tag<0x8825, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_LONG, 1>;
+using ISO = Tag<0x8827, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 0>;
+using TimeZoneOffset = Tag<0x882A, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SSHORT, 0>;
+using SelfTimerMode = Tag<0x882B, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using ExifVersion = Tag<0x9000, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 4>;
+using DateTimeOriginal = Tag<0x9003, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using CreateDate = Tag<0x9004, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using ComponentsConfiguration = Tag<0x9101, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 4>;
+using CompressedBitsPerPixel = Tag<0x9102, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using ShutterSpeedValue = Tag<0x9201, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SRATIONAL, 1>;
+using ApertureValue = Tag<0x9202, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using BrightnessValue = Tag<0x9203, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SRATIONAL, 1>;
+using ExposureCompensation = Tag<0x9204, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SRATIONAL, 1>;
+using MaxApertureValue = Tag<0x9205, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using SubjectDistance = Tag<0x9206, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using MeteringMode = Tag<0x9207, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using LightSource = Tag<0x9208, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using Flash = Tag<0x9209, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using FocalLength = Tag<0x920A, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using SubjectArea = Tag<0x9214, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 0>;
+using UserComment = Tag<0x9286, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 0>;
+using SubSecTime = Tag<0x9290, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using SubSecTimeOriginal = Tag<0x9291, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using SubSecTimeDigitized = Tag<0x9292, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using XPTitle = Tag<0x9C9B, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 0>;
+using XPComment = Tag<0x9C9C, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 0>;
+using XPAuthor = Tag<0x9C9D, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 0>;
+using XPKeywords = Tag<0x9C9E, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 0>;
+using XPSubject = Tag<0x9C9F, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 0>;
+using FlashpixVersion = Tag<0xA000, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 4>;
+using ColorSpace = Tag<0xA001, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using ExifImageWidth = Tag<0xA002, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using ExifImageHeight = Tag<0xA003, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using RelatedSoundFile = Tag<0xA004, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using InteropOffset = Tag<0xA005, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_LONG, 1>;
+using FlashEnergy = Tag<0xA20B, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using FocalPlaneXResolution = Tag<0xA20E, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using FocalPlaneYResolution = Tag<0xA20F, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using FocalPlaneResolutionUnit = Tag<0xA210, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using SubjectLocation = Tag<0xA214, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 2>;
+using ExposureIndex = Tag<0xA215, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using SensingMethod = Tag<0xA217, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using FileSource = Tag<0xA300, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 1>;
+using SceneType = Tag<0xA301, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 1>;
+using CFAPattern = Tag<0xA302, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 0>;
+using CustomRendered = Tag<0xA401, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using ExposureMode = Tag<0xA402, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using WhiteBalance = Tag<0xA403, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using DigitalZoomRatio = Tag<0xA404, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using FocalLengthIn35mmFormat = Tag<0xA405, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using SceneCaptureType = Tag<0xA406, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using GainControl = Tag<0xA407, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using Contrast = Tag<0xA408, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using Saturation = Tag<0xA409, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using Sharpness = Tag<0xA40A, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using DeviceSettingDescription = Tag<0xA40B, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_UNDEFINED, 0>;
+using SubjectDistanceRange = Tag<0xA40C, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_SHORT, 1>;
+using ImageUniqueID = Tag<0xA420, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_ASCII, 0>;
+using Gamma = Tag<0xA500, NANOEXIF_IFD_EXIF, NANOEXIF_TYPE_RATIONAL, 1>;
+using DNGVersion = Tag<0xC612, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 4>;
+using DNGBackwardVersion = Tag<0xC613, NANOEXIF_IFD_0, NANOEXIF_TYPE_BYTE, 4>;
+using UniqueCameraModel = Tag<0xC614, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using LocalizedCameraModel = Tag<0xC615, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using CameraSerialNumber = Tag<0xC62F, NANOEXIF_IFD_0, NANOEXIF_TYPE_ASCII, 0>;
+using DNGLensInfo = Tag<0xC630, NANOEXIF_IFD_0, NANOEXIF_TYPE_RATIONAL, 4>;
+
+/* GPS */
+using GPSVersionID = Tag<0x0000, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_BYTE, 4>;
+using GPSLatitudeRef = Tag<0x0001, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSLatitude = Tag<0x0002, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 3>;
+using GPSLongitudeRef = Tag<0x0003, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSLongitude = Tag<0x0004, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 3>;
+using GPSAltitudeRef = Tag<0x0005, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_BYTE, 1>;
+using GPSAltitude = Tag<0x0006, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSTimeStamp = Tag<0x0007, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 3>;
+using GPSSatellites = Tag<0x0008, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 0>;
+using GPSStatus = Tag<0x0009, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSMeasureMode = Tag<0x000A, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSDOP = Tag<0x000B, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSSpeedRef = Tag<0x000C, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSSpeed = Tag<0x000D, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSTrackRef = Tag<0x000E, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSTrack = Tag<0x000F, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSImgDirectionRef = Tag<0x0010, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSImgDirection = Tag<0x0011, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSMapDatum = Tag<0x0012, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 0>;
+using GPSDestLatitudeRef = Tag<0x0013, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSDestLatitude = Tag<0x0014, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 3>;
+using GPSDestLongitudeRef = Tag<0x0015, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSDestLongitude = Tag<0x0016, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 3>;
+using GPSDestBearingRef = Tag<0x0017, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSDestBearing = Tag<0x0018, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSDestDistanceRef = Tag<0x0019, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 2>;
+using GPSDestDistance = Tag<0x001A, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+using GPSProcessingMethod = Tag<0x001B, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_UNDEFINED, 0>;
+using GPSAreaInformation = Tag<0x001C, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_UNDEFINED, 0>;
+using GPSDateStamp = Tag<0x001D, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_ASCII, 11>;
+using GPSDifferential = Tag<0x001E, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_SHORT, 1>;
+using GPSHPositioningError = Tag<0x001F, NANOEXIF_IFD_GPS, NANOEXIF_TYPE_RATIONAL, 1>;
+
+} // namespace tags
+} // namespace nanoexifpp
+
+#endif  /* NANOEXIF_TAGS_HPP__ */
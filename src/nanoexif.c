@@ -33,14 +33,24 @@ THE SOFTWARE.
  * @{
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <assert.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
 
 #include "nanoexif.h"
+#include "nanoexif-bswap.h"
+#include "nanoexif-private.h"
 
 #ifdef DEBUG
 #define D(...) printf(__VA_ARGS__);
@@ -48,54 +58,307 @@ THE SOFTWARE.
 #define D(...)
 #endif
 
-static inline uint32_t read_32(nanoexif_endian endian, const uint8_t *buf) {
-    if (endian == NANOEXIF_LITTLE_ENDIAN) {
-        return (buf[3]<<24) | (buf[2]<<16) | (buf[1]<<8) | buf[0];
-    } else {
-        return (buf[0]<<24) | (buf[1]<<16) | (buf[2]<<8) | buf[3];
+/* counters for nanoexif_stats. STAT(st, field, n) adds n to the handle's counters(st may be NULL) and the process's. */
+#ifdef NANOEXIF_STATS
+static nanoexif_stats PROCESS_STATS;
+#ifdef __GNUC__
+#define STAT_PROCESS(field, n) __atomic_fetch_add(&PROCESS_STATS.field, (n), __ATOMIC_RELAXED)
+#else
+#define STAT_PROCESS(field, n) (PROCESS_STATS.field += (n))
+#endif
+#define STAT(st, field, n) do { \
+        uint64_t stat_n_ = (n); \
+        nanoexif_stats *stat_st_ = (st); \
+        if (stat_st_) { stat_st_->field += stat_n_; } \
+        STAT_PROCESS(field, stat_n_); \
+    } while (0)
+#define STAT_START(t) uint64_t t = stat_clock()
+#define STAT_TIME(st, field, t) STAT(st, field, stat_clock() - (t))
+
+static uint64_t stat_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#else
+#define STAT(st, field, n) do { (void)(st); (void)(n); } while (0)
+#define STAT_START(t)
+#define STAT_TIME(st, field, t)
+#endif
+#define STAT_ALLOC(st, n) do { STAT(st, allocs, 1); STAT(st, alloc_bytes, (n)); } while (0)
+
+/* the decoders, instantiated once for each file endian. the callers pick one by ne->endian,
+ * so the inner loops have no branch on the endian. */
+#define NANOEXIF_DEFINE_DECODERS(E) \
+static inline void decode_entry_##E(const uint8_t *p, nanoexif_ifd_entry *entry) { \
+    entry->tag   = E##_16(p); \
+    entry->type  = E##_16(p+2); \
+    entry->count = E##_32(p+4); \
+    memcpy(entry->offset, p+8, 4); \
+} \
+\
+static void decode_entries_##E(const uint8_t *p, uint16_t cnt, nanoexif_ifd_entry *entries) { \
+    uint16_t i; \
+    for (i=0; i<cnt; i++) { \
+        decode_entry_##E(p + sizeof(nanoexif_ifd_entry)*i, entries+i); \
+    } \
+} \
+\
+/* entries should be sorted by tag, but some writers don't sort them. */ \
+static bool entries_sorted_##E(const uint8_t *entries, uint16_t count) { \
+    uint16_t i; \
+    for (i=1; i<count; i++) { \
+        if (E##_16(entries + sizeof(nanoexif_ifd_entry)*(i-1)) > E##_16(entries + sizeof(nanoexif_ifd_entry)*i)) { \
+            return false; \
+        } \
+    } \
+    return true; \
+} \
+\
+/* the first entry of the tag: the lower bound by binary search if sorted, or a scan. */ \
+static int find_entry_##E(const uint8_t *entries, uint16_t count, bool sorted, uint16_t tag) { \
+    int i; \
+    if (sorted) { \
+        int lo = 0, hi = count; \
+        while (lo < hi) { \
+            int mid = (lo + hi) / 2; \
+            if (E##_16(entries + sizeof(nanoexif_ifd_entry)*mid) < tag) { \
+                lo = mid + 1; \
+            } else { \
+                hi = mid; \
+            } \
+        } \
+        return lo < count && E##_16(entries + sizeof(nanoexif_ifd_entry)*lo) == tag ? lo : -1; \
+    } \
+    for (i=0; i<count; i++) { \
+        if (E##_16(entries + sizeof(nanoexif_ifd_entry)*i) == tag) { \
+            return i; \
+        } \
+    } \
+    return -1; \
+} \
+\
+static bool value_uint_##E(uint16_t type, const uint8_t *p, uint32_t i, uint32_t *value) { \
+    switch (type) { \
+    case NANOEXIF_TYPE_BYTE: \
+        *value = p[i]; \
+        return true; \
+    case NANOEXIF_TYPE_SHORT: \
+        *value = E##_16(p+i*2); \
+        return true; \
+    case NANOEXIF_TYPE_LONG: \
+        *value = E##_32(p+i*4); \
+        return true; \
+    } \
+    return false; \
+} \
+\
+static bool value_double_##E(uint16_t type, const uint8_t *p, uint32_t i, double *value) { \
+    switch (type) { \
+    case NANOEXIF_TYPE_BYTE: \
+        *value = p[i]; \
+        return true; \
+    case NANOEXIF_TYPE_SBYTE: \
+        *value = (int8_t)p[i]; \
+        return true; \
+    case NANOEXIF_TYPE_SHORT: \
+        *value = E##_16(p+i*2); \
+        return true; \
+    case NANOEXIF_TYPE_SSHORT: \
+        *value = (int16_t)E##_16(p+i*2); \
+        return true; \
+    case NANOEXIF_TYPE_LONG: \
+        *value = E##_32(p+i*4); \
+        return true; \
+    case NANOEXIF_TYPE_SLONG: \
+        *value = (int32_t)E##_32(p+i*4); \
+        return true; \
+    case NANOEXIF_TYPE_RATIONAL: \
+        { \
+            uint32_t den = E##_32(p+i*8+4); \
+            if (den == 0) { return false; } \
+            *value = (double)E##_32(p+i*8) / den; \
+            return true; \
+        } \
+    case NANOEXIF_TYPE_SRATIONAL: \
+        { \
+            int32_t den = (int32_t)E##_32(p+i*8+4); \
+            if (den == 0) { return false; } \
+            *value = (double)(int32_t)E##_32(p+i*8) / den; \
+            return true; \
+        } \
+    } \
+    return false; \
+}
+
+NANOEXIF_DEFINE_DECODERS(le)
+NANOEXIF_DEFINE_DECODERS(be)
+
+/* read through the io. a short read is taken as the end of file. return bytes read, or -1 on error. */
+static int64_t io_read(const nanoexif_io *io, uint64_t offset, size_t len, uint8_t *buf, nanoexif_read_stats *stats, nanoexif_stats *st) {
+    int64_t r = io->read_at(io->ctx, offset, len, buf);
+    stats->syscalls++;
+    if (r > 0) { stats->bytes += r; }
+    STAT(st, reads, 1);
+    STAT(st, bytes_read, r > 0 ? r : 0);
+    return r;
+}
+
+/* nanoexif_io over pread(2). ctx points to the fd. */
+static int64_t fd_read_at(void *ctx, uint64_t offset, size_t len, uint8_t *buf) {
+    while (1) {
+        ssize_t r = pread(*(int*)ctx, buf, len, offset);
+        if (r < 0 && errno == EINTR) { continue; }
+        return r;
     }
 }
 
-static inline uint16_t read_16(nanoexif_endian endian, const uint8_t *buf) {
-    if (endian == NANOEXIF_LITTLE_ENDIAN) {
-        return (buf[1]<<8) | buf[0];
-    } else {
-        return (buf[0]<<8) | buf[1];
+/* bytes fetched past the prefix at a time, to cover an ifd and the small values around it. */
+#define NANOEXIF_FETCH_SIZE 4096
+
+/* values larger than this are not prefetched, but read when they are accessed. */
+#define NANOEXIF_PREFETCH_MAX NANOEXIF_PREFIX_SIZE
+
+typedef struct nanoexif_chunk {
+    struct nanoexif_chunk * next;
+    uint32_t offset;
+    uint32_t size;
+    uint8_t data[];
+} nanoexif_chunk;
+
+/* the file behind a handle from nanoexif_init_tiff_fd() or nanoexif_init_io(). bytes past ne->len are read on demand, and kept until nanoexif_free(). */
+struct nanoexif_source {
+    nanoexif_io io;
+    int fd; /* ctx of io, for nanoexif_init_tiff_fd() */
+    uint64_t size;
+    nanoexif_chunk * chunks;
+    nanoexif_read_stats stats;
+    nanoexif_stats * counters; /* of the handle */
+};
+
+static const uint8_t * source_cached(const struct nanoexif_source *src, uint32_t offset, uint32_t size) {
+    const nanoexif_chunk *c;
+    for (c=src->chunks; c; c=c->next) {
+        if (offset >= c->offset && (uint64_t)offset + size <= (uint64_t)c->offset + c->size) {
+            return c->data + (offset - c->offset);
+        }
     }
+    return NULL;
 }
 
-static inline uint16_t swap_endian_16(uint16_t i) {
-    return ((i&0xff)<<8) | ((i&0xff00)>>8);
+/* read [offset, offset+size) into a new chunk, with at least NANOEXIF_FETCH_SIZE bytes. */
+static const nanoexif_chunk * source_read(struct nanoexif_source *src, uint32_t offset, uint32_t size) {
+    uint64_t want = size < NANOEXIF_FETCH_SIZE ? NANOEXIF_FETCH_SIZE : size;
+    if (offset + want > src->size) { want = src->size - offset; }
+    STAT_START(t);
+    nanoexif_chunk *c = malloc(sizeof(nanoexif_chunk) + want);
+    if (!c) { return NULL; }
+    STAT_ALLOC(src->counters, sizeof(nanoexif_chunk) + want);
+    int64_t r = io_read(&src->io, offset, want, c->data, &src->stats, src->counters);
+    STAT_TIME(src->counters, ns_load, t);
+    if (r < (int64_t)size) {
+        D("short read at %u\n", offset);
+        free(c);
+        return NULL;
+    }
+    c->offset = offset;
+    c->size   = r;
+    c->next   = src->chunks;
+    src->chunks = c;
+    return c;
 }
-static inline uint32_t swap_endian_32(uint32_t i) {
-    return ((i&0x000000ff)<<24) | ((i&0x0000ff00)<<8) | ((i&0x00ff0000)>>8) | ((i&0xff000000)>>24);
+
+static const uint8_t * source_fetch(struct nanoexif_source *src, uint32_t offset, uint32_t size) {
+    if ((uint64_t)offset + size > src->size) {
+        D("out of file: %u+%u > %llu\n", offset, size, (unsigned long long)src->size);
+        return NULL;
+    }
+    const uint8_t *p = source_cached(src, offset, size);
+    if (p) { return p; }
+    const nanoexif_chunk *c = source_read(src, offset, size);
+    return c ? c->data : NULL;
 }
 
-static inline nanoexif * parse_app1(FILE * fp, size_t app1_len, uint32_t * ifd_offset) {
-    if (app1_len < 6) { return NULL; }
+static void source_free(struct nanoexif_source *src) {
+    if (!src) { return; }
+    while (src->chunks) {
+        nanoexif_chunk *next = src->chunks->next;
+        free(src->chunks);
+        src->chunks = next;
+    }
+    free(src);
+}
 
-    // check exif header
-    {
-        uint8_t exif_header[6];
-        if (fread(exif_header, 1, 6, fp) != 6) {
-            D("CANNOT read exif header\n");
-            return NULL;
-        }
-        const char *EXIF_HEADER = "\x45\x78\x69\x66\x00\x00";
-        if (memcmp(exif_header, EXIF_HEADER, 6)!=0) {
-            D("EXIFHEADER\n");
-            return NULL;
+/* bounds checked view of [offset, offset+size) in the tiff data. */
+static inline const uint8_t * range(const nanoexif *ne, uint32_t offset, uint32_t size) {
+    if ((uint64_t)offset + size > ne->len) {
+        if (ne->source) {
+            return source_fetch(ne->source, offset, size);
         }
+        D("out of range: %u+%u > %zu\n", offset, size, ne->len);
+        return NULL;
     }
+    return ne->buf + offset;
+}
 
-    uint8_t *buf = malloc(app1_len-6);
-    if (!buf) { return NULL; }
+/* decode the entry at the position. */
+static inline void decode_entry(const nanoexif *ne, const uint8_t *p, nanoexif_ifd_entry *entry) {
+    if (ne->endian == NANOEXIF_LITTLE_ENDIAN) {
+        decode_entry_le(p, entry);
+    } else {
+        decode_entry_be(p, entry);
+    }
+}
 
-    if (fread(buf, 1, app1_len-6, fp) != app1_len-6) {
-        D("CANNOT read app1 header\n");
-        free(buf);
-        return NULL;
+typedef struct {
+    uint32_t offset;
+    uint32_t end;
+} nanoexif_span;
+
+static int span_cmp(const void *a, const void *b) {
+    uint32_t x = ((const nanoexif_span*)a)->offset, y = ((const nanoexif_span*)b)->offset;
+    return x < y ? -1 : x > y;
+}
+
+/* every value of the directory is going to be read: read the ones which are neither in ne->buf nor cached,
+ * merging the ones closer than NANOEXIF_FETCH_SIZE into one read. errors are left to the access. */
+static void source_prefetch(const nanoexif *ne, const uint8_t *entries, uint16_t count) {
+    struct nanoexif_source *src = ne->source;
+    if (!src || count == 0) { return; }
+    nanoexif_span *spans = malloc(sizeof(nanoexif_span)*count);
+    if (!spans) { return; }
+    STAT_ALLOC(ne->stats, sizeof(nanoexif_span)*count);
+
+    size_t n = 0, i;
+    for (i=0; i<count; i++) {
+        nanoexif_ifd_entry e;
+        decode_entry(ne, entries + sizeof(nanoexif_ifd_entry)*i, &e);
+        uint64_t size = (uint64_t)nanoexif_type_size(e.type) * e.count;
+        if (size <= 4 || size > NANOEXIF_PREFETCH_MAX) { continue; }
+        uint32_t offset = read_32(ne->endian, e.offset);
+        if (offset + size <= ne->len || offset + size > src->size || source_cached(src, offset, size)) { continue; }
+        spans[n].offset = offset;
+        spans[n].end    = offset + size;
+        n++;
     }
+    if (n) {
+        qsort(spans, n, sizeof(nanoexif_span), span_cmp);
+        nanoexif_span cur = spans[0];
+        for (i=1; i<=n; i++) {
+            if (i < n && (uint64_t)spans[i].offset <= (uint64_t)cur.end + NANOEXIF_FETCH_SIZE) {
+                if (spans[i].end > cur.end) { cur.end = spans[i].end; }
+                continue;
+            }
+            source_read(src, cur.offset, cur.end - cur.offset);
+            if (i < n) { cur = spans[i]; }
+        }
+    }
+    free(spans);
+}
+
+/* check the tiff header at the top of buf, and fill the handle for it. */
+static bool init_handle(nanoexif *ne, const uint8_t *buf, size_t len, uint8_t *owned, uint32_t * ifd_offset) {
+    if (len < 8) { return false; }
 
     nanoexif_endian endian;
     if (memcmp(buf, "\x4d\x4d", 2) == 0) {
@@ -109,51 +372,121 @@ static inline nanoexif * parse_app1(FILE * fp, size_t app1_len, uint32_t * ifd_o
     uint16_t tag_mark = read_16(endian, buf+2);
     if (tag_mark == 0x2A00) {
         D("tiff header fail\n");
-        free(buf);
-        return NULL; // tiff
+        return false; // tiff
     }
     *ifd_offset = read_32(endian, buf+4);
 
+    ne->endian         = endian;
+    ne->buf            = buf;
+    ne->offset         = 0;
+    ne->len            = len;
+    ne->owned          = owned;
+    ne->map            = NULL;
+    ne->map_len        = 0;
+    ne->source         = NULL;
+#ifdef NANOEXIF_STATS
+    /* ctx and parser handles keep theirs, and count from zero for each file */
+    if (!ne->stats) { ne->stats = malloc(sizeof(nanoexif_stats)); }
+    if (ne->stats) { memset(ne->stats, 0, sizeof(nanoexif_stats)); }
+#endif
+    return true;
+}
+
+#ifdef NANOEXIF_STATS
+/* add the counts made before the handle was created. they are in the process's already. */
+static void stats_merge(nanoexif *ne, const nanoexif_stats *pre) {
+    if (!ne->stats) { return; }
+    /* every field is uint64_t */
+    uint64_t *dst = (uint64_t*)ne->stats;
+    const uint64_t *src = (const uint64_t*)pre;
+    size_t i;
+    for (i=0; i<sizeof(nanoexif_stats)/sizeof(uint64_t); i++) { dst[i] += src[i]; }
+}
+#define STATS_MERGE(ne, pre) stats_merge((ne), (pre))
+#else
+#define STATS_MERGE(ne, pre) ((void)(ne), (void)(pre))
+#endif
+
+static nanoexif * new_handle(const uint8_t *buf, size_t len, uint8_t *owned, uint32_t * ifd_offset) {
     nanoexif * ne = malloc(sizeof(nanoexif));
-    if (!ne) {
-        free(buf);
+    if (!ne) { return NULL; }
+    ne->stats = NULL;
+    if (!init_handle(ne, buf, len, owned, ifd_offset)) {
+        free(ne->stats);
+        free(ne);
         return NULL;
     }
-    ne->endian         = endian;
-    ne->buf            = buf;
+    STAT_ALLOC(ne->stats, sizeof(nanoexif));
     return ne;
 }
 
-/** initialize nanoexif struct.
- * @param FILE * fp: file pointer for reading exif
- * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
- * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
- *
- * You should call nanoexif_free(ne) if return value is not null.
- */
-nanoexif * nanoexif_init(FILE *fp, uint32_t *ifd_offset) {
+static const char *EXIF_HEADER = "\x45\x78\x69\x66\x00\x00";
+
+/* read the tiff data in APP1 into *buf, growing it if it is smaller than *cap. */
+static inline bool parse_app1(FILE * fp, size_t app1_len, uint8_t ** buf, size_t * cap, nanoexif_stats *st) {
+    /* app1_len counts the 2 length bytes, and the 6 bytes of exif header. */
+    if (app1_len < 8) { return false; }
+
+    // check exif header
+    {
+        uint8_t exif_header[6];
+        STAT(st, reads, 1);
+        STAT(st, bytes_read, 6);
+        if (fread(exif_header, 1, 6, fp) != 6) {
+            D("CANNOT read exif header\n");
+            return false;
+        }
+        if (memcmp(exif_header, EXIF_HEADER, 6)!=0) {
+            D("EXIFHEADER\n");
+            return false;
+        }
+    }
+
+    if (*cap < app1_len-8) {
+        uint8_t *tmp = realloc(*buf, app1_len-8);
+        if (!tmp) { return false; }
+        STAT_ALLOC(st, app1_len-8);
+        *buf = tmp;
+        *cap = app1_len-8;
+    }
+
+    STAT(st, reads, 1);
+    STAT(st, bytes_read, app1_len-8);
+    if (fread(*buf, 1, app1_len-8, fp) != app1_len-8) {
+        D("CANNOT read app1 header\n");
+        return false;
+    }
+    return true;
+}
+
+/* skip the segments before APP1, and return the length of APP1. return 0 if error occurred. */
+static uint16_t seek_app1(FILE *fp, nanoexif_stats *st) {
     {
         char soi[2];
+        STAT(st, reads, 1);
+        STAT(st, bytes_read, 2);
         if (fread(soi, sizeof(char), 2, fp) != 2) {
             D("cannot read soi\n");
-            return NULL;
+            return 0;
         }
         if (soi[0] != '\xff' && soi[1] != '\xd8') {
             D("err, not soi");
-            return NULL;
+            return 0;
         }
     }
 
     /* some jpeg file put APP0 header before APP1 header. Yes, this is invalid. */
     while (1) {
         uint8_t marker_len[4];
+        STAT(st, reads, 1);
+        STAT(st, bytes_read, sizeof(marker_len));
         if (fread(marker_len, 1, sizeof(marker_len), fp) != sizeof(marker_len)) {
             D("cannot read marker\n");
-            return NULL;
+            return 0;
         }
         if (marker_len[0] != (uint8_t)'\xFF') {
             D("invalid marker\n");
-            return NULL;
+            return 0;
         }
 
         /* marker length is always big endian */
@@ -161,19 +494,478 @@ nanoexif * nanoexif_init(FILE *fp, uint32_t *ifd_offset) {
 
         if (marker_len[1] == (uint8_t)'\xE1') { // APP1
             D("app1 header : %d\n", len);
-            return parse_app1(fp, len, ifd_offset);
+            return len;
         } else if (marker_len[1] == (uint8_t)'\xDA') { // SOS
             /* reach to image.. hmm. this jpeg doesn't contains exif. */
-            return NULL; /* missing exif */
+            return 0; /* missing exif */
         } else {
             /* skip this part... */
+            STAT(st, seeks, 1);
+            STAT(st, markers_skipped, 1);
             if (fseek(fp, len-2, SEEK_CUR) != 0) {
                 D("cannot seek\n");
-                return NULL;
+                return 0;
+            }
+        }
+    }
+    return 0; // should not reach here
+}
+
+/** initialize nanoexif struct.
+ * @param FILE * fp: file pointer for reading exif
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * You should call nanoexif_free(ne) if return value is not null.
+ */
+nanoexif * nanoexif_init(FILE *fp, uint32_t *ifd_offset) {
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    STAT_START(t0);
+    uint16_t len = seek_app1(fp, &pre);
+    STAT_TIME(&pre, ns_scan, t0);
+    if (!len) { return NULL; }
+
+    STAT_START(t1);
+    uint8_t *buf = NULL;
+    size_t cap = 0;
+    if (!parse_app1(fp, len, &buf, &cap, &pre)) {
+        free(buf);
+        return NULL;
+    }
+    STAT_TIME(&pre, ns_load, t1);
+
+    nanoexif * ne = new_handle(buf, len-8, buf, ifd_offset);
+    if (!ne) {
+        free(buf);
+        return NULL;
+    }
+    STATS_MERGE(ne, &pre);
+    return ne;
+}
+
+/* find the exif APP1 segment in the jpeg on memory.
+ * return the bytes from the top of the file to the end of APP1, and set *app1 to where the segment starts.
+ * if the return value is greater than len, data is too short to tell; read that many bytes and try again.
+ * return 0 if the jpeg has no exif. */
+static size_t scan_app1(const uint8_t *data, size_t len, size_t *app1, unsigned *skipped) {
+    *skipped = 0;
+    if (len < 2) { return 2; }
+    if (data[0] != 0xFF || data[1] != 0xD8) {
+        D("err, not soi");
+        return 0;
+    }
+
+    size_t pos = 2;
+    while (1) {
+        if (pos + 4 > len) {
+            return pos + 4;
+        }
+        if (data[pos] != 0xFF) {
+            D("invalid marker\n");
+            return 0;
+        }
+
+        /* marker length is always big endian */
+        uint16_t seg_len = read_16(NANOEXIF_BIG_ENDIAN, data+pos+2);
+
+        if (data[pos+1] == 0xE1 && seg_len >= 8) { // APP1
+            D("app1 header : %d\n", seg_len);
+            if (pos + 10 > len) {
+                return pos + 10;
+            }
+            if (memcmp(data+pos+4, EXIF_HEADER, 6) == 0) {
+                *app1 = pos;
+                return pos + 2 + seg_len;
             }
+            /* XMP and friends also live in APP1 */
+            D("EXIFHEADER\n");
+            pos += 2 + seg_len;
+            (*skipped)++;
+        } else if (data[pos+1] == 0xDA) { // SOS
+            return 0; /* missing exif */
+        } else {
+            pos += 2 + seg_len;
+            (*skipped)++;
+        }
+    }
+    return 0; // should not reach here
+}
+
+/** tell how much of the jpeg file is needed to read its exif.
+ * @param const uint8_t * data: the head of the jpeg file
+ * @param size_t len: bytes of data
+ * @return bytes from the top of the file to the end of exif APP1 segment. return 0 if the jpeg has no exif.
+ *
+ * If the return value is greater than len, data is too short to tell the answer. Read that many
+ * bytes and call again. Once the return value fits in len, nanoexif_init_from_memory(data, len, ...) succeeds.
+ */
+size_t nanoexif_exif_extent(const uint8_t *data, size_t len) {
+    size_t app1;
+    unsigned skipped;
+    return scan_app1(data, len, &app1, &skipped);
+}
+
+/** initialize nanoexif struct from the jpeg file image on memory.
+ * @param const uint8_t * data: whole jpeg file(or the head of it, up to the end of APP1 segment)
+ * @param size_t len: bytes of data
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The exif data is not copied. ne->buf points into data, so data must outlive the
+ * returned struct. You should call nanoexif_free(ne) if return value is not null.
+ */
+nanoexif * nanoexif_init_from_memory(const uint8_t *data, size_t len, uint32_t *ifd_offset) {
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    STAT_START(t);
+    size_t app1;
+    unsigned skipped;
+    size_t end = scan_app1(data, len, &app1, &skipped);
+    STAT(&pre, markers_skipped, skipped);
+    STAT_TIME(&pre, ns_scan, t);
+    if (end == 0 || end > len) {
+        D("missing or truncated app1\n");
+        return NULL;
+    }
+    nanoexif * ne = new_handle(data+app1+10, end-app1-10, NULL, ifd_offset);
+    if (ne) { STATS_MERGE(ne, &pre); }
+    return ne;
+}
+
+/* read the head of the file into *buf, enough to hold the exif APP1. *got is set to the bytes in *buf. *app1 and the return value are as scan_app1(). */
+static size_t read_app1(const nanoexif_io *io, size_t prefix, uint8_t **buf, size_t *cap, size_t *got, size_t *app1, nanoexif_read_stats *stats, nanoexif_stats *st) {
+    if (!prefix) { prefix = NANOEXIF_PREFIX_SIZE; }
+    size_t want = prefix;
+    *got = 0;
+    while (1) {
+        if (*cap < want) {
+            uint8_t *tmp = realloc(*buf, want);
+            if (!tmp) { return 0; }
+            STAT_ALLOC(st, want);
+            *buf = tmp;
+            *cap = want;
+        }
+        STAT_START(t0);
+        int64_t r = io_read(io, *got, want-*got, *buf+*got, stats, st);
+        STAT_TIME(st, ns_load, t0);
+        if (r < 0) { return 0; }
+        *got += r;
+
+        STAT_START(t1);
+        unsigned skipped;
+        size_t end = scan_app1(*buf, *got, app1, &skipped);
+        STAT_TIME(st, ns_scan, t1);
+        if (end == 0 || end <= *got) {
+            /* the last scan went over all of them */
+            STAT(st, markers_skipped, skipped);
+            return end;
+        }
+        if (*got < want) {
+            D("truncated jpeg\n");
+            return 0;
+        }
+        /* APP1 goes past the prefix: read up to its end. if only the next marker is missing, read another prefix. */
+        want = end - *got > 10 ? end : *got + prefix;
+    }
+}
+
+/* move the exif APP1 payload in buf to the top, and make the handle own buf. */
+static nanoexif * own_exif(uint8_t *buf, size_t app1, size_t end, uint32_t *ifd_offset, const nanoexif_stats *pre) {
+    /* keep only the exif, not the whole prefix */
+    size_t len = end-app1-10;
+    memmove(buf, buf+app1+10, len);
+    uint8_t *tmp = realloc(buf, len ? len : 1);
+    if (tmp) { buf = tmp; }
+
+    nanoexif * ne = new_handle(buf, len, buf, ifd_offset);
+    if (!ne) {
+        free(buf);
+        return NULL;
+    }
+    STATS_MERGE(ne, pre);
+    return ne;
+}
+
+/** initialize nanoexif struct from the jpeg file, with pread(2) on a file descriptor.
+ * @param int fd: file descriptor for reading exif
+ * @param size_t prefix: bytes of the first read. 0 means NANOEXIF_PREFIX_SIZE.
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @param nanoexif_read_stats * stats: the syscalls and bytes used will be set. may be NULL.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The segments are walked over one read of the file's head. A second read is issued only if
+ * the exif APP1 extends past it. The file offset of fd is not changed, and fd may be closed after this call.
+ * You should call nanoexif_free(ne) if return value is not null.
+ */
+nanoexif * nanoexif_init_fd(int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats) {
+    nanoexif_read_stats local;
+    if (!stats) { stats = &local; }
+    stats->syscalls = 0;
+    stats->bytes    = 0;
+
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    nanoexif_io io = { fd_read_at, &fd };
+    uint8_t *buf = NULL;
+    size_t cap = 0, got, app1;
+    size_t end = read_app1(&io, prefix, &buf, &cap, &got, &app1, stats, &pre);
+    if (end == 0) {
+        free(buf);
+        return NULL;
+    }
+    return own_exif(buf, app1, end, ifd_offset, &pre);
+}
+
+/** initialize nanoexif struct from the tiff image on memory. TIFF based raw files(DNG, CR2, NEF, ARW...) are TIFF.
+ * @param const uint8_t * data: the tiff file, or the head of it
+ * @param size_t len: bytes of data
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The data is not copied, as nanoexif_init_from_memory(). You should call nanoexif_free(ne) if return value is not null.
+ */
+nanoexif * nanoexif_init_tiff(const uint8_t *data, size_t len, uint32_t *ifd_offset) {
+    if (len < 4 || !(memcmp(data, "II", 2) == 0 || memcmp(data, "MM", 2) == 0)) {
+        D("not tiff\n");
+        return NULL;
+    }
+    return new_handle(data, len, NULL, ifd_offset);
+}
+
+/** initialize nanoexif struct from the tiff file, reading only the parts that are used.
+ * @param int fd: file descriptor for reading the tiff. It should stay open until nanoexif_free(ne), which does not close it.
+ * @param size_t prefix: bytes of the first read. 0 means NANOEXIF_PREFIX_SIZE.
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @param nanoexif_read_stats * stats: the syscalls and bytes of the first read will be set. may be NULL.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * ne->buf holds the prefix. Ifds and values past it are read with pread(2) when they are accessed, a few KB at
+ * a time, and kept until nanoexif_free(ne). So reading the metadata of a 50MB raw file reads tens of KB.
+ * As the reads fill a cache in ne, the handle should not be shared between threads.
+ * nanoexif_io_stats() tells the I/O done so far.
+ */
+nanoexif * nanoexif_init_tiff_fd(int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 8 || (uint64_t)st.st_size > UINT32_MAX) {
+        D("cannot stat, or not a classic tiff\n");
+        return NULL;
+    }
+    if (!prefix) { prefix = NANOEXIF_PREFIX_SIZE; }
+    if (prefix > (uint64_t)st.st_size) { prefix = st.st_size; }
+
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    struct nanoexif_source *src = calloc(1, sizeof(struct nanoexif_source));
+    uint8_t *buf = malloc(prefix);
+    nanoexif *ne = NULL;
+    if (src && buf) {
+        STAT_ALLOC(&pre, sizeof(struct nanoexif_source));
+        STAT_ALLOC(&pre, prefix);
+        src->fd          = fd;
+        src->io.read_at  = fd_read_at;
+        src->io.ctx      = &src->fd;
+        src->size        = st.st_size;
+        STAT_START(t);
+        int64_t got = io_read(&src->io, 0, prefix, buf, &src->stats, &pre);
+        STAT_TIME(&pre, ns_load, t);
+        if (stats) { *stats = src->stats; }
+        if (got >= 8) {
+            ne = nanoexif_init_tiff(buf, got, ifd_offset);
         }
     }
-    return NULL; // should not reach here
+    if (!ne) {
+        free(buf);
+        free(src);
+        return NULL;
+    }
+    STATS_MERGE(ne, &pre);
+    src->counters = ne->stats;
+    ne->owned  = buf;
+    ne->source = src;
+    return ne;
+}
+
+/** initialize nanoexif struct from the jpeg or tiff file behind the io, in as few reads as possible.
+ * @param const nanoexif_io * io: the reader. for tiff, it should stay valid until nanoexif_free(ne), which does not release it.
+ * @param size_t prefix: bytes of the first read, the header window. 0 means NANOEXIF_PREFIX_SIZE.
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @param nanoexif_read_stats * stats: the read_at calls and bytes used will be set. may be NULL.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The header window is read in one call. For jpeg, the rest of the exif APP1 is read in one more call if it is
+ * past the window, and the handle does not use io after this. Tiff is read on demand as nanoexif_init_tiff_fd():
+ * ranges are at least a few KB, and when an ifd is read by nanoexif_read_ifd() or the walker, the values it points
+ * to are read together, merged into as few calls as their distances allow.
+ */
+nanoexif * nanoexif_init_io(const nanoexif_io *io, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats) {
+    nanoexif_read_stats local;
+    if (!stats) { stats = &local; }
+    stats->syscalls = 0;
+    stats->bytes    = 0;
+
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    uint8_t *buf = NULL;
+    size_t cap = 0, got, app1;
+    size_t end = read_app1(io, prefix, &buf, &cap, &got, &app1, stats, &pre);
+    if (end) {
+        return own_exif(buf, app1, end, ifd_offset, &pre);
+    }
+
+    nanoexif *ne = NULL;
+    struct nanoexif_source *src = calloc(1, sizeof(struct nanoexif_source));
+    if (src && buf && got >= 8) {
+        STAT_ALLOC(&pre, sizeof(struct nanoexif_source));
+        src->io    = *io;
+        /* a short read is the end of file */
+        src->size  = got < cap ? got : (uint64_t)UINT32_MAX + 1;
+        src->stats = *stats;
+        ne = nanoexif_init_tiff(buf, got, ifd_offset);
+    }
+    if (!ne) {
+        free(buf);
+        free(src);
+        return NULL;
+    }
+    STATS_MERGE(ne, &pre);
+    src->counters = ne->stats;
+    ne->owned  = buf;
+    ne->source = src;
+    return ne;
+}
+
+/** tell the I/O done for the handle, including the first read.
+ * @param const nanoexif * ne
+ * @param nanoexif_read_stats * stats: will be set. zero for handles which read nothing on demand.
+ */
+void nanoexif_io_stats(const nanoexif *ne, nanoexif_read_stats *stats) {
+    if (ne->source) {
+        *stats = ne->source->stats;
+    } else {
+        stats->syscalls = 0;
+        stats->bytes    = 0;
+    }
+}
+
+/** copy the counters of the handle.
+ * @param const nanoexif * ne
+ * @param nanoexif_stats * stats: will be set. all zero without NANOEXIF_STATS.
+ * @return true if the library is built with NANOEXIF_STATS.
+ *
+ * The counts start at the nanoexif_init*() or nanoexif_reset*() which made the handle.
+ */
+bool nanoexif_handle_stats(const nanoexif *ne, nanoexif_stats *stats) {
+    memset(stats, 0, sizeof(nanoexif_stats));
+#ifdef NANOEXIF_STATS
+    if (ne->stats) { *stats = *ne->stats; }
+    return true;
+#else
+    (void)ne;
+    return false;
+#endif
+}
+
+/** copy the counters summed over every handle in the process, freed ones included.
+ * @param nanoexif_stats * stats: will be set. all zero without NANOEXIF_STATS.
+ * @return true if the library is built with NANOEXIF_STATS.
+ *
+ * Safe to call while other threads parse; each field is read atomically, but not the struct as a whole.
+ */
+bool nanoexif_process_stats(nanoexif_stats *stats) {
+    memset(stats, 0, sizeof(nanoexif_stats));
+#ifdef NANOEXIF_STATS
+    /* every field is uint64_t */
+    uint64_t *dst = (uint64_t*)stats;
+    uint64_t *src = (uint64_t*)&PROCESS_STATS;
+    size_t i;
+    for (i=0; i<sizeof(nanoexif_stats)/sizeof(uint64_t); i++) {
+#ifdef __GNUC__
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+#else
+        dst[i] = src[i];
+#endif
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** zero the counters of the process.
+ */
+void nanoexif_process_stats_reset(void) {
+#ifdef NANOEXIF_STATS
+    uint64_t *p = (uint64_t*)&PROCESS_STATS;
+    size_t i;
+    for (i=0; i<sizeof(nanoexif_stats)/sizeof(uint64_t); i++) {
+#ifdef __GNUC__
+        __atomic_store_n(&p[i], 0, __ATOMIC_RELAXED);
+#else
+        p[i] = 0;
+#endif
+    }
+#endif
+}
+
+/** parse the next file with the context, with pread(2) on a file descriptor.
+ * @param nanoexif_ctx * ctx: the context
+ * @param int fd: file descriptor for reading exif
+ * @param size_t prefix: bytes of the first read. 0 means NANOEXIF_PREFIX_SIZE.
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @param nanoexif_read_stats * stats: the syscalls and bytes used will be set. may be NULL.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * Same as nanoexif_init_fd(), but the buffer is kept in ctx as nanoexif_reset().
+ */
+nanoexif * nanoexif_reset_fd(nanoexif_ctx * ctx, int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats) {
+    nanoexif_read_stats local;
+    if (!stats) { stats = &local; }
+    stats->syscalls = 0;
+    stats->bytes    = 0;
+    ctx->ne.len = 0;
+
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    nanoexif_io io = { fd_read_at, &fd };
+    size_t got, app1;
+    size_t end = read_app1(&io, prefix, &ctx->buf, &ctx->buf_cap, &got, &app1, stats, &pre);
+    if (end == 0) { return NULL; }
+    if (!init_handle(&ctx->ne, ctx->buf+app1+10, end-app1-10, NULL, ifd_offset)) { return NULL; }
+    STATS_MERGE(&ctx->ne, &pre);
+    return &ctx->ne;
+}
+
+/** initialize nanoexif struct by mapping the jpeg file.
+ * @param int fd: file descriptor for reading exif
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The file is mapped read only and nothing is copied. ne->buf and every view taken
+ * from it(nanoexif_range, nanoexif_easy_thumbnail_view) point into the mapping and
+ * stay valid until nanoexif_free(ne), which unmaps it. fd may be closed after this call.
+ */
+nanoexif * nanoexif_init_mmap(int fd, uint32_t *ifd_offset) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        D("cannot stat\n");
+        return NULL;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        D("cannot mmap\n");
+        return NULL;
+    }
+
+    nanoexif * ne = nanoexif_init_from_memory(map, st.st_size, ifd_offset);
+    if (!ne) {
+        munmap(map, st.st_size);
+        return NULL;
+    }
+    ne->map     = map;
+    ne->map_len = st.st_size;
+    return ne;
 }
 
 /** destruct the struct nanoexif*.
@@ -181,39 +973,200 @@ nanoexif * nanoexif_init(FILE *fp, uint32_t *ifd_offset) {
  */
 void nanoexif_free(nanoexif * ne) {
     if (ne) {
-        free(ne->buf);
+        if (ne->map) {
+            munmap(ne->map, ne->map_len);
+        }
+        source_free(ne->source);
+        free(ne->owned);
+        free(ne->stats);
         free(ne);
     }
 }
 
+/* read the ifd entries into *entries, growing it if it is smaller than *cap. */
+static bool read_ifd(nanoexif * ne, uint32_t offset, uint32_t* next_offset, uint16_t * cnt, nanoexif_ifd_entry ** entries, size_t * cap) {
+    const uint8_t *p = range(ne, offset, 2);
+    if (!p) { return false; }
+    *cnt = read_16(ne->endian, p);
+    p = range(ne, offset+2, sizeof(nanoexif_ifd_entry)*(*cnt)+4);
+    if (!p) { return false; }
+    source_prefetch(ne, p, *cnt);
+    if (*cap < *cnt || !*entries) {
+        nanoexif_ifd_entry * tmp = realloc(*entries, sizeof(nanoexif_ifd_entry)*(*cnt ? *cnt : 1));
+        if (!tmp) { return false; }
+        STAT_ALLOC(ne->stats, sizeof(nanoexif_ifd_entry)*(*cnt ? *cnt : 1));
+        *entries = tmp;
+        *cap = *cnt ? *cnt : 1;
+    }
+    if (ne->endian == NANOEXIF_LITTLE_ENDIAN) {
+        decode_entries_le(p, *cnt, *entries);
+    } else {
+        decode_entries_be(p, *cnt, *entries);
+    }
+    *next_offset = read_32(ne->endian, p+sizeof(nanoexif_ifd_entry)*(*cnt));
+    STAT(ne->stats, ifds_visited, 1);
+    STAT(ne->stats, entries_decoded, *cnt);
+    return true;
+}
+
+/** create the reusable parser context.
+ * @return pointer of struct nanoexif_ctx. return NULL if error occurred.
+ *
+ * You should call nanoexif_ctx_free(ctx) if return value is not null.
+ */
+nanoexif_ctx * nanoexif_ctx_new(void) {
+    return calloc(1, sizeof(nanoexif_ctx));
+}
+
+/** destruct the context, and the buffers kept in it.
+ */
+void nanoexif_ctx_free(nanoexif_ctx * ctx) {
+    if (ctx) {
+        free(ctx->buf);
+        free(ctx->entries);
+        free(ctx->scratch);
+        free(ctx->ne.stats);
+        free(ctx);
+    }
+}
+
+/** parse the next file with the context.
+ * @param nanoexif_ctx * ctx: the context
+ * @param FILE * fp: file pointer for reading exif
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if succeeded, return NULL otherwise.
+ *
+ * The return value is owned by ctx, and valid until the next nanoexif_reset(ctx, ...).
+ * You should not call nanoexif_free() for it.
+ */
+nanoexif * nanoexif_reset(nanoexif_ctx * ctx, FILE *fp, uint32_t *ifd_offset) {
+    ctx->ne.len = 0;
+
+    nanoexif_stats pre;
+    memset(&pre, 0, sizeof(pre));
+    STAT_START(t0);
+    uint16_t len = seek_app1(fp, &pre);
+    STAT_TIME(&pre, ns_scan, t0);
+    if (!len) { return NULL; }
+    STAT_START(t1);
+    if (!parse_app1(fp, len, &ctx->buf, &ctx->buf_cap, &pre)) { return NULL; }
+    STAT_TIME(&pre, ns_load, t1);
+    if (!init_handle(&ctx->ne, ctx->buf, len-8, NULL, ifd_offset)) { return NULL; }
+    STATS_MERGE(&ctx->ne, &pre);
+    return &ctx->ne;
+}
+
+/** read ifd entries into the buffer kept in the context.
+ * @return array of nanoeixf_ifd_entry, valid until the next call. return NULL if error occurred.
+ *
+ * Same as nanoexif_read_ifd(), but you should not free(2) the return value.
+ */
+nanoexif_ifd_entry* nanoexif_ctx_read_ifd(nanoexif_ctx * ctx, uint32_t offset, uint32_t * next_offset, uint16_t * cnt) {
+    STAT_START(t);
+    if (!read_ifd(&ctx->ne, offset, next_offset, cnt, &ctx->entries, &ctx->entries_cap)) {
+        return NULL;
+    }
+    STAT_TIME(ctx->ne.stats, ns_walk, t);
+    return ctx->entries;
+}
+
+/** read the values of ifd entry into the scratch buffer kept in the context.
+ * @param nanoexif_ctx * ctx: the context
+ * @param nanoexif_ifd_entry * entry
+ * @return array of count values in the machine's endian, typed by entry->type(uint16_t for SHORT,
+ * uint32_t pairs for RATIONAL, and so on). ASCII is NUL terminated. return NULL if error occurred.
+ *
+ * The return value is valid until the next call. You should not free(2) it.
+ */
+const void * nanoexif_ctx_get_ifd_entry_data(nanoexif_ctx * ctx, nanoexif_ifd_entry *entry) {
+    nanoexif * ne = &ctx->ne;
+    STAT_START(t);
+    size_t unit = nanoexif_type_size(entry->type);
+    const uint8_t *src = nanoexif_get_ifd_entry_data(ne, entry);
+    if (!src) { return NULL; }
+
+    size_t size = unit*entry->count;
+    if (ctx->scratch_cap < size+1) {
+        uint8_t *tmp = realloc(ctx->scratch, size+1);
+        if (!tmp) { return NULL; }
+        STAT_ALLOC(ne->stats, size+1);
+        ctx->scratch     = tmp;
+        ctx->scratch_cap = size+1;
+    }
+    memcpy(ctx->scratch, src, size);
+    ctx->scratch[size] = '\0';
+
+    if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
+        size_t i;
+        switch (entry->type) {
+        case NANOEXIF_TYPE_SHORT:
+        case NANOEXIF_TYPE_SSHORT:
+            nanoexif_bswap16(ctx->scratch, ctx->scratch, size/2);
+            break;
+        case NANOEXIF_TYPE_LONG:
+        case NANOEXIF_TYPE_SLONG:
+        case NANOEXIF_TYPE_FLOAT:
+        case NANOEXIF_TYPE_RATIONAL:
+        case NANOEXIF_TYPE_SRATIONAL:
+            nanoexif_bswap32(ctx->scratch, ctx->scratch, size/4);
+            break;
+        case NANOEXIF_TYPE_DFLOAT:
+            for (i=0; i<size; i+=8) {
+                uint32_t *p = (uint32_t*)(ctx->scratch+i);
+                uint32_t hi = swap_endian_32(p[0]);
+                p[0] = swap_endian_32(p[1]);
+                p[1] = hi;
+            }
+            break;
+        }
+        if (unit > 1) { STAT(ne->stats, swapped_bytes, size); }
+    }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return ctx->scratch;
+}
+
 /** read ifd entries
  * @param nanoeixf * ne: pointer for struct nanoexif.
- * @param uint16_t offset: offset for the ifd entry
+ * @param uint32_t offset: offset for the ifd entry
  * @param uint32_t *next_offset: offset for the next ifd entry will be set.
  * @param uint16_t * cnt: count of entries will be set.
  * @return array of nanoeixf_ifd_entry.the number of elements will set to argument 'cnt'.return NULL if error occurred.
  * 
  * You should call free(entries), after use it.
  */
-nanoexif_ifd_entry* nanoexif_read_ifd(nanoexif * ne, uint16_t offset, uint32_t* next_offset, uint16_t * cnt) {
-    *cnt = read_16(ne->endian, ne->buf + offset);
-    nanoexif_ifd_entry * entries = malloc(sizeof(nanoexif_ifd_entry)* (*cnt));
-    if (!entries) { return NULL; }
-    memcpy(entries, ne->buf+offset+2, sizeof(nanoexif_ifd_entry)*(*cnt));
-    int i;
-    for (i=0; i<*cnt;i++) {
-        if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
-            entries[i].tag    = swap_endian_16(entries[i].tag);
-            entries[i].type   = swap_endian_16(entries[i].type);
-            entries[i].count  = swap_endian_32(entries[i].count);
-        }
+nanoexif_ifd_entry* nanoexif_read_ifd(nanoexif * ne, uint32_t offset, uint32_t* next_offset, uint16_t * cnt) {
+    STAT_START(t);
+    nanoexif_ifd_entry * entries = NULL;
+    size_t cap = 0;
+    if (!read_ifd(ne, offset, next_offset, cnt, &entries, &cap)) {
+        free(entries);
+        return NULL;
     }
-    uint32_t next_ifd_offset_pos = offset+2+sizeof(nanoexif_ifd_entry)*(*cnt);
-    *next_offset = read_32(ne->endian, ne->buf+next_ifd_offset_pos);
+    STAT_TIME(ne->stats, ns_walk, t);
     return entries;
 }
 
-#define ENTRY_DATA_COPY(x, y, z) memcpy(x, ne->buf+y, z);
+/** get the view of the bytes in exif data.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param uint32_t offset: offset from the tiff header, as stored in ifd entries.
+ * @param uint32_t size: bytes to view.
+ * @return pointer to the bytes. return NULL if the range is out of the exif data.
+ *
+ * The pointer is valid until nanoexif_free(ne). You should not free(2) it.
+ */
+const uint8_t * nanoexif_range(nanoexif *ne, uint32_t offset, uint32_t size) {
+    return range(ne, offset, size);
+}
+
+/* the value bytes of entry: inline in entry->offset if it fits in 4 bytes, or in buf. */
+static inline const uint8_t * entry_data(nanoexif *ne, nanoexif_ifd_entry *entry, size_t unit) {
+    uint64_t size = (uint64_t)unit * entry->count;
+    if (size <= 4) {
+        return entry->offset;
+    }
+    if (size > UINT32_MAX) { return NULL; }
+    return range(ne, read_32(ne->endian, entry->offset), (uint32_t)size);
+}
 
 /** read short value from ifd entry
  * @param nanoeixf * ne: pointer for struct nanoexif.
@@ -223,91 +1176,559 @@ nanoexif_ifd_entry* nanoexif_read_ifd(nanoexif * ne, uint16_t offset, uint32_t*
  * You should free(2) the return value, after used.
  */
 uint16_t *nanoexif_get_ifd_entry_data_short(nanoexif *ne, nanoexif_ifd_entry *entry) {
-    if (entry->count <= 4/sizeof(uint16_t)) {
-        uint16_t *ret = malloc(sizeof(uint16_t)*entry->count);
-        if (!ret) { return NULL; }
-        *ret =read_16(ne->endian, entry->offset);
-        if (entry->count == 2) {
-            *(ret+1) =read_16(ne->endian, entry->offset+2);
-        }
-        return ret;
+    STAT_START(t);
+    const uint8_t *src = entry_data(ne, entry, sizeof(uint16_t));
+    if (!src) { return NULL; }
+    uint16_t * buf = (uint16_t*)malloc(entry->count*sizeof(uint16_t));
+    if (!buf) { return NULL; }
+    STAT_ALLOC(ne->stats, entry->count*sizeof(uint16_t));
+    if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
+        nanoexif_bswap16(buf, src, entry->count);
+        STAT(ne->stats, swapped_bytes, entry->count*sizeof(uint16_t));
     } else {
-        uint32_t offset = read_32(ne->endian, entry->offset);
-        uint16_t * buf = (uint16_t*)malloc(entry->count*sizeof(uint16_t));
-        if (!buf) { return NULL; }
-        ENTRY_DATA_COPY(buf, offset, sizeof(uint16_t)*entry->count);
-        if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
-            uint16_t i;
-            uint16_t* p = buf;
-            for (i=0; i<entry->count; i++) {
-                *p = swap_endian_16(*p);
-                p++;
-            }
-        }
-        return buf;
+        memcpy(buf, src, sizeof(uint16_t)*entry->count);
     }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return buf;
 }
 
 
 /** ditto.
  */
 uint32_t *nanoexif_get_ifd_entry_data_long(nanoexif *ne, nanoexif_ifd_entry *entry) {
-    if (entry->count <= 4/sizeof(uint32_t)) {
-        uint32_t *ret = malloc(sizeof(uint32_t));
-        if (!ret) { return NULL; }
-        *ret = read_32(ne->endian, entry->offset);
-        return ret;
+    STAT_START(t);
+    const uint8_t *src = entry_data(ne, entry, sizeof(uint32_t));
+    if (!src) { return NULL; }
+    uint32_t * buf = (uint32_t*)malloc(entry->count*sizeof(uint32_t));
+    if (!buf) { return NULL; }
+    STAT_ALLOC(ne->stats, entry->count*sizeof(uint32_t));
+    if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
+        nanoexif_bswap32(buf, src, entry->count);
+        STAT(ne->stats, swapped_bytes, entry->count*sizeof(uint32_t));
     } else {
-        uint32_t offset = read_32(ne->endian, entry->offset);
-        uint32_t * buf = (uint32_t*)malloc(entry->count*sizeof(uint32_t));
-        if (!buf) { return NULL; }
-        ENTRY_DATA_COPY(buf, offset, sizeof(uint32_t)*entry->count);
-        if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
-            uint16_t i;
-            uint32_t* p = (uint32_t*)buf;
-            for (i=0; i<entry->count; i++) {
-                *p = swap_endian_32(*p);
-                p++;
-            }
-        }
-        return buf;
+        memcpy(buf, src, sizeof(uint32_t)*entry->count);
     }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return buf;
 }
 
 /** ditto.
  */
 char * nanoexif_get_ifd_entry_data_ascii(nanoexif *ne, nanoexif_ifd_entry *entry) {
-    if (entry->count <= 4) {
-        char *ret = malloc(sizeof(char)*entry->count);
-        if (!ret) { return NULL; }
-        memcpy(ret, entry->offset, entry->count);
-        return ret;
-    } else {
-        uint32_t offset = read_32(ne->endian, entry->offset);
-        char * buf = (char*)malloc(entry->count);
-        if (!buf) { return NULL; }
-        ENTRY_DATA_COPY(buf, offset, entry->count);
-        return buf;
-    }
+    STAT_START(t);
+    const uint8_t *src = entry_data(ne, entry, sizeof(char));
+    if (!src) { return NULL; }
+    char * buf = (char*)malloc(entry->count);
+    if (!buf) { return NULL; }
+    STAT_ALLOC(ne->stats, entry->count);
+    memcpy(buf, src, entry->count);
+    STAT_TIME(ne->stats, ns_decode, t);
+    return buf;
 }
 
 /** ditto.
  */
 uint32_t * nanoexif_get_ifd_entry_data_rational(nanoexif *ne, nanoexif_ifd_entry *entry) {
     /* rational's minimal size is 8 bytes.cannot put on the offset. */
-    uint32_t offset = read_32(ne->endian, entry->offset);
-    char * buf = (char*)malloc(entry->count*sizeof(uint32_t)*2);
+    STAT_START(t);
+    const uint8_t *src = entry_data(ne, entry, sizeof(uint32_t)*2);
+    if (!src) { return NULL; }
+    uint32_t * buf = (uint32_t*)malloc(entry->count*sizeof(uint32_t)*2);
     if (!buf) { return NULL; }
-    ENTRY_DATA_COPY(buf, offset, sizeof(uint32_t)*entry->count);
+    STAT_ALLOC(ne->stats, entry->count*sizeof(uint32_t)*2);
     if (NANOEXIF_MACHINE_ENDIAN != ne->endian) {
-        uint16_t i;
-        uint32_t* p = (uint32_t*)buf;
-        for (i=0; i<entry->count*2; i++) {
-            *p = swap_endian_32(*p);
-            p++;
+        nanoexif_bswap32(buf, src, (size_t)entry->count*2);
+        STAT(ne->stats, swapped_bytes, entry->count*sizeof(uint32_t)*2);
+    } else {
+        memcpy(buf, src, sizeof(uint32_t)*2*entry->count);
+    }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return buf;
+}
+
+/** size of one value of the type.
+ * @param uint16_t type: NANOEXIF_TYPE_*
+ * @return bytes, or 0 for unknown types.
+ */
+size_t nanoexif_type_size(uint16_t type) {
+    switch (type) {
+    case NANOEXIF_TYPE_BYTE:
+    case NANOEXIF_TYPE_ASCII:
+    case NANOEXIF_TYPE_SBYTE:
+    case NANOEXIF_TYPE_UNDEFINED:
+        return 1;
+    case NANOEXIF_TYPE_SHORT:
+    case NANOEXIF_TYPE_SSHORT:
+        return 2;
+    case NANOEXIF_TYPE_LONG:
+    case NANOEXIF_TYPE_SLONG:
+    case NANOEXIF_TYPE_FLOAT:
+        return 4;
+    case NANOEXIF_TYPE_RATIONAL:
+    case NANOEXIF_TYPE_SRATIONAL:
+    case NANOEXIF_TYPE_DFLOAT:
+        return 8;
+    }
+    return 0;
+}
+
+/** get the raw value bytes of ifd entry, without copying.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param nanoexif_ifd_entry * entry
+ * @return pointer to count*nanoexif_type_size(type) bytes in the file's endian. return NULL if error occurred.
+ *
+ * Small values are stored in the entry itself, so the pointer may point into *entry.
+ * You should not free(2) it.
+ */
+const uint8_t * nanoexif_get_ifd_entry_data(nanoexif *ne, nanoexif_ifd_entry *entry) {
+    size_t unit = nanoexif_type_size(entry->type);
+    if (unit == 0) { return NULL; }
+    return entry_data(ne, entry, unit);
+}
+
+/** read i-th BYTE, SHORT or LONG value from ifd entry, without allocation.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param nanoexif_ifd_entry * entry
+ * @param uint32_t i: index of the value
+ * @param uint32_t * value: the value will be set.
+ * @return true if succeeded.
+ */
+bool nanoexif_get_ifd_entry_uint(nanoexif *ne, nanoexif_ifd_entry *entry, uint32_t i, uint32_t *value) {
+    if (i >= entry->count) { return false; }
+    STAT_START(t);
+    const uint8_t *p = nanoexif_get_ifd_entry_data(ne, entry);
+    if (!p) { return false; }
+    bool ok;
+    if (ne->endian == NANOEXIF_LITTLE_ENDIAN) {
+        ok = value_uint_le(entry->type, p, i, value);
+    } else {
+        ok = value_uint_be(entry->type, p, i, value);
+    }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return ok;
+}
+
+/** read i-th numeric value from ifd entry as double, without allocation.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param nanoexif_ifd_entry * entry
+ * @param uint32_t i: index of the value
+ * @param double * value: the value will be set. rationals are divided out.
+ * @return true if succeeded. return false for non numeric types or zero denominators.
+ */
+bool nanoexif_get_ifd_entry_double(nanoexif *ne, nanoexif_ifd_entry *entry, uint32_t i, double *value) {
+    if (i >= entry->count) { return false; }
+    STAT_START(t);
+    const uint8_t *p = nanoexif_get_ifd_entry_data(ne, entry);
+    if (!p) { return false; }
+    bool ok;
+    if (ne->endian == NANOEXIF_LITTLE_ENDIAN) {
+        ok = value_double_le(entry->type, p, i, value);
+    } else {
+        ok = value_double_be(entry->type, p, i, value);
+    }
+    STAT_TIME(ne->stats, ns_decode, t);
+    return ok;
+}
+
+/** start walking every ifd in the exif.
+ * @param nanoexif_walker * w: walker state, usually on the stack.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param uint32_t ifd0_offset: offset bytes for first ifd entry, given by nanoexif_init*()
+ *
+ * The walker visits IFD0, IFD1, then the Exif, GPS and Interop sub ifds in the order they are
+ * referenced. It reads the entries in place and never allocates.
+ */
+void nanoexif_walker_init(nanoexif_walker *w, nanoexif *ne, uint32_t ifd0_offset) {
+    w->ne                = ne;
+    w->kind              = NANOEXIF_IFD_0;
+    w->ifd_offset        = 0;
+    w->count             = 0;
+    w->index             = 0;
+    w->nvisited          = 0;
+    w->npending          = 1;
+    w->pending[0].offset = ifd0_offset;
+    w->pending[0].kind   = NANOEXIF_IFD_0;
+}
+
+static void walker_push(nanoexif_walker *w, uint32_t offset, nanoexif_ifd_kind kind, bool front) {
+    if (offset == 0 || w->npending == NANOEXIF_WALK_MAX_IFDS) { return; }
+    if (front) {
+        memmove(w->pending+1, w->pending, sizeof(w->pending[0])*w->npending);
+        w->pending[0].offset = offset;
+        w->pending[0].kind   = kind;
+    } else {
+        w->pending[w->npending].offset = offset;
+        w->pending[w->npending].kind   = kind;
+    }
+    w->npending++;
+}
+
+static void walker_pop(nanoexif_walker *w) {
+    w->npending--;
+    memmove(w->pending, w->pending+1, sizeof(w->pending[0])*w->npending);
+}
+
+/* pop the next pending ifd, and check its whole directory is in range.
+ * the ifd stays pending on error, so the walk can be resumed once more data is there. */
+static nanoexif_walk_status walker_open(nanoexif_walker *w) {
+    nanoexif *ne = w->ne;
+    while (w->npending) {
+        uint32_t offset = w->pending[0].offset;
+        nanoexif_ifd_kind kind = w->pending[0].kind;
+
+        /* broken files may have loops */
+        int i;
+        bool seen = false;
+        for (i=0; i<w->nvisited; i++) {
+            if (w->visited[i] == offset) { seen = true; }
+        }
+        if (seen || w->nvisited == NANOEXIF_WALK_MAX_IFDS) {
+            D("skip ifd: %u\n", offset);
+            walker_pop(w);
+            continue;
+        }
+
+        const uint8_t *p = range(ne, offset, 2);
+        if (!p) { return NANOEXIF_WALK_ERROR; }
+        uint16_t count = read_16(ne->endian, p);
+        p = range(ne, offset+2, sizeof(nanoexif_ifd_entry)*count+4);
+        if (!p) { return NANOEXIF_WALK_ERROR; }
+        source_prefetch(ne, p, count);
+        STAT(ne->stats, ifds_visited, 1);
+
+        walker_pop(w);
+        w->visited[w->nvisited++] = offset;
+        w->kind       = kind;
+        w->ifd_offset = offset;
+        w->count      = count;
+        w->index      = 0;
+        if (kind == NANOEXIF_IFD_0) {
+            walker_push(w, read_32(ne->endian, p+sizeof(nanoexif_ifd_entry)*count), NANOEXIF_IFD_1, true);
+        }
+        if (count) {
+            return NANOEXIF_WALK_ENTRY;
         }
     }
-    return (uint32_t*)buf;
+    return NANOEXIF_WALK_END;
+}
+
+/** get the next ifd entry.
+ * @param nanoexif_walker * w: walker state.
+ * @param nanoexif_ifd_entry * entry: the entry will be set. w->kind tells which ifd it belongs to.
+ * @return NANOEXIF_WALK_ENTRY if entry was set, NANOEXIF_WALK_END at the end, NANOEXIF_WALK_ERROR if the exif is broken.
+ *
+ * An ifd out of ne->len is an error, but the walk can be resumed from there once ne->len grows.
+ */
+nanoexif_walk_status nanoexif_walker_next(nanoexif_walker *w, nanoexif_ifd_entry *entry) {
+    if (w->index >= w->count) {
+        /* timed per directory, the clock would cost more than an entry */
+        STAT_START(t);
+        nanoexif_walk_status st = walker_open(w);
+        STAT_TIME(w->ne->stats, ns_walk, t);
+        if (st != NANOEXIF_WALK_ENTRY) { return st; }
+    }
+
+    nanoexif *ne = w->ne;
+    /* the whole directory was checked by walker_open() */
+    decode_entry(ne, range(ne, w->ifd_offset + 2 + sizeof(nanoexif_ifd_entry)*w->index++, sizeof(nanoexif_ifd_entry)), entry);
+    STAT(ne->stats, entries_decoded, 1);
+
+    uint32_t sub;
+    if (w->kind == NANOEXIF_IFD_0 && entry->tag == NANOEXIF_TAG_EXIF_OFFSET) {
+        if (nanoexif_get_ifd_entry_uint(ne, entry, 0, &sub)) { walker_push(w, sub, NANOEXIF_IFD_EXIF, false); }
+    } else if (w->kind == NANOEXIF_IFD_0 && entry->tag == NANOEXIF_TAG_GPS_INFO) {
+        if (nanoexif_get_ifd_entry_uint(ne, entry, 0, &sub)) { walker_push(w, sub, NANOEXIF_IFD_GPS, false); }
+    } else if (w->kind == NANOEXIF_IFD_EXIF && entry->tag == NANOEXIF_TAG_INTEROP_OFFSET) {
+        if (nanoexif_get_ifd_entry_uint(ne, entry, 0, &sub)) { walker_push(w, sub, NANOEXIF_IFD_INTEROP, false); }
+    }
+    return NANOEXIF_WALK_ENTRY;
+}
+
+/* find the tag in the ifd. return the offset of the entry, or 0 if not found. */
+static uint32_t ifd_find(nanoexif *ne, uint32_t ifd_offset, uint16_t count, bool sorted, uint16_t tag) {
+    const uint8_t *entries = range(ne, ifd_offset + 2, sizeof(nanoexif_ifd_entry)*count);
+    int i = ne->endian == NANOEXIF_LITTLE_ENDIAN
+        ? find_entry_le(entries, count, sorted, tag)
+        : find_entry_be(entries, count, sorted, tag);
+    if (i < 0) { return 0; }
+    return ifd_offset + 2 + sizeof(nanoexif_ifd_entry)*i;
+}
+
+/* check the whole directory is in range, and return the count of entries and whether they are sorted by tag. */
+static bool ifd_open(nanoexif *ne, uint32_t ifd_offset, uint16_t *count, bool *sorted) {
+    const uint8_t *p = range(ne, ifd_offset, 2);
+    if (!p) { return false; }
+    *count = read_16(ne->endian, p);
+    STAT(ne->stats, ifds_visited, 1);
+    p = range(ne, ifd_offset+2, sizeof(nanoexif_ifd_entry)*(*count)+4);
+    if (!p) { return false; }
+    *sorted = ne->endian == NANOEXIF_LITTLE_ENDIAN ? entries_sorted_le(p, *count) : entries_sorted_be(p, *count);
+    return true;
+}
+
+/* look up the keys for the ifd. return the number of keys found. */
+static size_t ifd_query(nanoexif *ne, uint32_t ifd_offset, uint16_t count, bool sorted, nanoexif_ifd_kind kind, const nanoexif_tag_key * keys, size_t n, nanoexif_query_result * results) {
+    size_t found = 0;
+    size_t i;
+    for (i=0; i<n; i++) {
+        if (keys[i].ifd != kind || results[i].found) { continue; }
+        uint32_t offset = ifd_find(ne, ifd_offset, count, sorted, keys[i].tag);
+        if (offset) {
+            results[i].found  = true;
+            results[i].offset = offset;
+            decode_entry(ne, range(ne, offset, sizeof(nanoexif_ifd_entry)), &results[i].entry);
+            STAT(ne->stats, entries_decoded, 1);
+            found++;
+        }
+    }
+    return found;
+}
+
+/* read the sub ifd pointer in the ifd. return 0 if not found. */
+static uint32_t ifd_pointer(nanoexif *ne, uint32_t ifd_offset, uint16_t count, bool sorted, uint16_t tag) {
+    uint32_t offset = ifd_find(ne, ifd_offset, count, sorted, tag);
+    if (!offset) { return 0; }
+    nanoexif_ifd_entry entry;
+    decode_entry(ne, range(ne, offset, sizeof(nanoexif_ifd_entry)), &entry);
+    uint32_t sub;
+    return nanoexif_get_ifd_entry_uint(ne, &entry, 0, &sub) ? sub : 0;
+}
+
+/** look up the tags.
+ * @param nanoeixf * ne: pointer for struct nanoexif.
+ * @param uint32_t ifd0_offset: offset bytes for first ifd entry, given by nanoexif_init*()
+ * @param const nanoexif_tag_key * keys: the tags to find
+ * @param size_t n: number of keys
+ * @param nanoexif_query_result * results: n results will be set. results[i] is for keys[i].
+ * @return number of keys found.
+ *
+ * Only the ifds which can contain the keys are read; IFD0 only keys never touch the Exif and GPS ifds.
+ * It stops as soon as every key is found, and never allocates.
+ */
+size_t nanoexif_query(nanoexif * ne, uint32_t ifd0_offset, const nanoexif_tag_key * keys, size_t n, nanoexif_query_result * results) {
+    bool want[NANOEXIF_IFD_INTEROP+1] = { false, false, false, false, false };
+    size_t i;
+    for (i=0; i<n; i++) {
+        results[i].found = false;
+        if ((unsigned)keys[i].ifd <= NANOEXIF_IFD_INTEROP) {
+            want[keys[i].ifd] = true;
+        }
+    }
+
+    STAT_START(t);
+    size_t found = 0;
+    uint16_t count;
+    bool sorted;
+    if (n == 0 || !ifd_open(ne, ifd0_offset, &count, &sorted)) { return 0; }
+    found += ifd_query(ne, ifd0_offset, count, sorted, NANOEXIF_IFD_0, keys, n, results);
+
+    uint32_t ifd1_offset    = read_32(ne->endian, range(ne, ifd0_offset + 2 + sizeof(nanoexif_ifd_entry)*count, 4));
+    uint32_t exif_offset    = want[NANOEXIF_IFD_EXIF] || want[NANOEXIF_IFD_INTEROP] ? ifd_pointer(ne, ifd0_offset, count, sorted, NANOEXIF_TAG_EXIF_OFFSET) : 0;
+    uint32_t gps_offset     = want[NANOEXIF_IFD_GPS] ? ifd_pointer(ne, ifd0_offset, count, sorted, NANOEXIF_TAG_GPS_INFO) : 0;
+    uint32_t interop_offset = 0;
+
+    if (found < n && want[NANOEXIF_IFD_1] && ifd1_offset && ifd_open(ne, ifd1_offset, &count, &sorted)) {
+        found += ifd_query(ne, ifd1_offset, count, sorted, NANOEXIF_IFD_1, keys, n, results);
+    }
+    if (found < n && exif_offset && ifd_open(ne, exif_offset, &count, &sorted)) {
+        found += ifd_query(ne, exif_offset, count, sorted, NANOEXIF_IFD_EXIF, keys, n, results);
+        if (want[NANOEXIF_IFD_INTEROP]) {
+            interop_offset = ifd_pointer(ne, exif_offset, count, sorted, NANOEXIF_TAG_INTEROP_OFFSET);
+        }
+    }
+    if (found < n && gps_offset && ifd_open(ne, gps_offset, &count, &sorted)) {
+        found += ifd_query(ne, gps_offset, count, sorted, NANOEXIF_IFD_GPS, keys, n, results);
+    }
+    if (found < n && interop_offset && ifd_open(ne, interop_offset, &count, &sorted)) {
+        found += ifd_query(ne, interop_offset, count, sorted, NANOEXIF_IFD_INTEROP, keys, n, results);
+    }
+    STAT_TIME(ne->stats, ns_walk, t);
+    return found;
+}
+
+/** create the push parser.
+ * @param nanoexif_entry_cb cb: called for each ifd entry. may be NULL.
+ * @param void * ud: passed to cb.
+ * @return pointer of struct nanoexif_parser. return NULL if error occurred.
+ *
+ * You should call nanoexif_parser_free(p) if return value is not null.
+ */
+nanoexif_parser * nanoexif_parser_new(nanoexif_entry_cb cb, void * ud) {
+    nanoexif_parser * p = calloc(1, sizeof(nanoexif_parser));
+    if (!p) { return NULL; }
+    p->cb = cb;
+    p->ud = ud;
+    nanoexif_parser_reset(p);
+    return p;
+}
+
+/** destruct the push parser.
+ */
+void nanoexif_parser_free(nanoexif_parser * p) {
+    if (p) {
+        free(p->buf);
+        free(p->ne.stats);
+        free(p);
+    }
+}
+
+/** start parsing the next stream, keeping the APP1 buffer.
+ */
+void nanoexif_parser_reset(nanoexif_parser * p) {
+    p->state    = NANOEXIF_PARSER_SOI;
+    p->head_len = 0;
+    p->skip     = 0;
+    p->need     = 0;
+    p->walking  = false;
+    p->ne.len   = 0;
+}
+
+/* collect n bytes into p->head. return true if all of them are there. */
+static inline bool parser_head(nanoexif_parser * p, const uint8_t * chunk, size_t len, size_t * pos, size_t n) {
+    while (p->head_len < n && *pos < len) {
+        p->head[p->head_len++] = chunk[(*pos)++];
+    }
+    return p->head_len == n;
+}
+
+/* report the entries which are already in the buffer. */
+static void parser_walk(nanoexif_parser * p) {
+    nanoexif_ifd_entry entry;
+    while (p->walking) {
+        nanoexif_walk_status st = nanoexif_walker_next(&p->walker, &entry);
+        if (st == NANOEXIF_WALK_ENTRY) {
+            if (p->cb) { p->cb(&p->ne, p->walker.kind, &entry, p->ud); }
+        } else if (st == NANOEXIF_WALK_END || p->ne.len == p->need) {
+            p->walking = false; /* finished, or the rest is broken */
+        } else {
+            return; /* wait for more bytes */
+        }
+    }
+}
+
+/** feed the next chunk of the jpeg stream.
+ * @param nanoexif_parser * p: the parser
+ * @param const uint8_t * chunk: bytes of the stream
+ * @param size_t len: bytes of chunk
+ * @return NANOEXIF_FEED_DONE once APP1 is complete, NANOEXIF_FEED_MORE if more bytes are needed,
+ * NANOEXIF_FEED_ERROR if the stream is not a jpeg or has no exif.
+ *
+ * The bytes after APP1 are not needed; you may stop feeding at NANOEXIF_FEED_DONE.
+ */
+nanoexif_feed_status nanoexif_feed(nanoexif_parser * p, const uint8_t * chunk, size_t len) {
+    size_t pos = 0;
+    while (pos < len && p->state < NANOEXIF_PARSER_DONE) {
+        switch (p->state) {
+        case NANOEXIF_PARSER_SOI:
+            if (parser_head(p, chunk, len, &pos, 2)) {
+                if (p->head[0] != 0xFF || p->head[1] != 0xD8) {
+                    D("err, not soi");
+                    p->state = NANOEXIF_PARSER_ERROR;
+                    break;
+                }
+                p->head_len = 0;
+                p->state    = NANOEXIF_PARSER_MARKER;
+            }
+            break;
+        case NANOEXIF_PARSER_MARKER:
+            if (parser_head(p, chunk, len, &pos, 4)) {
+                /* marker length is always big endian */
+                uint16_t seg_len = read_16(NANOEXIF_BIG_ENDIAN, p->head+2);
+                p->head_len = 0;
+                if (p->head[0] != 0xFF || seg_len < 2) {
+                    D("invalid marker\n");
+                    p->state = NANOEXIF_PARSER_ERROR;
+                } else if (p->head[1] == 0xDA) { // SOS
+                    p->state = NANOEXIF_PARSER_ERROR; /* missing exif */
+                } else if (p->head[1] == 0xE1 && seg_len >= 8 + 8) { // APP1
+                    D("app1 header : %d\n", seg_len);
+                    p->need  = seg_len - 8;
+                    p->state = NANOEXIF_PARSER_EXIF_HEADER;
+                } else {
+                    p->skip  = seg_len - 2;
+                    p->state = NANOEXIF_PARSER_SKIP;
+                }
+            }
+            break;
+        case NANOEXIF_PARSER_SKIP:
+            {
+                size_t n = len - pos < p->skip ? len - pos : p->skip;
+                pos     += n;
+                p->skip -= n;
+                if (!p->skip) { p->state = NANOEXIF_PARSER_MARKER; }
+            }
+            break;
+        case NANOEXIF_PARSER_EXIF_HEADER:
+            if (parser_head(p, chunk, len, &pos, 6)) {
+                p->head_len = 0;
+                if (memcmp(p->head, EXIF_HEADER, 6) != 0) {
+                    /* XMP and friends also live in APP1 */
+                    D("EXIFHEADER\n");
+                    p->skip  = p->need;
+                    p->state = NANOEXIF_PARSER_SKIP;
+                    break;
+                }
+                if (p->buf_cap < p->need) {
+                    uint8_t *tmp = realloc(p->buf, p->need);
+                    if (!tmp) {
+                        p->state = NANOEXIF_PARSER_ERROR;
+                        break;
+                    }
+                    p->buf     = tmp;
+                    p->buf_cap = p->need;
+                }
+                p->ne.len = 0;
+                p->state  = NANOEXIF_PARSER_APP1;
+            }
+            break;
+        case NANOEXIF_PARSER_APP1:
+            {
+                size_t have = p->ne.len;
+                size_t n = len - pos < p->need - have ? len - pos : p->need - have;
+                memcpy(p->buf + have, chunk + pos, n);
+                pos += n;
+                if (!p->walking && have < 8 && have + n >= 8) {
+                    if (!init_handle(&p->ne, p->buf, have + n, NULL, &p->ifd0_offset)) {
+                        p->state = NANOEXIF_PARSER_ERROR;
+                        break;
+                    }
+                    nanoexif_walker_init(&p->walker, &p->ne, p->ifd0_offset);
+                    p->walking = true;
+                }
+                p->ne.len = have + n;
+                if (p->ne.len == p->need) {
+                    p->state = NANOEXIF_PARSER_DONE;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    parser_walk(p);
+
+    switch (p->state) {
+    case NANOEXIF_PARSER_DONE:
+        return NANOEXIF_FEED_DONE;
+    case NANOEXIF_PARSER_ERROR:
+        return NANOEXIF_FEED_ERROR;
+    default:
+        return NANOEXIF_FEED_MORE;
+    }
+}
+
+/** get the exif parsed by the push parser.
+ * @param nanoexif_parser * p: the parser
+ * @param uint32_t *ifd_offset: offset bytes for first ifd entry.
+ * @return pointer of struct nanoexif if nanoexif_feed() returned NANOEXIF_FEED_DONE, return NULL otherwise.
+ *
+ * The return value is owned by p, and valid until nanoexif_parser_reset(p) or nanoexif_parser_free(p).
+ */
+nanoexif * nanoexif_parser_exif(nanoexif_parser * p, uint32_t * ifd_offset) {
+    if (p->state != NANOEXIF_PARSER_DONE) { return NULL; }
+    *ifd_offset = p->ifd0_offset;
+    return &p->ne;
 }
 
 /**
@@ -40,6 +40,19 @@ typedef enum {
     NANOEXIF_BIG_ENDIAN,
 } nanoexif_endian;
 
+/* the machine's endian. detected from the compiler unless it is given with -D. */
+#ifndef NANOEXIF_MACHINE_ENDIAN
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define NANOEXIF_MACHINE_ENDIAN NANOEXIF_BIG_ENDIAN
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define NANOEXIF_MACHINE_ENDIAN NANOEXIF_LITTLE_ENDIAN
+#elif defined(_WIN32) || defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define NANOEXIF_MACHINE_ENDIAN NANOEXIF_LITTLE_ENDIAN
+#else
+#error "cannot detect the machine's endian. define NANOEXIF_MACHINE_ENDIAN to NANOEXIF_LITTLE_ENDIAN or NANOEXIF_BIG_ENDIAN"
+#endif
+#endif
+
 /**
  * struct nanoexif_ifd_entry describe the IFD entry.
  */
@@ -50,22 +63,70 @@ typedef struct {
     uint8_t  offset[4];
 } nanoexif_ifd_entry;
 
+/**
+ * struct nanoexif_stats counts what parsing costs. Built with -DNANOEXIF_STATS, the library keeps one for each handle
+ * and one for the process. Otherwise the counting is compiled out, and nanoexif_handle_stats() and
+ * nanoexif_process_stats() return false.
+ */
+typedef struct {
+    uint64_t bytes_read;
+    uint64_t reads;           /* fread, read(2), pread(2) or read_at calls */
+    uint64_t seeks;           /* fseek calls */
+    uint64_t markers_skipped; /* jpeg segments passed over to find APP1 */
+    uint64_t ifds_visited;
+    uint64_t entries_decoded;
+    uint64_t allocs;          /* made by the library, including the buffers returned to the caller */
+    uint64_t alloc_bytes;
+    uint64_t swapped_bytes;   /* converted from the file's endian by the getters */
+    uint64_t ns_scan;         /* finding APP1 in the segments */
+    uint64_t ns_load;         /* reading APP1, or the head of the tiff */
+    uint64_t ns_walk;         /* reading ifds */
+    uint64_t ns_decode;       /* reading values with the getters */
+} nanoexif_stats;
+
 /**
  * struct nanoexif describe the exif(means APP1 segment).
  */
 typedef struct {
     nanoexif_endian endian;
-    uint8_t * buf;
+    const uint8_t * buf;
     size_t offset;
+    size_t len;
+    uint8_t * owned; /* heap buffer released by nanoexif_free(), NULL if buf is borrowed */
+    void * map;      /* mapping released by nanoexif_free(), NULL if not mapped */
+    size_t map_len;
+    struct nanoexif_source * source; /* reads the bytes past len on demand, NULL if buf is the whole data */
+    nanoexif_stats * stats;          /* the counters of this handle with NANOEXIF_STATS, NULL otherwise */
 } nanoexif;
 
 #define NANOEXIF_TAG_COMPRESSION        0x0103
 #define NANOEXIF_TAG_MAKE               0x010f
+#define NANOEXIF_TAG_MODEL              0x0110
 #define NANOEXIF_TAG_ORIENTATION        0x0112
+#define NANOEXIF_TAG_SOFTWARE           0x0131
 #define NANOEXIF_TAG_JPEG_IF_OFFSET     0x0201
 #define NANOEXIF_TAG_JPEG_IF_BYTE_COUNT 0x0202
 #define NANOEXIF_TAG_EXIF_OFFSET        0x8769
 #define NANOEXIF_TAG_GPS_INFO           0x8825
+#define NANOEXIF_TAG_INTEROP_OFFSET     0xa005
+
+/* in the Exif ifd */
+#define NANOEXIF_TAG_EXPOSURE_TIME      0x829a
+#define NANOEXIF_TAG_F_NUMBER           0x829d
+#define NANOEXIF_TAG_ISO                0x8827
+#define NANOEXIF_TAG_DATETIME_ORIGINAL  0x9003
+#define NANOEXIF_TAG_FLASH              0x9209
+#define NANOEXIF_TAG_FOCAL_LENGTH       0x920a
+#define NANOEXIF_TAG_EXIF_IMAGE_WIDTH   0xa002
+#define NANOEXIF_TAG_EXIF_IMAGE_HEIGHT  0xa003
+
+/* in the GPS ifd */
+#define NANOEXIF_TAG_GPS_LATITUDE_REF   0x0001
+#define NANOEXIF_TAG_GPS_LATITUDE       0x0002
+#define NANOEXIF_TAG_GPS_LONGITUDE_REF  0x0003
+#define NANOEXIF_TAG_GPS_LONGITUDE      0x0004
+#define NANOEXIF_TAG_GPS_ALTITUDE_REF   0x0005
+#define NANOEXIF_TAG_GPS_ALTITUDE       0x0006
 
 #define NANOEXIF_TYPE_BYTE      0x0001
 #define NANOEXIF_TYPE_ASCII     0x0002
@@ -80,16 +141,179 @@ typedef struct {
 #define NANOEXIF_TYPE_FLOAT     0x000b
 #define NANOEXIF_TYPE_DFLOAT    0x000c
 
+/**
+ * enum nanoexif_ifd_kind describe which ifd the entry belongs to.
+ */
+typedef enum {
+    NANOEXIF_IFD_0,
+    NANOEXIF_IFD_1,
+    NANOEXIF_IFD_EXIF,
+    NANOEXIF_IFD_GPS,
+    NANOEXIF_IFD_INTEROP,
+} nanoexif_ifd_kind;
+
+/**
+ * struct nanoexif_ctx is the reusable parser context. Its buffers are kept across
+ * files and grow to the largest one seen, so parsing in a loop does not allocate.
+ */
+typedef struct {
+    nanoexif ne;
+    uint8_t * buf;
+    size_t buf_cap;
+    nanoexif_ifd_entry * entries;
+    size_t entries_cap;
+    uint8_t * scratch;
+    size_t scratch_cap;
+} nanoexif_ctx;
+
+/**
+ * struct nanoexif_read_stats reports the I/O done by nanoexif_init_fd() and nanoexif_reset_fd().
+ */
+typedef struct {
+    unsigned syscalls; /* pread(2) calls, or read_at calls for nanoexif_io */
+    size_t bytes;
+} nanoexif_read_stats;
+
+/**
+ * struct nanoexif_io reads the file through a callback, for files which are not local(an object store with range reads, ...).
+ * read_at reads len bytes at offset into buf. It returns the bytes read, which is less than len only at the end of
+ * the file, or -1 on error. Each call is a round trip for remote files, so nanoexif asks for few and large ranges.
+ */
+typedef struct {
+    int64_t (*read_at)(void * ctx, uint64_t offset, size_t len, uint8_t * buf);
+    void * ctx;
+} nanoexif_io;
+
+/* bytes of the first read in nanoexif_init_fd(). */
+#define NANOEXIF_PREFIX_SIZE (64*1024)
+
+#define NANOEXIF_WALK_MAX_IFDS 8
+
+/**
+ * struct nanoexif_walker is the state of nanoexif_walker_next(). It lives on the caller's stack.
+ */
+typedef struct {
+    nanoexif * ne;
+    nanoexif_ifd_kind kind; /* the ifd being walked */
+    uint32_t ifd_offset;
+    uint16_t count;
+    uint16_t index;
+    uint8_t npending;
+    uint8_t nvisited;
+    struct {
+        uint32_t offset;
+        nanoexif_ifd_kind kind;
+    } pending[NANOEXIF_WALK_MAX_IFDS];
+    uint32_t visited[NANOEXIF_WALK_MAX_IFDS];
+} nanoexif_walker;
+
+typedef enum {
+    NANOEXIF_WALK_ERROR = -1,
+    NANOEXIF_WALK_END   = 0,
+    NANOEXIF_WALK_ENTRY = 1,
+} nanoexif_walk_status;
+
+/**
+ * struct nanoexif_tag_key names a tag. GPS tags share their numbers with IFD0 tags, so the ifd is part of the key.
+ */
+typedef struct {
+    nanoexif_ifd_kind ifd;
+    uint16_t tag;
+} nanoexif_tag_key;
+
+/**
+ * struct nanoexif_query_result is the result of nanoexif_query() for one key.
+ */
+typedef struct {
+    bool found;
+    uint32_t offset; /* where the entry is, from the tiff header */
+    nanoexif_ifd_entry entry;
+} nanoexif_query_result;
+
+typedef enum {
+    NANOEXIF_FEED_ERROR = -1,
+    NANOEXIF_FEED_MORE  = 0,
+    NANOEXIF_FEED_DONE  = 1,
+} nanoexif_feed_status;
+
+typedef enum {
+    NANOEXIF_PARSER_SOI,
+    NANOEXIF_PARSER_MARKER,
+    NANOEXIF_PARSER_SKIP,
+    NANOEXIF_PARSER_EXIF_HEADER,
+    NANOEXIF_PARSER_APP1,
+    NANOEXIF_PARSER_DONE,
+    NANOEXIF_PARSER_ERROR,
+} nanoexif_parser_state;
+
+/**
+ * callback for nanoexif_feed(). it is called for each ifd entry as soon as the entry's bytes arrived.
+ * values stored out of the entry may not have arrived yet; the getters return NULL for them until then.
+ */
+typedef void (*nanoexif_entry_cb)(nanoexif * ne, nanoexif_ifd_kind kind, nanoexif_ifd_entry * entry, void * ud);
+
+/**
+ * struct nanoexif_parser is the push parser state. Only APP1 is buffered(at most 64KB);
+ * other segments are skipped as they stream by.
+ */
+typedef struct {
+    nanoexif_parser_state state;
+    uint8_t head[6];
+    size_t head_len;
+    size_t skip;
+    uint8_t * buf;
+    size_t buf_cap;
+    size_t need;
+    nanoexif ne;
+    uint32_t ifd0_offset;
+    bool walking;
+    nanoexif_walker walker;
+    nanoexif_entry_cb cb;
+    void * ud;
+} nanoexif_parser;
+
 #define NANOEXIF_EXIF_HEADER_SIZE (2+2+2+6+2+2+4)
 
 nanoexif * nanoexif_init(FILE *fp, uint32_t *ifd_offset);
+nanoexif * nanoexif_init_from_memory(const uint8_t *data, size_t len, uint32_t *ifd_offset);
+nanoexif * nanoexif_init_mmap(int fd, uint32_t *ifd_offset);
+nanoexif * nanoexif_init_fd(int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats);
+nanoexif * nanoexif_init_tiff(const uint8_t *data, size_t len, uint32_t *ifd_offset);
+nanoexif * nanoexif_init_tiff_fd(int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats);
+nanoexif * nanoexif_init_io(const nanoexif_io *io, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats);
+void nanoexif_io_stats(const nanoexif *ne, nanoexif_read_stats *stats);
+bool nanoexif_handle_stats(const nanoexif *ne, nanoexif_stats *stats);
+bool nanoexif_process_stats(nanoexif_stats *stats);
+void nanoexif_process_stats_reset(void);
+nanoexif * nanoexif_reset_fd(nanoexif_ctx * ctx, int fd, size_t prefix, uint32_t *ifd_offset, nanoexif_read_stats *stats);
+size_t nanoexif_exif_extent(const uint8_t *data, size_t len);
 void nanoexif_free(nanoexif * ne);
-nanoexif_ifd_entry* nanoexif_read_ifd(nanoexif * ne, uint16_t offset, uint32_t * next, uint16_t * cnt);
+nanoexif_ctx * nanoexif_ctx_new(void);
+void nanoexif_ctx_free(nanoexif_ctx * ctx);
+nanoexif * nanoexif_reset(nanoexif_ctx * ctx, FILE *fp, uint32_t *ifd_offset);
+nanoexif_ifd_entry* nanoexif_ctx_read_ifd(nanoexif_ctx * ctx, uint32_t offset, uint32_t * next, uint16_t * cnt);
+const void * nanoexif_ctx_get_ifd_entry_data(nanoexif_ctx * ctx, nanoexif_ifd_entry *entry);
+nanoexif_ifd_entry* nanoexif_read_ifd(nanoexif * ne, uint32_t offset, uint32_t * next, uint16_t * cnt);
 uint16_t *nanoexif_get_ifd_entry_data_short(nanoexif *ne, nanoexif_ifd_entry *entry);
 char * nanoexif_get_ifd_entry_data_ascii(nanoexif *ne, nanoexif_ifd_entry *entry);
 uint32_t * nanoexif_get_ifd_entry_data_rational(nanoexif *ne, nanoexif_ifd_entry *entry);
 uint32_t * nanoexif_get_ifd_entry_data_long(nanoexif *ne, nanoexif_ifd_entry *entry);
+const uint8_t * nanoexif_range(nanoexif *ne, uint32_t offset, uint32_t size);
+size_t nanoexif_type_size(uint16_t type);
+const uint8_t * nanoexif_get_ifd_entry_data(nanoexif *ne, nanoexif_ifd_entry *entry);
+bool nanoexif_get_ifd_entry_uint(nanoexif *ne, nanoexif_ifd_entry *entry, uint32_t i, uint32_t *value);
+bool nanoexif_get_ifd_entry_double(nanoexif *ne, nanoexif_ifd_entry *entry, uint32_t i, double *value);
+nanoexif_parser * nanoexif_parser_new(nanoexif_entry_cb cb, void * ud);
+void nanoexif_parser_free(nanoexif_parser * p);
+void nanoexif_parser_reset(nanoexif_parser * p);
+nanoexif_feed_status nanoexif_feed(nanoexif_parser * p, const uint8_t * chunk, size_t len);
+nanoexif * nanoexif_parser_exif(nanoexif_parser * p, uint32_t * ifd_offset);
+size_t nanoexif_query(nanoexif * ne, uint32_t ifd0_offset, const nanoexif_tag_key * keys, size_t n, nanoexif_query_result * results);
+void nanoexif_walker_init(nanoexif_walker *w, nanoexif *ne, uint32_t ifd0_offset);
+nanoexif_walk_status nanoexif_walker_next(nanoexif_walker *w, nanoexif_ifd_entry *entry);
 const char *nanoexif_tag_name(uint32_t n);
+const char *nanoexif_ifd_tag_name(nanoexif_ifd_kind kind, uint16_t tag);
+bool nanoexif_tag_by_name(const char *name, nanoexif_tag_key *key);
 
 #ifdef __cplusplus
 }
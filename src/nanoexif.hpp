@@ -0,0 +1,601 @@
+#ifndef NANOEXIF_HPP__
+#define NANOEXIF_HPP__
+
+/**
+ * @file nanoexif.hpp
+ *
+ * C++17 layer over nanoexif.h. It is header only, and every member is an inline call of the C api.
+ * Values are views into the exif data of the handle, valid until the handle is destroyed;
+ * reading a tag never allocates. Errors come back in nanoexifpp::Result, not as exceptions.
+ *
+ *     auto exif = nanoexifpp::Exif::open(fp);
+ *     if (!exif) { ... exif.error() ... }
+ *     for (const nanoexifpp::Entry & e : exif->entries()) {
+ *         if (auto s = exif->ascii(e)) { ... *s is a std::string_view ... }
+ *     }
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <nanoexif.h>
+
+namespace nanoexifpp {
+
+/**
+ * why a call failed.
+ */
+enum class Errc {
+    ok = 0,
+    no_exif,       /* the file has no exif, or it is broken */
+    not_found,     /* the tag is not in the exif */
+    type_mismatch, /* the entry is not of the type asked for */
+    out_of_range,  /* the value is out of the exif data, or the index is out of count */
+};
+
+inline const char * message(Errc e) noexcept {
+    switch (e) {
+    case Errc::ok:            return "ok";
+    case Errc::no_exif:       return "no exif";
+    case Errc::not_found:     return "not found";
+    case Errc::type_mismatch: return "type mismatch";
+    case Errc::out_of_range:  return "out of range";
+    }
+    return "unknown";
+}
+
+/**
+ * a value or the error, like std::expected. T should be cheap to default construct.
+ */
+template <class T>
+class Result {
+public:
+    Result(T value) noexcept : value_(std::move(value)), err_(Errc::ok) {}
+    Result(Errc err) noexcept : value_(), err_(err) {}
+
+    bool has_value() const noexcept { return err_ == Errc::ok; }
+    explicit operator bool() const noexcept { return has_value(); }
+    Errc error() const noexcept { return err_; }
+
+    /* undefined unless has_value() */
+    T & value() & noexcept { return value_; }
+    const T & value() const & noexcept { return value_; }
+    T && value() && noexcept { return std::move(value_); }
+    T & operator*() & noexcept { return value_; }
+    const T & operator*() const & noexcept { return value_; }
+    T && operator*() && noexcept { return std::move(value_); }
+    T * operator->() noexcept { return &value_; }
+    const T * operator->() const noexcept { return &value_; }
+
+    template <class U>
+    T value_or(U && other) const & { return has_value() ? value_ : static_cast<T>(std::forward<U>(other)); }
+
+private:
+    T value_;
+    Errc err_;
+};
+
+/**
+ * RATIONAL and SRATIONAL values.
+ */
+struct Rational {
+    uint32_t num;
+    uint32_t den;
+    double to_double() const noexcept { return den ? static_cast<double>(num) / den : 0.0; }
+};
+
+struct SRational {
+    int32_t num;
+    int32_t den;
+    double to_double() const noexcept { return den ? static_cast<double>(num) / den : 0.0; }
+};
+
+namespace detail {
+
+/* compilers turn these into a plain load, with a bswap for the other endian. */
+inline uint16_t load16(const uint8_t * p, nanoexif_endian e) noexcept {
+    return e == NANOEXIF_LITTLE_ENDIAN
+        ? static_cast<uint16_t>(p[0] | (p[1] << 8))
+        : static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+inline uint32_t load32(const uint8_t * p, nanoexif_endian e) noexcept {
+    return e == NANOEXIF_LITTLE_ENDIAN
+        ? (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24)
+        : ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+inline uint64_t load64(const uint8_t * p, nanoexif_endian e) noexcept {
+    uint64_t a = load32(p, e), b = load32(p+4, e);
+    return e == NANOEXIF_LITTLE_ENDIAN ? (b << 32) | a : (a << 32) | b;
+}
+
+/* how T is stored: the exif type and the bytes of one value. */
+template <class T> struct Traits;
+template <> struct Traits<uint8_t> {
+    static constexpr size_t size = 1;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_BYTE || t == NANOEXIF_TYPE_UNDEFINED; }
+    static uint8_t load(const uint8_t * p, nanoexif_endian) noexcept { return *p; }
+};
+template <> struct Traits<int8_t> {
+    static constexpr size_t size = 1;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_SBYTE; }
+    static int8_t load(const uint8_t * p, nanoexif_endian) noexcept { return static_cast<int8_t>(*p); }
+};
+template <> struct Traits<uint16_t> {
+    static constexpr size_t size = 2;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_SHORT; }
+    static uint16_t load(const uint8_t * p, nanoexif_endian e) noexcept { return load16(p, e); }
+};
+template <> struct Traits<int16_t> {
+    static constexpr size_t size = 2;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_SSHORT; }
+    static int16_t load(const uint8_t * p, nanoexif_endian e) noexcept { return static_cast<int16_t>(load16(p, e)); }
+};
+template <> struct Traits<uint32_t> {
+    static constexpr size_t size = 4;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_LONG; }
+    static uint32_t load(const uint8_t * p, nanoexif_endian e) noexcept { return load32(p, e); }
+};
+template <> struct Traits<int32_t> {
+    static constexpr size_t size = 4;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_SLONG; }
+    static int32_t load(const uint8_t * p, nanoexif_endian e) noexcept { return static_cast<int32_t>(load32(p, e)); }
+};
+template <> struct Traits<Rational> {
+    static constexpr size_t size = 8;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_RATIONAL; }
+    static Rational load(const uint8_t * p, nanoexif_endian e) noexcept { return Rational{ load32(p, e), load32(p+4, e) }; }
+};
+template <> struct Traits<SRational> {
+    static constexpr size_t size = 8;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_SRATIONAL; }
+    static SRational load(const uint8_t * p, nanoexif_endian e) noexcept {
+        return SRational{ static_cast<int32_t>(load32(p, e)), static_cast<int32_t>(load32(p+4, e)) };
+    }
+};
+template <> struct Traits<float> {
+    static constexpr size_t size = 4;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_FLOAT; }
+    static float load(const uint8_t * p, nanoexif_endian e) noexcept {
+        uint32_t u = load32(p, e);
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+};
+template <> struct Traits<double> {
+    static constexpr size_t size = 8;
+    static bool accepts(uint16_t t) noexcept { return t == NANOEXIF_TYPE_DFLOAT; }
+    static double load(const uint8_t * p, nanoexif_endian e) noexcept {
+        uint64_t u = load64(p, e);
+        double d;
+        std::memcpy(&d, &u, sizeof(d));
+        return d;
+    }
+};
+
+} // namespace detail
+
+/**
+ * count values of T in the file's endian, decoded as they are read. It points into the exif data,
+ * or into the Entry for values of 4 bytes or less when the Entry does not know where it is.
+ */
+template <class T>
+class Values {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = T;
+
+        iterator() noexcept : p_(nullptr), e_(NANOEXIF_MACHINE_ENDIAN) {}
+        iterator(const uint8_t * p, nanoexif_endian e) noexcept : p_(p), e_(e) {}
+        T operator*() const noexcept { return detail::Traits<T>::load(p_, e_); }
+        T operator[](difference_type n) const noexcept { return detail::Traits<T>::load(p_ + n*(difference_type)detail::Traits<T>::size, e_); }
+        iterator & operator++() noexcept { p_ += detail::Traits<T>::size; return *this; }
+        iterator operator++(int) noexcept { iterator tmp = *this; ++*this; return tmp; }
+        iterator & operator--() noexcept { p_ -= detail::Traits<T>::size; return *this; }
+        iterator operator--(int) noexcept { iterator tmp = *this; --*this; return tmp; }
+        iterator & operator+=(difference_type n) noexcept { p_ += n*(difference_type)detail::Traits<T>::size; return *this; }
+        iterator & operator-=(difference_type n) noexcept { p_ -= n*(difference_type)detail::Traits<T>::size; return *this; }
+        friend iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const iterator & a, const iterator & b) noexcept {
+            return (a.p_ - b.p_) / (difference_type)detail::Traits<T>::size;
+        }
+        friend bool operator==(const iterator & a, const iterator & b) noexcept { return a.p_ == b.p_; }
+        friend bool operator!=(const iterator & a, const iterator & b) noexcept { return a.p_ != b.p_; }
+        friend bool operator<(const iterator & a, const iterator & b) noexcept { return a.p_ < b.p_; }
+        friend bool operator>(const iterator & a, const iterator & b) noexcept { return a.p_ > b.p_; }
+        friend bool operator<=(const iterator & a, const iterator & b) noexcept { return a.p_ <= b.p_; }
+        friend bool operator>=(const iterator & a, const iterator & b) noexcept { return a.p_ >= b.p_; }
+    private:
+        const uint8_t * p_;
+        nanoexif_endian e_;
+    };
+
+    Values() noexcept : data_(nullptr), count_(0), endian_(NANOEXIF_MACHINE_ENDIAN) {}
+    Values(const uint8_t * data, uint32_t count, nanoexif_endian endian) noexcept : data_(data), count_(count), endian_(endian) {}
+
+    size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    /* undefined unless i < size() */
+    T operator[](size_t i) const noexcept { return detail::Traits<T>::load(data_ + i*detail::Traits<T>::size, endian_); }
+    T front() const noexcept { return (*this)[0]; }
+    Result<T> at(size_t i) const noexcept {
+        if (i >= count_) { return Errc::out_of_range; }
+        return (*this)[i];
+    }
+    iterator begin() const noexcept { return iterator(data_, endian_); }
+    iterator end() const noexcept { return iterator(data_ + (size_t)count_*detail::Traits<T>::size, endian_); }
+
+    /* the raw bytes, in the file's endian */
+    const uint8_t * data() const noexcept { return data_; }
+    size_t size_bytes() const noexcept { return (size_t)count_*detail::Traits<T>::size; }
+    nanoexif_endian endian() const noexcept { return endian_; }
+
+private:
+    const uint8_t * data_;
+    uint32_t count_;
+    nanoexif_endian endian_;
+};
+
+/**
+ * an ifd entry, with the ifd it belongs to and where it is in the exif data.
+ */
+class Entry {
+public:
+    Entry() noexcept : raw_(), offset_(0), ifd_(NANOEXIF_IFD_0) {}
+    Entry(const nanoexif_ifd_entry & raw, uint32_t offset, nanoexif_ifd_kind ifd) noexcept : raw_(raw), offset_(offset), ifd_(ifd) {}
+
+    uint16_t tag() const noexcept { return raw_.tag; }
+    uint16_t type() const noexcept { return raw_.type; }
+    uint32_t count() const noexcept { return raw_.count; }
+    nanoexif_ifd_kind ifd() const noexcept { return ifd_; }
+    /* where the entry is, from the tiff header. 0 if it is not known */
+    uint32_t offset() const noexcept { return offset_; }
+    const nanoexif_ifd_entry & raw() const noexcept { return raw_; }
+    nanoexif_ifd_entry & raw() noexcept { return raw_; }
+
+private:
+    nanoexif_ifd_entry raw_;
+    uint32_t offset_;
+    nanoexif_ifd_kind ifd_;
+};
+
+/**
+ * every entry of every ifd, in the order of nanoexif_walker_next(). The walker state lives in this
+ * object, so keep it alive while iterating; a range-for over Exif::entries() does.
+ */
+class Entries {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Entry;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Entry *;
+        using reference         = const Entry &;
+
+        iterator() noexcept : r_(nullptr) {}
+        explicit iterator(Entries * r) noexcept : r_(r) {}
+        const Entry & operator*() const noexcept { return r_->cur_; }
+        const Entry * operator->() const noexcept { return &r_->cur_; }
+        iterator & operator++() noexcept {
+            if (!r_->next()) { r_ = nullptr; }
+            return *this;
+        }
+        friend bool operator==(const iterator & a, const iterator & b) noexcept { return a.r_ == b.r_; }
+        friend bool operator!=(const iterator & a, const iterator & b) noexcept { return a.r_ != b.r_; }
+    private:
+        Entries * r_;
+    };
+
+    Entries(nanoexif * ne, uint32_t ifd0_offset) noexcept : status_(NANOEXIF_WALK_END) {
+        nanoexif_walker_init(&w_, ne, ifd0_offset);
+    }
+
+    iterator begin() noexcept { return next() ? iterator(this) : iterator(); }
+    iterator end() noexcept { return iterator(); }
+    /* true if the walk stopped at broken data, rather than at the end */
+    bool broken() const noexcept { return status_ == NANOEXIF_WALK_ERROR; }
+
+private:
+    bool next() noexcept {
+        nanoexif_ifd_entry raw;
+        status_ = nanoexif_walker_next(&w_, &raw);
+        if (status_ != NANOEXIF_WALK_ENTRY) { return false; }
+        cur_ = Entry(raw, w_.ifd_offset + 2 + (uint32_t)sizeof(nanoexif_ifd_entry)*(w_.index-1), w_.kind);
+        return true;
+    }
+
+    nanoexif_walker w_;
+    nanoexif_walk_status status_;
+    Entry cur_;
+};
+
+/**
+ * move only owner of a nanoexif handle. The handle is released with nanoexif_free() on destruction.
+ */
+class Exif {
+public:
+    Exif() noexcept : ne_(nullptr), ifd0_offset_(0) {}
+    /* adopt the handle from nanoexif_init*() */
+    Exif(nanoexif * ne, uint32_t ifd0_offset) noexcept : ne_(ne), ifd0_offset_(ifd0_offset) {}
+    ~Exif() { nanoexif_free(ne_); }
+
+    Exif(const Exif &) = delete;
+    Exif & operator=(const Exif &) = delete;
+    Exif(Exif && o) noexcept : ne_(o.ne_), ifd0_offset_(o.ifd0_offset_) { o.ne_ = nullptr; }
+    Exif & operator=(Exif && o) noexcept {
+        if (this != &o) {
+            nanoexif_free(ne_);
+            ne_          = o.ne_;
+            ifd0_offset_ = o.ifd0_offset_;
+            o.ne_        = nullptr;
+        }
+        return *this;
+    }
+
+    /** read the exif from the jpeg file. see nanoexif_init(). */
+    static Result<Exif> open(FILE * fp) noexcept {
+        uint32_t off = 0;
+        nanoexif * ne = nanoexif_init(fp, &off);
+        return adopt(ne, off);
+    }
+    /** from the jpeg in memory, without copying. data should outlive the Exif. see nanoexif_init_from_memory(). */
+    static Result<Exif> from_memory(const uint8_t * data, size_t len) noexcept {
+        uint32_t off = 0;
+        nanoexif * ne = nanoexif_init_from_memory(data, len, &off);
+        return adopt(ne, off);
+    }
+    /** with pread(2) on the jpeg file. see nanoexif_init_fd(). */
+    static Result<Exif> from_fd(int fd, size_t prefix = 0) noexcept {
+        uint32_t off = 0;
+        nanoexif * ne = nanoexif_init_fd(fd, prefix, &off, nullptr);
+        return adopt(ne, off);
+    }
+    /** by mapping the jpeg file. see nanoexif_init_mmap(). */
+    static Result<Exif> map(int fd) noexcept {
+        uint32_t off = 0;
+        nanoexif * ne = nanoexif_init_mmap(fd, &off);
+        return adopt(ne, off);
+    }
+    /** from the tiff in memory, without copying. see nanoexif_init_tiff(). */
+    static Result<Exif> from_tiff(const uint8_t * data, size_t len) noexcept {
+        uint32_t off = 0;
+        nanoexif * ne = nanoexif_init_tiff(data, len, &off);
+        return adopt(ne, off);
+    }
+
+    nanoexif * get() const noexcept { return ne_; }
+    uint32_t ifd0_offset() const noexcept { return ifd0_offset_; }
+    nanoexif_endian endian() const noexcept { return ne_->endian; }
+    explicit operator bool() const noexcept { return ne_ != nullptr; }
+    /* give up the ownership. you should nanoexif_free() the return value. */
+    nanoexif * release() noexcept {
+        nanoexif * ne = ne_;
+        ne_ = nullptr;
+        return ne;
+    }
+
+    /** every entry of every ifd. it never allocates. */
+    Entries entries() const noexcept { return Entries(ne_, ifd0_offset_); }
+
+    /** look up the tag in the ifd. see nanoexif_query(). */
+    Result<Entry> find(nanoexif_ifd_kind ifd, uint16_t tag) const noexcept {
+        nanoexif_tag_key key = { ifd, tag };
+        nanoexif_query_result res;
+        if (!nanoexif_query(ne_, ifd0_offset_, &key, 1, &res)) { return Errc::not_found; }
+        return Entry(res.entry, res.offset, ifd);
+    }
+
+    /** the count*nanoexif_type_size() value bytes of the entry, in the file's endian. */
+    Result<Values<uint8_t>> bytes(const Entry & e) const noexcept {
+        size_t unit = nanoexif_type_size(e.type());
+        if (unit == 0) { return Errc::type_mismatch; }
+        const uint8_t * p = data(e, unit);
+        if (!p) { return Errc::out_of_range; }
+        return Values<uint8_t>(p, (uint32_t)(unit * e.count()), ne_->endian);
+    }
+
+    /** the values of the entry, which should be of the type T stands for:
+     * uint8_t for BYTE and UNDEFINED, uint16_t for SHORT, uint32_t for LONG, Rational for RATIONAL and so on.
+     */
+    template <class T>
+    Result<Values<T>> values(const Entry & e) const noexcept {
+        if (!detail::Traits<T>::accepts(e.type())) { return Errc::type_mismatch; }
+        const uint8_t * p = data(e, detail::Traits<T>::size);
+        if (!p) { return Errc::out_of_range; }
+        return Values<T>(p, e.count(), ne_->endian);
+    }
+
+    /** the ASCII value, without the trailing NULs. */
+    Result<std::string_view> ascii(const Entry & e) const noexcept {
+        if (e.type() != NANOEXIF_TYPE_ASCII) { return Errc::type_mismatch; }
+        const uint8_t * p = data(e, 1);
+        if (!p) { return Errc::out_of_range; }
+        size_t n = e.count();
+        while (n && p[n-1] == '\0') { n--; }
+        return std::string_view(reinterpret_cast<const char *>(p), n);
+    }
+
+    /** i-th BYTE, SHORT or LONG value. see nanoexif_get_ifd_entry_uint(). */
+    Result<uint32_t> uint(const Entry & e, uint32_t i = 0) const noexcept {
+        nanoexif_ifd_entry raw = e.raw();
+        uint32_t v;
+        if (i >= e.count()) { return Errc::out_of_range; }
+        if (!nanoexif_get_ifd_entry_uint(ne_, &raw, i, &v)) { return Errc::type_mismatch; }
+        return v;
+    }
+
+    /** i-th numeric value as double. see nanoexif_get_ifd_entry_double(). */
+    Result<double> real(const Entry & e, uint32_t i = 0) const noexcept {
+        nanoexif_ifd_entry raw = e.raw();
+        double v;
+        if (i >= e.count()) { return Errc::out_of_range; }
+        if (!nanoexif_get_ifd_entry_double(ne_, &raw, i, &v)) { return Errc::type_mismatch; }
+        return v;
+    }
+
+private:
+    static Result<Exif> adopt(nanoexif * ne, uint32_t ifd0_offset) noexcept {
+        if (!ne) { return Errc::no_exif; }
+        return Exif(ne, ifd0_offset);
+    }
+
+    /* the value bytes in the exif data. small values are read from the entry as it is in the
+     * exif data too, so the view does not depend on the Entry object, unless its offset is unknown(0). */
+    const uint8_t * data(const Entry & e, size_t unit) const noexcept {
+        uint64_t size = (uint64_t)unit * e.count();
+        if (size > UINT32_MAX) { return nullptr; }
+        if (size <= 4) {
+            return e.offset() ? nanoexif_range(ne_, e.offset() + 8, 4) : e.raw().offset;
+        }
+        return nanoexif_range(ne_, detail::load32(e.raw().offset, ne_->endian), (uint32_t)size);
+    }
+
+    nanoexif * ne_;
+    uint32_t ifd0_offset_;
+};
+
+namespace detail {
+
+template <uint16_t Type> struct Element;
+template <> struct Element<NANOEXIF_TYPE_BYTE>      { using type = uint8_t; };
+template <> struct Element<NANOEXIF_TYPE_SHORT>     { using type = uint16_t; };
+template <> struct Element<NANOEXIF_TYPE_LONG>      { using type = uint32_t; };
+template <> struct Element<NANOEXIF_TYPE_RATIONAL>  { using type = Rational; };
+template <> struct Element<NANOEXIF_TYPE_SBYTE>     { using type = int8_t; };
+template <> struct Element<NANOEXIF_TYPE_UNDEFINED> { using type = uint8_t; };
+template <> struct Element<NANOEXIF_TYPE_SSHORT>    { using type = int16_t; };
+template <> struct Element<NANOEXIF_TYPE_SLONG>     { using type = int32_t; };
+template <> struct Element<NANOEXIF_TYPE_SRATIONAL> { using type = SRational; };
+template <> struct Element<NANOEXIF_TYPE_FLOAT>     { using type = float; };
+template <> struct Element<NANOEXIF_TYPE_DFLOAT>    { using type = double; };
+
+template <uint16_t Type, uint32_t Count>
+struct TagValue {
+    using type = typename std::conditional<Count == 1, typename Element<Type>::type, Values<typename Element<Type>::type>>::type;
+};
+template <uint32_t Count>
+struct TagValue<NANOEXIF_TYPE_ASCII, Count> {
+    using type = std::string_view;
+};
+
+/* a single value of the standard type is read in place. any other numeric type is converted,
+ * if the value fits. */
+template <class T>
+struct Decode {
+    static Result<T> get(const Exif & exif, const Entry & e) noexcept {
+        if (e.count() == 0) { return Errc::out_of_range; }
+        if (Traits<T>::accepts(e.type())) {
+            Result<Values<T>> v = exif.values<T>(e);
+            if (!v) { return v.error(); }
+            return v->front();
+        }
+        return convert(exif, e);
+    }
+
+private:
+    static Result<T> convert(const Exif & exif, const Entry & e) noexcept {
+        if constexpr (std::is_floating_point<T>::value) {
+            Result<double> d = exif.real(e);
+            if (!d) { return d.error(); }
+            return static_cast<T>(*d);
+        } else if constexpr (std::is_integral<T>::value) {
+            Result<double> d = exif.real(e);
+            if (!d) { return d.error(); }
+            if (*d < (double)std::numeric_limits<T>::min() || *d > (double)std::numeric_limits<T>::max() || *d != (double)(int64_t)*d) {
+                return Errc::out_of_range;
+            }
+            return static_cast<T>(*d);
+        } else if constexpr (std::is_same<T, Rational>::value) {
+            Result<uint32_t> u = exif.uint(e);
+            if (!u) { return u.error(); }
+            return Rational{ *u, 1 };
+        } else {
+            if (e.type() == NANOEXIF_TYPE_RATIONAL) {
+                Result<Values<Rational>> v = exif.values<Rational>(e);
+                if (!v) { return v.error(); }
+                Rational r = v->front();
+                if (r.num > INT32_MAX || r.den > INT32_MAX) { return Errc::out_of_range; }
+                return SRational{ (int32_t)r.num, (int32_t)r.den };
+            }
+            Result<int32_t> i = Decode<int32_t>::convert(exif, e);
+            if (!i) { return i.error(); }
+            return SRational{ *i, 1 };
+        }
+    }
+
+    template <class U> friend struct Decode;
+};
+
+/* views can not be converted; other types are a mismatch. */
+template <class T>
+struct Decode<Values<T>> {
+    static Result<Values<T>> get(const Exif & exif, const Entry & e) noexcept {
+        return exif.values<T>(e);
+    }
+};
+
+/* some writers put text in BYTE or UNDEFINED. */
+template <>
+struct Decode<std::string_view> {
+    static Result<std::string_view> get(const Exif & exif, const Entry & e) noexcept {
+        if (e.type() == NANOEXIF_TYPE_ASCII) { return exif.ascii(e); }
+        if (e.type() != NANOEXIF_TYPE_BYTE && e.type() != NANOEXIF_TYPE_UNDEFINED) { return Errc::type_mismatch; }
+        Result<Values<uint8_t>> b = exif.bytes(e);
+        if (!b) { return b.error(); }
+        size_t n = b->size();
+        while (n && b->data()[n-1] == '\0') { n--; }
+        return std::string_view(reinterpret_cast<const char *>(b->data()), n);
+    }
+};
+
+} // namespace detail
+
+/**
+ * a tag of the schema in nanoexif-tags.hpp: the tag, the ifd it is defined in, and the type and count
+ * of its value as the standard says. Count 0 means any. value_type is what get<Tag>() returns:
+ * std::string_view for ASCII, the value itself for count 1, and Values<T> otherwise.
+ */
+template <uint16_t Tag_, nanoexif_ifd_kind Ifd, uint16_t Type, uint32_t Count>
+struct Tag {
+    static constexpr uint16_t tag = Tag_;
+    static constexpr nanoexif_ifd_kind ifd = Ifd;
+    static constexpr uint16_t type = Type;
+    static constexpr uint32_t count = Count;
+    using value_type = typename detail::TagValue<Type, Count>::type;
+};
+
+/**
+ * read the tag by its schema:
+ *
+ *     #include <nanoexif-tags.hpp>
+ *     auto orientation = nanoexifpp::get<nanoexifpp::tags::Orientation>(exif); // Result<uint16_t>
+ *
+ * The decoding is picked at compile time from the tag's standard type. A file which stores the
+ * tag in another numeric type is converted at run time, and Errc::out_of_range if the value does not fit.
+ */
+template <class T>
+Result<typename T::value_type> get(const Exif & exif) noexcept {
+    Result<Entry> e = exif.find(T::ifd, T::tag);
+    if (!e) { return e.error(); }
+    return detail::Decode<typename T::value_type>::get(exif, *e);
+}
+
+} // namespace nanoexifpp
+
+#endif  /* NANOEXIF_HPP__ */
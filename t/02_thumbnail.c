@@ -1,5 +1,8 @@
+#define _POSIX_C_SOURCE 200809L
 #include "nanotap.h"
 #include <nanoexif-easy.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 int main(int argc, char **argv) {
     uint16_t orientation;
@@ -16,10 +19,32 @@ int main(int argc, char **argv) {
     ok( orientation == 6, "orientation = 6");
     ok(memcmp(thumb, "\xFF\xD8", 2)==0, "jpeg soi");
     ok(memcmp(thumb+(jpeg_byte_count-2), "\xFF\xD9", 2)==0, "jpeg eoi");
-    free(thumb);
 
     fclose(fp);
 
+    // mmap, zero copy
+    {
+        int fd = open("t/data/sample-iphone.jpg", O_RDONLY);
+        if (fd < 0) {
+            perror(argv[0]);
+            return 1;
+        }
+        uint32_t ifd0_offset;
+        nanoexif * ne = nanoexif_init_mmap(fd, &ifd0_offset);
+        close(fd);
+        ok(!!ne, "mmap");
+        ok(!!ne->map && ne->buf > (uint8_t*)ne->map && ne->buf < (uint8_t*)ne->map + ne->map_len, "buf is in the mapping");
+
+        uint16_t o;
+        uint32_t view_len;
+        const uint8_t * view = nanoexif_easy_thumbnail_view(ne, ifd0_offset, &o, &view_len);
+        ok(!!view, "view");
+        ok(view > (uint8_t*)ne->map && view + view_len <= (uint8_t*)ne->map + ne->map_len, "view is in the mapping");
+        ok(o == 6, "orientation = 6");
+        ok(view_len == jpeg_byte_count && memcmp(view, thumb, view_len) == 0, "same thumbnail");
+        nanoexif_free(ne);
+    }
+    free(thumb);
+
     done_testing();
 }
-
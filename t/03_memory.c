@@ -0,0 +1,67 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+static uint8_t * slurp(const char *src, size_t *len) {
+    FILE *fp = fopen(src, "rb");
+    assert(fp);
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8_t *data = malloc(*len);
+    assert(data);
+    size_t n = fread(data, 1, *len, fp);
+    assert(n == *len);
+    (void)n;
+    fclose(fp);
+    return data;
+}
+
+int main(int argc, char **argv) {
+    size_t len;
+    uint8_t *data = slurp("t/data/sample-iphone.jpg", &len);
+
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init_from_memory(data, len, &ifd0_offset);
+    ok(!!ne, "init from memory");
+    ok(ne->buf > data && ne->buf < data+len, "borrows the caller's bytes");
+    ok(ne->owned == NULL, "nothing to free");
+
+    uint32_t ifd1_offset;
+    uint16_t cnt;
+    nanoexif_ifd_entry* entries = nanoexif_read_ifd(ne, ifd0_offset, &ifd1_offset, &cnt);
+    assert(entries);
+    int i;
+    for (i=0; i<cnt; i++) {
+        switch (entries[i].tag) {
+        case NANOEXIF_TAG_ORIENTATION:
+            {
+                uint16_t *x = nanoexif_get_ifd_entry_data_short(ne, &entries[i]);
+                ok(x && *x == 6, "orientation");
+                free(x);
+            }
+            break;
+        case NANOEXIF_TAG_MAKE:
+            {
+                char *make = nanoexif_get_ifd_entry_data_ascii(ne, &entries[i]);
+                ok(make && strcmp("Apple", make) == 0, "Make");
+                free(make);
+            }
+            break;
+        }
+    }
+    free(entries);
+    ok(ifd1_offset != 0, "ifd1");
+
+    ok(nanoexif_range(ne, 0, ne->len) == ne->buf, "range covers the tiff data");
+    ok(nanoexif_range(ne, ne->len, 1) == NULL, "range past the end");
+    nanoexif_free(ne);
+
+    /* cut in the middle of APP1 */
+    ok(nanoexif_init_from_memory(data, 100, &ifd0_offset) == NULL, "truncated");
+    ok(nanoexif_init_from_memory((const uint8_t*)"\xFF\xD8\xFF\xDA\x00\x02", 6, &ifd0_offset) == NULL, "no exif");
+
+    free(data);
+    done_testing();
+}
@@ -0,0 +1,72 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init(fp, &ifd0_offset);
+    assert(ne);
+    fclose(fp);
+
+    int counts[5] = {0, 0, 0, 0, 0};
+    nanoexif_ifd_kind order[5];
+    int nifds = 0;
+    uint32_t current = 0;
+    bool datetime = false;
+    uint32_t width = 0;
+
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    nanoexif_walk_status st;
+    nanoexif_walker_init(&w, ne, ifd0_offset);
+    while ((st = nanoexif_walker_next(&w, &entry)) == NANOEXIF_WALK_ENTRY) {
+        if (w.ifd_offset != current) {
+            current = w.ifd_offset;
+            order[nifds++] = w.kind;
+        }
+        counts[w.kind]++;
+        if (w.kind == NANOEXIF_IFD_EXIF && entry.tag == 0x9003) {
+            const uint8_t *p = nanoexif_get_ifd_entry_data(ne, &entry);
+            datetime = p && entry.count == 20 && memcmp(p, "2010:", 5) == 0;
+        }
+        if (w.kind == NANOEXIF_IFD_EXIF && entry.tag == 0xA002) {
+            nanoexif_get_ifd_entry_uint(ne, &entry, 0, &width);
+        }
+    }
+    ok(st == NANOEXIF_WALK_END, "walked to the end");
+    ok(nifds == 4, "4 ifds");
+    ok(order[0] == NANOEXIF_IFD_0 && order[1] == NANOEXIF_IFD_1 && order[2] == NANOEXIF_IFD_EXIF && order[3] == NANOEXIF_IFD_GPS, "order");
+    ok(counts[NANOEXIF_IFD_0] == 11, "IFD0");
+    ok(counts[NANOEXIF_IFD_1] == 7, "IFD1");
+    ok(counts[NANOEXIF_IFD_EXIF] == 21, "Exif");
+    ok(counts[NANOEXIF_IFD_GPS] == 7, "GPS");
+    ok(datetime, "DateTimeOriginal");
+    ok(width == 2048, "ExifImageWidth");
+    nanoexif_free(ne);
+
+    // IFD0 whose next ifd is itself
+    {
+        const uint8_t data[] =
+            "\xFF\xD8"
+            "\xFF\xE1\x00\x26" "Exif\0\0"
+            "II\x2A\x00\x08\x00\x00\x00"
+            "\x01\x00"
+            "\x12\x01\x03\x00\x01\x00\x00\x00\x01\x00\x00\x00"
+            "\x08\x00\x00\x00"
+            "\xFF\xDA\x00\x02";
+        ne = nanoexif_init_from_memory(data, sizeof(data)-1, &ifd0_offset);
+        assert(ne);
+        int n = 0;
+        nanoexif_walker_init(&w, ne, ifd0_offset);
+        while ((st = nanoexif_walker_next(&w, &entry)) == NANOEXIF_WALK_ENTRY) {
+            n++;
+        }
+        ok(st == NANOEXIF_WALK_END && n == 1, "loop is detected");
+        nanoexif_free(ne);
+    }
+
+    done_testing();
+}
@@ -0,0 +1,48 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif-batch.h>
+
+int main(int argc, char **argv) {
+    nanoexif_columns * cols = nanoexif_columns_new(1);
+    assert(cols);
+
+    FILE * fps[2];
+    fps[0] = fopen("t/data/sample-iphone.jpg", "rb");
+    fps[1] = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fps[0] && fps[1]);
+    ok(nanoexif_batch_extract(cols, fps, 2) == 2, "2 files");
+    fclose(fps[0]);
+    fclose(fps[1]);
+
+    const uint8_t * data[] = { (const uint8_t*)"\xFF\xD8\xFF\xDA\x00\x02" };
+    size_t lens[] = { 6 };
+    ok(nanoexif_batch_extract_memory(cols, data, lens, 1) == 0, "no exif");
+    ok(cols->n == 3, "3 rows");
+
+    ok(nanoexif_columns_is_valid(cols, NANOEXIF_COL_MAKE, 0), "make is valid");
+    ok(cols->make.offsets[1] - cols->make.offsets[0] == 5 && memcmp(cols->make.data, "Apple", 5) == 0, "make");
+    ok(cols->model.offsets[1] - cols->model.offsets[0] == 10 && memcmp(cols->model.data, "iPhone 3GS", 10) == 0, "model");
+    ok(cols->datetime_original.offsets[2] - cols->datetime_original.offsets[1] == 19
+        && memcmp(cols->datetime_original.data + cols->datetime_original.offsets[1], "2010:01:13 10:34:35", 19) == 0, "datetime of row 1");
+    ok(cols->orientation[0] == 6 && cols->orientation[1] == 6, "orientation");
+    ok(cols->width[0] == 2048 && cols->height[0] == 1536, "dimensions");
+    ok(cols->exposure_time[0] > 0 && cols->f_number[0] > 0 && cols->focal_length[0] > 0, "exposure");
+    ok(nanoexif_columns_is_valid(cols, NANOEXIF_COL_ISO, 0), "iso is valid");
+    ok(nanoexif_columns_is_valid(cols, NANOEXIF_COL_LATITUDE, 0) && cols->latitude[0] >= -90 && cols->latitude[0] <= 90, "latitude");
+    ok(nanoexif_columns_is_valid(cols, NANOEXIF_COL_LONGITUDE, 1) && cols->longitude[1] >= -180 && cols->longitude[1] <= 180, "longitude");
+
+    int col;
+    bool any = false;
+    for (col=0; col<NANOEXIF_COL_COUNT; col++) {
+        any = any || nanoexif_columns_is_valid(cols, col, 2);
+    }
+    ok(!any, "row without exif is null");
+    ok(cols->make.offsets[3] == cols->make.offsets[2], "empty string");
+
+    nanoexif_columns_clear(cols);
+    ok(cols->n == 0 && !nanoexif_columns_is_valid(cols, NANOEXIF_COL_MAKE, 0), "clear");
+
+    nanoexif_columns_free(cols);
+    done_testing();
+}
@@ -0,0 +1,63 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+int main(int argc, char **argv) {
+    nanoexif_ctx * ctx = nanoexif_ctx_new();
+    assert(ctx);
+
+    uint8_t * buf = NULL;
+    nanoexif_ifd_entry * entries_buf = NULL;
+    uint8_t * scratch = NULL;
+    int round;
+    for (round=0; round<3; round++) {
+        FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+        assert(fp);
+        uint32_t ifd0_offset;
+        nanoexif * ne = nanoexif_reset(ctx, fp, &ifd0_offset);
+        fclose(fp);
+        ok(ne == &ctx->ne, "reset");
+
+        uint32_t ifd1_offset;
+        uint16_t cnt;
+        nanoexif_ifd_entry * entries = nanoexif_ctx_read_ifd(ctx, ifd0_offset, &ifd1_offset, &cnt);
+        assert(entries);
+        uint16_t orientation = 0;
+        char make[16] = "";
+        int i;
+        for (i=0; i<cnt; i++) {
+            if (entries[i].tag == NANOEXIF_TAG_ORIENTATION) {
+                const uint16_t *x = nanoexif_ctx_get_ifd_entry_data(ctx, &entries[i]);
+                orientation = *x;
+            } else if (entries[i].tag == NANOEXIF_TAG_MAKE) {
+                const char *x = nanoexif_ctx_get_ifd_entry_data(ctx, &entries[i]);
+                strncpy(make, x, sizeof(make)-1);
+            } else if (entries[i].tag == 0x011a) { // XResolution
+                const uint32_t *x = nanoexif_ctx_get_ifd_entry_data(ctx, &entries[i]);
+                ok(x[0] == 72 && x[1] == 1, "rational");
+            }
+        }
+        ok(orientation == 6, "orientation");
+        ok(strcmp(make, "Apple") == 0, "make");
+
+        if (round == 0) {
+            buf         = ctx->buf;
+            entries_buf = ctx->entries;
+            scratch     = ctx->scratch;
+        } else {
+            ok(buf == ctx->buf && entries_buf == ctx->entries && scratch == ctx->scratch, "buffers are reused");
+        }
+    }
+
+    {
+        FILE *fp = fopen("t/02_thumbnail.c", "rb");
+        assert(fp);
+        uint32_t ifd0_offset;
+        ok(nanoexif_reset(ctx, fp, &ifd0_offset) == NULL, "not a jpeg");
+        fclose(fp);
+    }
+
+    nanoexif_ctx_free(ctx);
+    done_testing();
+}
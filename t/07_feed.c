@@ -0,0 +1,76 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+typedef struct {
+    int entries;
+    int early;
+    uint16_t orientation;
+    int gps;
+    nanoexif_parser * p;
+} result;
+
+static void on_entry(nanoexif * ne, nanoexif_ifd_kind kind, nanoexif_ifd_entry * entry, void * ud) {
+    result * r = ud;
+    r->entries++;
+    if (ne->len < r->p->need) {
+        r->early++;
+    }
+    if (kind == NANOEXIF_IFD_0 && entry->tag == NANOEXIF_TAG_ORIENTATION) {
+        uint32_t v;
+        if (nanoexif_get_ifd_entry_uint(ne, entry, 0, &v)) {
+            r->orientation = v;
+        }
+    }
+    if (kind == NANOEXIF_IFD_GPS) {
+        r->gps++;
+    }
+}
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    static uint8_t data[1024*1024];
+    size_t len = fread(data, 1, sizeof(data), fp);
+    fclose(fp);
+
+    size_t sizes[] = { 1, 7, 4096, len };
+    int i;
+    nanoexif_parser * p = NULL;
+    for (i=0; i<4; i++) {
+        result r = { 0, 0, 0, 0, NULL };
+        if (p) {
+            nanoexif_parser_reset(p);
+        } else {
+            p = nanoexif_parser_new(on_entry, &r);
+            assert(p);
+        }
+        p->ud = &r;
+        r.p   = p;
+
+        size_t pos = 0;
+        nanoexif_feed_status st = NANOEXIF_FEED_MORE;
+        while (pos < len && st == NANOEXIF_FEED_MORE) {
+            size_t n = len - pos < sizes[i] ? len - pos : sizes[i];
+            st = nanoexif_feed(p, data + pos, n);
+            pos += n;
+        }
+        ok(st == NANOEXIF_FEED_DONE, "done");
+        ok(sizes[i] == len || pos < len, "stops before the end of the stream");
+        ok(r.entries == 46, "all entries");
+        ok(r.orientation == 6, "orientation");
+        ok(r.gps == 7, "gps");
+        ok(sizes[i] == len || r.early > 0, "entries are reported while streaming");
+
+        uint32_t ifd0_offset;
+        nanoexif * ne = nanoexif_parser_exif(p, &ifd0_offset);
+        ok(ne && ifd0_offset == 8, "exif");
+    }
+
+    nanoexif_parser_reset(p);
+    ok(nanoexif_feed(p, (const uint8_t*)"\xFF\xD8\xFF\xDA\x00\x02", 6) == NANOEXIF_FEED_ERROR, "no exif");
+    nanoexif_parser_free(p);
+
+    done_testing();
+}
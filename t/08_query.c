@@ -0,0 +1,95 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init(fp, &ifd0_offset);
+    assert(ne);
+    fclose(fp);
+
+    {
+        nanoexif_tag_key keys[] = {
+            { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION },
+        };
+        nanoexif_query_result results[1];
+        ok(nanoexif_query(ne, ifd0_offset, keys, 1, results) == 1, "orientation only");
+        uint32_t v;
+        ok(results[0].found && nanoexif_get_ifd_entry_uint(ne, &results[0].entry, 0, &v) && v == 6, "orientation");
+        ok(results[0].offset > ifd0_offset && results[0].offset < ifd0_offset + 2 + 12*11, "offset of the entry");
+    }
+
+    {
+        nanoexif_tag_key keys[] = {
+            { NANOEXIF_IFD_EXIF, 0x9003 },                  // DateTimeOriginal
+            { NANOEXIF_IFD_0,    NANOEXIF_TAG_MAKE },
+            { NANOEXIF_IFD_GPS,  0x0002 },                  // GPSLatitude
+            { NANOEXIF_IFD_1,    NANOEXIF_TAG_COMPRESSION },
+            { NANOEXIF_IFD_0,    0x0002 },                  // not in IFD0
+            { NANOEXIF_IFD_INTEROP, 0x0001 },               // no interop ifd
+        };
+        nanoexif_query_result results[6];
+        ok(nanoexif_query(ne, ifd0_offset, keys, 6, results) == 4, "4 of 6");
+        ok(results[0].found && results[0].entry.type == NANOEXIF_TYPE_ASCII && results[0].entry.count == 20, "DateTimeOriginal");
+        ok(results[1].found && memcmp(nanoexif_get_ifd_entry_data(ne, &results[1].entry), "Apple", 6) == 0, "Make");
+        ok(results[2].found && results[2].entry.type == NANOEXIF_TYPE_RATIONAL && results[2].entry.count == 3, "GPSLatitude");
+        uint32_t v;
+        ok(results[3].found && nanoexif_get_ifd_entry_uint(ne, &results[3].entry, 0, &v) && v == 6, "Compression in IFD1");
+        ok(!results[4].found, "GPS tag number is not found in IFD0");
+        ok(!results[5].found, "interop");
+    }
+
+    nanoexif_free(ne);
+
+    // IFD0 is not sorted
+    {
+        const uint8_t data[] =
+            "\xFF\xD8"
+            "\xFF\xE1\x00\x32" "Exif\0\0"
+            "II\x2A\x00\x08\x00\x00\x00"
+            "\x02\x00"
+            "\x12\x01\x03\x00\x01\x00\x00\x00\x03\x00\x00\x00"
+            "\x0f\x01\x02\x00\x04\x00\x00\x00" "ABC\0"
+            "\x00\x00\x00\x00"
+            "\xFF\xDA\x00\x02";
+        ne = nanoexif_init_from_memory(data, sizeof(data)-1, &ifd0_offset);
+        assert(ne);
+        nanoexif_tag_key keys[] = {
+            { NANOEXIF_IFD_0, NANOEXIF_TAG_MAKE },
+            { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION },
+        };
+        nanoexif_query_result results[2];
+        ok(nanoexif_query(ne, ifd0_offset, keys, 2, results) == 2, "unsorted ifd");
+        nanoexif_free(ne);
+    }
+
+    // sorted IFD0 with a duplicated tag
+    {
+        const uint8_t tiff[] =
+            "II\x2A\x00\x08\x00\x00\x00"
+            "\x05\x00"
+            "\x00\x01\x03\x00\x01\x00\x00\x00\x40\x00\x00\x00"
+            "\x12\x01\x03\x00\x01\x00\x00\x00\x01\x00\x00\x00"
+            "\x12\x01\x03\x00\x01\x00\x00\x00\x02\x00\x00\x00"
+            "\x12\x01\x03\x00\x01\x00\x00\x00\x03\x00\x00\x00"
+            "\x31\x01\x02\x00\x04\x00\x00\x00" "ABC\0"
+            "\x00\x00\x00\x00";
+        ne = nanoexif_init_tiff(tiff, sizeof(tiff)-1, &ifd0_offset);
+        assert(ne);
+        nanoexif_tag_key keys[] = {
+            { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION },
+            { NANOEXIF_IFD_0, NANOEXIF_TAG_MAKE },
+        };
+        nanoexif_query_result results[2];
+        ok(nanoexif_query(ne, ifd0_offset, keys, 2, results) == 1, "sorted ifd");
+        uint32_t v;
+        ok(results[0].found && nanoexif_get_ifd_entry_uint(ne, &results[0].entry, 0, &v) && v == 1, "first of the duplicates");
+        ok(!results[1].found, "miss");
+        nanoexif_free(ne);
+    }
+
+    done_testing();
+}
@@ -0,0 +1,58 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <assert.h>
+#include <nanoexif-bulk.h>
+
+typedef struct {
+    int calls;
+    int exif;
+    int in_order;
+    uint16_t orientation[8];
+} result;
+
+static void on_file(size_t index, nanoexif * ne, uint32_t ifd0_offset, void * ud) {
+    result * r = ud;
+    if ((size_t)r->calls == index) { r->in_order++; }
+    r->calls++;
+    if (ne) {
+        r->exif++;
+        nanoexif_tag_key key = { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION };
+        nanoexif_query_result res;
+        uint32_t v;
+        if (nanoexif_query(ne, ifd0_offset, &key, 1, &res) && nanoexif_get_ifd_entry_uint(ne, &res.entry, 0, &v)) {
+            r->orientation[index] = v;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    const char * paths[] = {
+        "t/data/sample-iphone.jpg",
+        "t/09_bulk.c",
+        "t/data/no-such-file.jpg",
+        "t/data/sample-iphone.jpg",
+        "t/data/sample-iphone.jpg",
+    };
+
+    int uring;
+    for (uring=0; uring<2; uring++) {
+        /* a small window forces follow-up reads, and a small depth forces several batches */
+        size_t windows[] = { 0, 64 };
+        int i;
+        for (i=0; i<2; i++) {
+            nanoexif_bulk * b = nanoexif_bulk_new(windows[i], 2, uring);
+            assert(b);
+            if (!uring) {
+                ok(!nanoexif_bulk_is_uring(b), "pread fallback");
+            }
+            result r;
+            memset(&r, 0, sizeof(r));
+            ok(nanoexif_bulk_read(b, paths, 5, on_file, &r) == 3, "3 files have exif");
+            ok(r.calls == 5 && r.in_order == 5, "called in order");
+            ok(r.orientation[0] == 6 && r.orientation[3] == 6 && r.orientation[4] == 6, "orientation");
+            nanoexif_bulk_free(b);
+        }
+    }
+
+    done_testing();
+}
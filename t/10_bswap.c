@@ -0,0 +1,52 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <nanoexif-bswap.h>
+
+#define MAXN 67
+
+static int check(const nanoexif_bswap_kernel * k, size_t width) {
+    uint8_t src[MAXN*4+1], dst[MAXN*4+1+8], want[MAXN*4];
+    size_t n, i, j;
+    for (i=0; i<sizeof(src); i++) { src[i] = (uint8_t)(i*7+1); }
+    /* every length across the vector widths, from an odd address */
+    for (n=0; n<=MAXN; n++) {
+        for (i=0; i<n; i++) {
+            for (j=0; j<width; j++) { want[i*width+j] = src[1+i*width+(width-1-j)]; }
+        }
+        memset(dst, 0xee, sizeof(dst));
+        if (width == 2) { k->swap16(dst+1, src+1, n); } else { k->swap32(dst+1, src+1, n); }
+        if (memcmp(dst+1, want, n*width) != 0) { return 0; }
+        if (dst[0] != 0xee || dst[1+n*width] != 0xee) { return 0; }
+
+        memcpy(dst+1, src+1, n*width);
+        if (width == 2) { k->swap16(dst+1, dst+1, n); } else { k->swap32(dst+1, dst+1, n); }
+        if (memcmp(dst+1, want, n*width) != 0) { return 0; }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    size_t n, i;
+    const nanoexif_bswap_kernel * kernels = nanoexif_bswap_kernels(&n);
+    ok(n >= 1, "kernels");
+    ok(strcmp(kernels[0].name, "scalar") == 0, "scalar first");
+    ok(&kernels[n-1] == nanoexif_bswap_selected(), "selected is the last");
+    for (i=0; i<n; i++) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "%s swap16", kernels[i].name);
+        ok(check(&kernels[i], 2), msg);
+        snprintf(msg, sizeof(msg), "%s swap32", kernels[i].name);
+        ok(check(&kernels[i], 4), msg);
+    }
+
+    uint16_t s = 0x1234;
+    uint32_t l = 0x12345678;
+    nanoexif_bswap16(&s, &s, 1);
+    nanoexif_bswap32(&l, &l, 1);
+    ok(s == 0x3412, "nanoexif_bswap16");
+    ok(l == 0x78563412, "nanoexif_bswap32");
+
+    done_testing();
+}
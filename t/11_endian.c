@@ -0,0 +1,105 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <nanoexif.h>
+
+/* builds the same exif in both byte orders, and checks that both decode to the same values. */
+
+static uint8_t buf[256];
+static size_t pos;
+static int big;
+
+static void put16(uint16_t v) {
+    buf[pos++] = big ? v>>8 : v&0xff;
+    buf[pos++] = big ? v&0xff : v>>8;
+}
+static void put32(uint32_t v) {
+    if (big) { put16(v>>16); put16(v&0xffff); } else { put16(v&0xffff); put16(v>>16); }
+}
+static void put_entry(uint16_t tag, uint16_t type, uint32_t count, uint32_t offset) {
+    put16(tag); put16(type); put32(count); put32(offset);
+}
+
+#define TIFF 12 /* FFD8 FFE1 len "Exif\0\0" */
+
+static size_t build(void) {
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, "\xFF\xD8\xFF\xE1\x00\x00" "Exif\0\0", TIFF);
+    pos = TIFF;
+    memcpy(buf+pos, big ? "MM" : "II", 2); pos += 2;
+    put16(0x2A); put32(8);
+
+    put16(4);
+    put_entry(0x0100, NANOEXIF_TYPE_SHORT, 1, 0);            /* inline: fixed below */
+    put_entry(0x0111, NANOEXIF_TYPE_LONG, 3, 62);
+    put_entry(0x011a, NANOEXIF_TYPE_RATIONAL, 1, 74);
+    put_entry(0x0140, NANOEXIF_TYPE_SHORT, 9, 82);
+    put32(0);
+    /* ImageWidth=640 stored left justified in the offset field */
+    size_t save = pos;
+    pos = TIFF + 8 + 2 + 8;
+    put16(640);
+    pos = save;
+
+    assert(pos == TIFF + 62);
+    put32(1); put32(2); put32(0x01020304);
+    put32(72); put32(1);
+    int i;
+    for (i=0; i<9; i++) { put16(0x1000 + i); }
+
+    size_t app1 = pos - 4;
+    buf[4] = app1 >> 8;
+    buf[5] = app1 & 0xff;
+    memcpy(buf+pos, "\xFF\xDA\x00\x02", 4);
+    return pos + 4;
+}
+
+static void check(const char *name) {
+    char msg[128];
+    size_t len = build();
+    uint32_t ifd0_offset, next;
+    uint16_t cnt;
+    nanoexif * ne = nanoexif_init_from_memory(buf, len, &ifd0_offset);
+#define OK(x, what) snprintf(msg, sizeof(msg), "%s: %s", name, what); ok((x), msg)
+    OK(ne != NULL, "init");
+    if (!ne) { return; }
+    OK(ne->endian == (big ? NANOEXIF_BIG_ENDIAN : NANOEXIF_LITTLE_ENDIAN), "endian");
+
+    nanoexif_ifd_entry * e = nanoexif_read_ifd(ne, ifd0_offset, &next, &cnt);
+    OK(e && cnt == 4 && next == 0, "read_ifd");
+    OK(e[0].tag == 0x0100 && e[0].type == NANOEXIF_TYPE_SHORT && e[0].count == 1, "entry");
+
+    uint32_t v;
+    OK(nanoexif_get_ifd_entry_uint(ne, &e[0], 0, &v) && v == 640, "inline short");
+    OK(nanoexif_get_ifd_entry_uint(ne, &e[1], 2, &v) && v == 0x01020304, "long");
+
+    uint32_t * l = nanoexif_get_ifd_entry_data_long(ne, &e[1]);
+    OK(l && l[0] == 1 && l[1] == 2 && l[2] == 0x01020304, "data_long");
+    free(l);
+    uint32_t * r = nanoexif_get_ifd_entry_data_rational(ne, &e[2]);
+    OK(r && r[0] == 72 && r[1] == 1, "data_rational");
+    free(r);
+    double d;
+    OK(nanoexif_get_ifd_entry_double(ne, &e[2], 0, &d) && d == 72.0, "double");
+    uint16_t * s = nanoexif_get_ifd_entry_data_short(ne, &e[3]);
+    OK(s && s[0] == 0x1000 && s[8] == 0x1008, "data_short");
+    free(s);
+
+    nanoexif_tag_key key = { NANOEXIF_IFD_0, 0x011a };
+    nanoexif_query_result res;
+    OK(nanoexif_query(ne, ifd0_offset, &key, 1, &res) == 1 && res.entry.count == 1, "query");
+
+    free(e);
+    nanoexif_free(ne);
+#undef OK
+}
+
+int main(int argc, char **argv) {
+    big = 0;
+    check("II");
+    big = 1;
+    check("MM");
+    done_testing();
+}
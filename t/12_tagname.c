@@ -0,0 +1,49 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <string.h>
+#include <nanoexif.h>
+
+int main(int argc, char **argv) {
+    ok(strcmp(nanoexif_tag_name(NANOEXIF_TAG_ORIENTATION), "Orientation") == 0, "Orientation");
+    ok(strcmp(nanoexif_tag_name(0x9003), "DateTimeOriginal") == 0, "DateTimeOriginal");
+    ok(nanoexif_tag_name(0x0000) == NULL, "unknown");
+    ok(nanoexif_tag_name(0x10112) == NULL, "out of range");
+
+    // GPS has its own numbers
+    ok(strcmp(nanoexif_ifd_tag_name(NANOEXIF_IFD_GPS, 0x0002), "GPSLatitude") == 0, "GPSLatitude");
+    ok(strcmp(nanoexif_ifd_tag_name(NANOEXIF_IFD_INTEROP, 0x0002), "InteropVersion") == 0, "InteropVersion");
+    ok(strcmp(nanoexif_ifd_tag_name(NANOEXIF_IFD_EXIF, 0x0112), "Orientation") == 0, "main tags in exif ifd");
+    ok(nanoexif_ifd_tag_name(NANOEXIF_IFD_GPS, 0x0112) == NULL, "not a gps tag");
+
+    nanoexif_tag_key key;
+    ok(nanoexif_tag_by_name("DateTimeOriginal", &key) && key.tag == 0x9003 && key.ifd == NANOEXIF_IFD_EXIF, "by name");
+    ok(nanoexif_tag_by_name("Make", &key) && key.tag == NANOEXIF_TAG_MAKE && key.ifd == NANOEXIF_IFD_0, "Make");
+    ok(nanoexif_tag_by_name("GPSLatitude", &key) && key.tag == 0x0002 && key.ifd == NANOEXIF_IFD_GPS, "GPSLatitude");
+    ok(nanoexif_tag_by_name("InteropIndex", &key) && key.tag == 0x0001 && key.ifd == NANOEXIF_IFD_INTEROP, "InteropIndex");
+    ok(nanoexif_tag_by_name("ExposureIndex", &key) && key.tag == 0xA215, "duplicated name prefers exif");
+    ok(nanoexif_tag_by_name("ImageWidth", &key) && key.tag == 0x0100, "duplicated name prefers smaller");
+    ok(!nanoexif_tag_by_name("NoSuchTag", &key), "unknown name");
+    ok(!nanoexif_tag_by_name("", &key), "empty name");
+    ok(!nanoexif_tag_by_name("Orientatio", &key), "prefix");
+
+    // every name maps back to a tag with the same name
+    int names = 0, roundtrip = 0;
+    uint32_t tag;
+    int gps;
+    for (gps=0; gps<2; gps++) {
+        for (tag=0; tag<=0xFFFF; tag++) {
+            const char * name = nanoexif_ifd_tag_name(gps ? NANOEXIF_IFD_GPS : NANOEXIF_IFD_0, tag);
+            if (!name) { continue; }
+            names++;
+            if (nanoexif_tag_by_name(name, &key)
+                    && (key.ifd == NANOEXIF_IFD_GPS) == gps
+                    && strcmp(nanoexif_ifd_tag_name(key.ifd, key.tag), name) == 0) {
+                roundtrip++;
+            }
+        }
+    }
+    ok(names > 300, "names");
+    ok(names == roundtrip, "round trip");
+
+    done_testing();
+}
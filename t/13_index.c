@@ -0,0 +1,80 @@
+#include "nanotap.h"
+#include "fixture.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <nanoexif-index.h>
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init(fp, &ifd0_offset);
+    fclose(fp);
+    assert(ne);
+
+    ok(sizeof(nanoexif_index_record) == 16, "record size");
+
+    nanoexif_index * idx = nanoexif_index_build(ne, ifd0_offset);
+    ok(idx != NULL, "build");
+    ok(idx->n == 11 + 7 + 21 + 7, "all ifds");
+
+    size_t i;
+    bool sorted = true;
+    for (i=1; i<idx->n; i++) {
+        const nanoexif_index_record * a = &idx->records[i-1], * b = &idx->records[i];
+        if (a->ifd > b->ifd || (a->ifd == b->ifd && a->tag > b->tag)) { sorted = false; }
+    }
+    ok(sorted, "sorted");
+
+    nanoexif_ifd_entry entry;
+    uint32_t v;
+    const nanoexif_index_record * r = nanoexif_index_find(idx, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION);
+    ok(r && r->type == NANOEXIF_TYPE_SHORT && r->count == 1, "Orientation");
+    nanoexif_index_entry(idx, r, &entry);
+    ok(nanoexif_get_ifd_entry_uint(ne, &entry, 0, &v) && v == 6, "inline value");
+
+    r = nanoexif_index_find(idx, NANOEXIF_IFD_EXIF, 0x9003);
+    ok(r && r->count == 20 && memcmp(ne->buf + r->value_offset, "2010:01:13 10:34:35", 20) == 0, "DateTimeOriginal");
+    nanoexif_index_entry(idx, r, &entry);
+    char * s = nanoexif_get_ifd_entry_data_ascii(ne, &entry);
+    ok(s && strcmp(s, "2010:01:13 10:34:35") == 0, "out of line value");
+    free(s);
+
+    r = nanoexif_index_find(idx, NANOEXIF_IFD_1, NANOEXIF_TAG_COMPRESSION);
+    nanoexif_index_entry(idx, r, &entry);
+    ok(r && nanoexif_get_ifd_entry_uint(ne, &entry, 0, &v) && v == 6, "IFD1");
+
+    r = nanoexif_index_find(idx, NANOEXIF_IFD_GPS, 0x0002);
+    ok(r && r->type == NANOEXIF_TYPE_RATIONAL && r->count == 3, "GPSLatitude");
+
+    ok(nanoexif_index_find(idx, NANOEXIF_IFD_0, 0x9003) == NULL, "other ifd");
+    ok(nanoexif_index_find(idx, NANOEXIF_IFD_INTEROP, 0x0001) == NULL, "no interop");
+    ok(nanoexif_index_find(idx, NANOEXIF_IFD_0, 0x0000) == NULL, "before the first");
+    ok(nanoexif_index_find(idx, NANOEXIF_IFD_INTEROP, 0xFFFF) == NULL, "after the last");
+
+    nanoexif_index_free(idx);
+    nanoexif_free(ne);
+
+    // duplicated tags, the values not in the order of the entries
+    {
+        uint8_t tiff[8 + 2 + 12*3 + 4 + 12 + 8];
+        memset(tiff, 0, sizeof(tiff));
+        memcpy(tiff, "II\x2A\x00", 4);
+        put32(tiff+4, 8);
+        put16(tiff+8, 3);
+        put_entry(tiff+10, 0x9999, NANOEXIF_TYPE_LONG, 2, 62);
+        put_entry(tiff+22, 0x9999, NANOEXIF_TYPE_LONG, 3, 50);
+        put_entry(tiff+34, 0x9999, NANOEXIF_TYPE_LONG, 1, 7);
+        ne = nanoexif_init_tiff(tiff, sizeof(tiff), &ifd0_offset);
+        assert(ne);
+        idx = nanoexif_index_build(ne, ifd0_offset);
+        r = nanoexif_index_find(idx, NANOEXIF_IFD_0, 0x9999);
+        ok(r && r->count == 2, "the first one in the file");
+        ok(idx->n == 3 && idx->records[1].count == 3 && idx->records[2].count == 1, "file order");
+        nanoexif_index_free(idx);
+        nanoexif_free(ne);
+    }
+
+    done_testing();
+}
@@ -0,0 +1,93 @@
+#define _POSIX_C_SOURCE 200809L
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <nanoexif.h>
+
+static uint16_t orientation(nanoexif * ne, uint32_t ifd0_offset) {
+    nanoexif_tag_key key = { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION };
+    nanoexif_query_result res;
+    uint32_t v = 0;
+    if (nanoexif_query(ne, ifd0_offset, &key, 1, &res)) {
+        nanoexif_get_ifd_entry_uint(ne, &res.entry, 0, &v);
+    }
+    return v;
+}
+
+/* the sample with a 100KB APP2 segment before the APP1 */
+static const char * make_padded(void) {
+    static char path[] = "/tmp/nanoexif-14-XXXXXX";
+    int out = mkstemp(path);
+    assert(out >= 0);
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    static uint8_t data[1<<20];
+    size_t len = fread(data, 1, sizeof(data), fp);
+    fclose(fp);
+
+    size_t i;
+    ssize_t n = write(out, data, 2);
+    assert(n == 2);
+    for (i=0; i<2; i++) {
+        uint8_t seg[4+50000-2] = { 0xFF, 0xE2, 50000>>8, 50000&0xff };
+        n = write(out, seg, sizeof(seg));
+        assert(n == (ssize_t)sizeof(seg));
+    }
+    n = write(out, data+2, len-2);
+    assert(n == (ssize_t)(len-2));
+    (void)n;
+    close(out);
+    return path;
+}
+
+int main(int argc, char **argv) {
+    int fd = open("t/data/sample-iphone.jpg", O_RDONLY);
+    assert(fd >= 0);
+
+    uint32_t ifd0_offset;
+    nanoexif_read_stats stats;
+    nanoexif * ne = nanoexif_init_fd(fd, 0, &ifd0_offset, &stats);
+    ok(ne != NULL, "init_fd");
+    ok(ifd0_offset == 8, "ifd0_offset");
+    ok(orientation(ne, ifd0_offset) == 6, "orientation");
+    ok(stats.syscalls == 1, "one read");
+    ok(stats.bytes == NANOEXIF_PREFIX_SIZE, "prefix bytes");
+    ok(lseek(fd, 0, SEEK_CUR) == 0, "file offset unchanged");
+    nanoexif_free(ne);
+
+    // a prefix shorter than the APP1 needs one more read
+    ne = nanoexif_init_fd(fd, 64, &ifd0_offset, &stats);
+    ok(ne != NULL && orientation(ne, ifd0_offset) == 6, "short prefix");
+    ok(stats.syscalls == 2, "second read");
+    nanoexif_free(ne);
+
+    nanoexif_ctx * ctx = nanoexif_ctx_new();
+    ne = nanoexif_reset_fd(ctx, fd, 0, &ifd0_offset, NULL);
+    ok(ne == &ctx->ne && orientation(ne, ifd0_offset) == 6, "reset_fd");
+    close(fd);
+
+    // segments larger than the prefix before APP1
+    const char * path = make_padded();
+    fd = open(path, O_RDONLY);
+    assert(fd >= 0);
+    ne = nanoexif_init_fd(fd, 0, &ifd0_offset, &stats);
+    ok(ne != NULL && orientation(ne, ifd0_offset) == 6, "APP1 past the prefix");
+    ok(stats.syscalls == 3, "prefix, next marker, APP1");
+    nanoexif_free(ne);
+    ne = nanoexif_reset_fd(ctx, fd, 0, &ifd0_offset, &stats);
+    ok(ne != NULL && orientation(ne, ifd0_offset) == 6, "reset_fd past the prefix");
+    close(fd);
+    unlink(path);
+
+    fd = open("t/14_fd.c", O_RDONLY);
+    ok(nanoexif_init_fd(fd, 0, &ifd0_offset, NULL) == NULL, "not a jpeg");
+    ok(nanoexif_reset_fd(ctx, fd, 0, &ifd0_offset, NULL) == NULL, "not a jpeg with ctx");
+    close(fd);
+
+    nanoexif_ctx_free(ctx);
+    done_testing();
+}
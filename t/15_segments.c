@@ -0,0 +1,63 @@
+#include "nanotap.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <nanoexif.h>
+#include <nanoexif-segments.h>
+
+int main(int argc, char **argv) {
+    static uint8_t data[1<<20];
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    size_t len = fread(data, 1, sizeof(data), fp);
+    fclose(fp);
+
+    nanoexif_segment segs[16];
+    nanoexif_segments_status status;
+    size_t n = nanoexif_segments(data, len, segs, 16, &status);
+    ok(n == 5 && status == NANOEXIF_SEGMENTS_COMPLETE, "5 segments to SOS");
+    ok(segs[0].marker == 0xE1 && segs[0].offset == 2 && segs[0].length == 14219, "APP1");
+    ok(nanoexif_segment_identify(data, &segs[0]) == NANOEXIF_SEG_EXIF, "exif");
+    ok(nanoexif_segment_identify(data, &segs[1]) == NANOEXIF_SEG_DQT, "DQT");
+    ok(nanoexif_segment_identify(data, &segs[3]) == NANOEXIF_SEG_DHT, "DHT");
+    ok(nanoexif_segment_identify(data, &segs[4]) == NANOEXIF_SEG_SOS && segs[4].offset == 14796, "SOS");
+
+    uint16_t width, height;
+    uint8_t components;
+    ok(nanoexif_sof_dimensions(data, &segs[2], &width, &height, &components), "SOF");
+    ok(width == 2048 && height == 1536 && components == 3, "dimensions");
+    ok(!nanoexif_sof_dimensions(data, &segs[1], &width, &height, NULL), "DQT is not SOF");
+
+    // the exif segment is what nanoexif_init_from_memory() reads
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init_from_memory(data, segs[0].offset + 2 + segs[0].length, &ifd0_offset);
+    ok(ne != NULL, "exif in the APP1");
+    nanoexif_free(ne);
+
+    ok(nanoexif_segments(data, len, segs, 2, NULL) == 5, "count beyond cap");
+    ok(nanoexif_segments(data, 14300, segs, 16, &status) == 1 && status == NANOEXIF_SEGMENTS_MORE, "cut in the header");
+    ok(nanoexif_segments((const uint8_t *)"GIF89a", 6, segs, 16, &status) == 0 && status == NANOEXIF_SEGMENTS_STOPPED, "not a jpeg");
+    ok(nanoexif_segments(data, 1, segs, 16, &status) == 0 && status == NANOEXIF_SEGMENTS_MORE, "half of SOI");
+    ok(nanoexif_segments((const uint8_t *)"\xFF\xD8\xFF\xD9", 4, segs, 16, &status) == 0 && status == NANOEXIF_SEGMENTS_STOPPED, "EOI");
+    ok(nanoexif_segments((const uint8_t *)"\xFF\xD8\xFF\xE1\x00\x01", 6, segs, 16, &status) == 0 && status == NANOEXIF_SEGMENTS_STOPPED, "broken length");
+
+    // JFIF, XMP, ICC, IPTC with fill bytes
+    const uint8_t head[] =
+        "\xFF\xD8"
+        "\xFF\xE0\x00\x07" "JFIF\0"
+        "\xFF\xFF"
+        "\xFF\xE1\x00\x22" "http://ns.adobe.com/xap/1.0/\0<x>"
+        "\xFF\xE2\x00\x10" "ICC_PROFILE\0\x01\x01"
+        "\xFF\xED\x00\x11" "Photoshop 3.0\0\x00"
+        "\xFF\xC2\x00\x0B\x08\x00\x10\x00\x20\x01\x01\x11\x00"
+        "\xFF\xDA\x00\x08\x01\x01\x00\x00\x3F\x00";
+    n = nanoexif_segments(head, sizeof(head)-1, segs, 16, &status);
+    ok(n == 6 && status == NANOEXIF_SEGMENTS_COMPLETE, "6 segments");
+    ok(nanoexif_segment_identify(head, &segs[0]) == NANOEXIF_SEG_JFIF, "JFIF");
+    ok(nanoexif_segment_identify(head, &segs[1]) == NANOEXIF_SEG_XMP, "XMP");
+    ok(nanoexif_segment_identify(head, &segs[2]) == NANOEXIF_SEG_ICC, "ICC");
+    ok(nanoexif_segment_identify(head, &segs[3]) == NANOEXIF_SEG_IPTC, "IPTC");
+    ok(nanoexif_sof_dimensions(head, &segs[4], &width, &height, NULL) && width == 32 && height == 16, "progressive SOF");
+
+    done_testing();
+}
@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
+#include "nanotap.h"
+#include "raw.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <nanoexif.h>
+
+int main(int argc, char **argv) {
+    // bare tiff on memory: the payload of the sample's APP1
+    {
+        static uint8_t data[1<<20];
+        FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+        assert(fp);
+        size_t len = fread(data, 1, sizeof(data), fp);
+        fclose(fp);
+
+        uint32_t ifd0_offset;
+        nanoexif * ne = nanoexif_init_tiff(data+12, 14219-8, &ifd0_offset);
+        ok(ne != NULL && ifd0_offset == 8, "init_tiff");
+        nanoexif_tag_key key = { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION };
+        nanoexif_query_result res;
+        uint32_t v;
+        ok(ne && nanoexif_query(ne, ifd0_offset, &key, 1, &res) && nanoexif_get_ifd_entry_uint(ne, &res.entry, 0, &v) && v == 6, "orientation");
+        nanoexif_free(ne);
+        ok(nanoexif_init_tiff(data, len, &ifd0_offset) == NULL, "jpeg is not tiff");
+    }
+
+    char raw[] = "/tmp/nanoexif-16-XXXXXX";
+    const char * path = make_raw(raw);
+    int fd = open(path, O_RDONLY);
+    assert(fd >= 0);
+
+    uint32_t ifd0_offset;
+    nanoexif_read_stats stats;
+    nanoexif * ne = nanoexif_init_tiff_fd(fd, 4096, &ifd0_offset, &stats);
+    ok(ne != NULL, "init_tiff_fd");
+    ok(stats.syscalls == 1 && stats.bytes == 4096, "prefix only");
+
+    // read_ifd takes offsets past 64KB
+    uint32_t next;
+    uint16_t cnt;
+    nanoexif_ifd_entry * entries = nanoexif_read_ifd(ne, 20*MB, &next, &cnt);
+    ok(entries && cnt == 1 && entries[0].tag == 0x9003, "read_ifd far away");
+    char * s = entries ? nanoexif_get_ifd_entry_data_ascii(ne, &entries[0]) : NULL;
+    ok(s && strcmp(s, "2011:02:03 04:05:06") == 0, "value near the ifd");
+    free(s);
+    free(entries);
+
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    int n = 0, ifd1 = 0;
+    char * make = NULL;
+    nanoexif_walker_init(&w, ne, ifd0_offset);
+    while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) {
+        n++;
+        if (w.kind == NANOEXIF_IFD_1) { ifd1++; }
+        if (entry.tag == NANOEXIF_TAG_MAKE) { make = nanoexif_get_ifd_entry_data_ascii(ne, &entry); }
+    }
+    ok(n == 8 && ifd1 == 1, "walk every ifd");
+    ok(make && memcmp(make, "NIKON CORP", 10) == 0, "make");
+    free(make);
+
+    nanoexif_io_stats(ne, &stats);
+    ok(stats.syscalls == 5, "one read per place");
+    ok(stats.bytes <= 6*4096, "kilobytes, not megabytes");
+
+    // out of the file
+    nanoexif_ifd_entry bogus = { NANOEXIF_TAG_MAKE, NANOEXIF_TYPE_ASCII, 100, { 0, 0, 0x80, 0x02 } };
+    ok(nanoexif_get_ifd_entry_data_ascii(ne, &bogus) == NULL, "past the end of file");
+    nanoexif_free(ne);
+
+    ne = nanoexif_init_tiff_fd(fd, 0, &ifd0_offset, &stats);
+    ok(ne != NULL && stats.bytes == NANOEXIF_PREFIX_SIZE, "default prefix");
+    nanoexif_free(ne);
+    close(fd);
+    unlink(path);
+
+    fd = open("t/data/sample-iphone.jpg", O_RDONLY);
+    ok(nanoexif_init_tiff_fd(fd, 0, &ifd0_offset, NULL) == NULL, "jpeg is not tiff");
+    close(fd);
+
+    done_testing();
+}
@@ -0,0 +1,108 @@
+#define _POSIX_C_SOURCE 200809L
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <nanoexif.h>
+#include <nanoexif-patch.h>
+
+static uint8_t orig[1<<20];
+static size_t orig_len;
+
+static bool get_uint(nanoexif * ne, uint32_t ifd0_offset, nanoexif_ifd_kind ifd, uint16_t tag, uint32_t i, uint32_t * v) {
+    nanoexif_tag_key key = { ifd, tag };
+    nanoexif_query_result res;
+    return nanoexif_query(ne, ifd0_offset, &key, 1, &res) && nanoexif_get_ifd_entry_uint(ne, &res.entry, i, v);
+}
+
+static bool get_double(nanoexif * ne, uint32_t ifd0_offset, nanoexif_ifd_kind ifd, uint16_t tag, double * v) {
+    nanoexif_tag_key key = { ifd, tag };
+    nanoexif_query_result res;
+    return nanoexif_query(ne, ifd0_offset, &key, 1, &res) && nanoexif_get_ifd_entry_double(ne, &res.entry, 0, v);
+}
+
+static const char * write_tmp(const uint8_t * data, size_t len) {
+    static char path[32];
+    strcpy(path, "/tmp/nanoexif-17-XXXXXX");
+    int out = mkstemp(path);
+    assert(out >= 0);
+    ssize_t n = write(out, data, len);
+    assert(n == (ssize_t)len);
+    (void)n;
+    close(out);
+    return path;
+}
+
+static size_t changed_bytes(const uint8_t * a, const uint8_t * b, size_t len) {
+    size_t i, n = 0;
+    for (i=0; i<len; i++) {
+        if (a[i] != b[i]) { n++; }
+    }
+    return n;
+}
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    orig_len = fread(orig, 1, sizeof(orig), fp);
+    fclose(fp);
+
+    // jpeg file
+    const char * path = write_tmp(orig, orig_len);
+    int fd = open(path, O_RDWR);
+    assert(fd >= 0);
+    ok(nanoexif_patch_short(fd, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION, 1), "patch orientation");
+    ok(nanoexif_patch_long(fd, NANOEXIF_IFD_EXIF, 0xA002, 1024), "patch ExifImageWidth");
+    ok(nanoexif_patch_rational(fd, NANOEXIF_IFD_EXIF, 0x829D, 28, 10), "patch FNumber");
+    ok(!nanoexif_patch_long(fd, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION, 1), "type mismatch");
+    ok(!nanoexif_patch_short(fd, NANOEXIF_IFD_INTEROP, 0x0001, 1), "missing tag");
+    ok(lseek(fd, 0, SEEK_CUR) == 0, "file offset unchanged");
+
+    uint32_t ifd0_offset, v;
+    double d;
+    nanoexif * ne = nanoexif_init_fd(fd, 0, &ifd0_offset, NULL);
+    ok(ne != NULL, "reopen");
+    ok(get_uint(ne, ifd0_offset, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION, 0, &v) && v == 1, "orientation");
+    ok(get_uint(ne, ifd0_offset, NANOEXIF_IFD_EXIF, 0xA002, 0, &v) && v == 1024, "ExifImageWidth");
+    ok(get_double(ne, ifd0_offset, NANOEXIF_IFD_EXIF, 0x829D, &d) && d == 2.8, "FNumber");
+    ok(get_uint(ne, ifd0_offset, NANOEXIF_IFD_1, NANOEXIF_TAG_COMPRESSION, 0, &v) && v == 6, "other tags kept");
+    nanoexif_free(ne);
+
+    static uint8_t patched[1<<20];
+    ok(pread(fd, patched, orig_len+1, 0) == (ssize_t)orig_len, "size unchanged");
+    // 6 -> 1 is one byte, 2048 -> 1024 is one byte, the rational changes in both words
+    size_t n = changed_bytes(orig, patched, orig_len);
+    ok(n >= 3 && n <= 2+4+8, "only the values changed");
+    close(fd);
+    unlink(path);
+
+    // memory
+    static uint8_t data[1<<20];
+    memcpy(data, orig, orig_len);
+    ok(nanoexif_patch_short_memory(data, orig_len, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION, 3), "patch memory");
+    ok(changed_bytes(orig, data, orig_len) == 1, "one byte changed");
+    ne = nanoexif_init_from_memory(data, orig_len, &ifd0_offset);
+    ok(get_uint(ne, ifd0_offset, NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION, 0, &v) && v == 3, "orientation in memory");
+    nanoexif_free(ne);
+
+    // bare tiff: the sample's tiff data starts at 12
+    const uint8_t * tiff = orig + 12;
+    size_t tiff_len = 14219 - 8;
+    memcpy(data, tiff, tiff_len);
+    ok(nanoexif_patch_rational_memory(data, tiff_len, NANOEXIF_IFD_0, 0x011A, 300, 4), "patch tiff memory");
+    path = write_tmp(tiff, tiff_len);
+    fd = open(path, O_RDWR);
+    assert(fd >= 0);
+    ok(nanoexif_patch_rational(fd, NANOEXIF_IFD_0, 0x011A, 300, 4), "patch tiff file");
+    ok(pread(fd, patched, tiff_len, 0) == (ssize_t)tiff_len && memcmp(patched, data, tiff_len) == 0, "same bytes");
+    ne = nanoexif_init_tiff(data, tiff_len, &ifd0_offset);
+    ok(get_double(ne, ifd0_offset, NANOEXIF_IFD_0, 0x011A, &d) && d == 75, "XResolution");
+    nanoexif_free(ne);
+    close(fd);
+    unlink(path);
+
+    done_testing();
+}
@@ -0,0 +1,92 @@
+#define _POSIX_C_SOURCE 200809L
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <nanoexif.h>
+#include <nanoexif-segments.h>
+#include <nanoexif-strip.h>
+
+static uint8_t orig[1<<21];
+static size_t orig_len;
+
+static size_t strip_to_file(int in, uint32_t keep, uint8_t * out, size_t cap) {
+    char path[] = "/tmp/nanoexif-18-XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    unlink(path);
+    ok(nanoexif_strip(in, fd, keep), "strip to file");
+    ssize_t n = pread(fd, out, cap, 0);
+    close(fd);
+    return n < 0 ? 0 : n;
+}
+
+static bool has_kind(const uint8_t * data, size_t len, nanoexif_segment_kind kind) {
+    nanoexif_segment segs[32];
+    size_t i, n = nanoexif_segments(data, len, segs, 32, NULL);
+    for (i=0; i<n && i<32; i++) {
+        if (nanoexif_segment_identify(data, &segs[i]) == kind) { return true; }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    orig_len = fread(orig, 1, sizeof(orig), fp);
+    fclose(fp);
+    int in = open("t/data/sample-iphone.jpg", O_RDONLY);
+    assert(in >= 0);
+
+    // the sample's header is APP1(exif) DQT SOF0 DHT SOS; APP1 is 2+14219 bytes.
+    static uint8_t out[1<<21];
+    size_t len = strip_to_file(in, NANOEXIF_STRIP_DEFAULT, out, sizeof(out));
+    ok(len == orig_len - (2+14219), "APP1 dropped");
+    ok(!has_kind(out, len, NANOEXIF_SEG_EXIF), "no exif");
+    ok(has_kind(out, len, NANOEXIF_SEG_SOF) && has_kind(out, len, NANOEXIF_SEG_SOS), "image segments kept");
+    ok(memcmp(out, "\xFF\xD8", 2) == 0 && memcmp(out+2, orig+2+2+14219, len-2) == 0, "the rest is the same");
+    uint32_t ifd0_offset;
+    ok(nanoexif_init_from_memory(out, len, &ifd0_offset) == NULL, "no exif to read");
+    ok(lseek(in, 0, SEEK_CUR) == 0, "file offset unchanged");
+
+    len = strip_to_file(in, NANOEXIF_STRIP_DEFAULT | NANOEXIF_STRIP_KEEP(NANOEXIF_SEG_EXIF), out, sizeof(out));
+    ok(len == orig_len && memcmp(out, orig, len) == 0, "keep exif");
+
+    // pipes have no copy_file_range; the scan data goes by sendfile or read/write
+    int p[2];
+    int rc = pipe(p);
+    assert(rc == 0);
+    (void)rc;
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        close(p[0]);
+        _exit(nanoexif_strip(in, p[1], NANOEXIF_STRIP_DEFAULT) ? 0 : 1);
+    }
+    close(p[1]);
+    size_t got = 0;
+    ssize_t r;
+    while ((r = read(p[0], out+got, sizeof(out)-got)) > 0) { got += r; }
+    close(p[0]);
+    int status;
+    ok(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "strip to pipe");
+    ok(got == orig_len - (2+14219), "pipe output");
+
+    // not a jpeg
+    char path[] = "/tmp/nanoexif-18-XXXXXX";
+    int bad = mkstemp(path);
+    assert(bad >= 0);
+    unlink(path);
+    ssize_t n = write(bad, orig+12, 1000);
+    assert(n == 1000);
+    (void)n;
+    ok(!nanoexif_strip(bad, bad, NANOEXIF_STRIP_DEFAULT), "not a jpeg");
+    close(bad);
+
+    close(in);
+    done_testing();
+}
@@ -0,0 +1,104 @@
+#define _POSIX_C_SOURCE 200809L
+#include "nanotap.h"
+#include "raw.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <nanoexif.h>
+#include <nanoexif-io.h>
+
+static uint16_t orientation(nanoexif * ne, uint32_t ifd0_offset) {
+    nanoexif_tag_key key = { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION };
+    nanoexif_query_result res;
+    uint32_t v = 0;
+    if (nanoexif_query(ne, ifd0_offset, &key, 1, &res)) {
+        nanoexif_get_ifd_entry_uint(ne, &res.entry, 0, &v);
+    }
+    return v;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    int fd = open("t/data/sample-iphone.jpg", O_RDONLY);
+    assert(fd >= 0);
+    nanoexif_file_io f;
+    uint32_t ifd0_offset;
+    nanoexif_read_stats stats;
+
+    // jpeg: the header window holds the APP1
+    nanoexif_file_io_init(&f, fd, 0);
+    nanoexif * ne = nanoexif_init_io(&f.io, 0, &ifd0_offset, &stats);
+    ok(ne != NULL && orientation(ne, ifd0_offset) == 6, "jpeg");
+    ok(f.calls == 1 && stats.syscalls == 1, "one round trip");
+    ok(stats.bytes == f.bytes, "bytes");
+    nanoexif_free(ne);
+
+    // a small window: the rest of the APP1 in one more call
+    nanoexif_file_io_init(&f, fd, 0);
+    ne = nanoexif_init_io(&f.io, 64, &ifd0_offset, &stats);
+    ok(ne != NULL && orientation(ne, ifd0_offset) == 6, "small window");
+    ok(f.calls == 2, "two round trips");
+    nanoexif_free(ne);
+
+    // latency
+    nanoexif_file_io_init(&f, fd, 20000);
+    double start = now();
+    ne = nanoexif_init_io(&f.io, 64, &ifd0_offset, NULL);
+    ok(ne != NULL && now() - start >= 0.04, "latency per call");
+    nanoexif_free(ne);
+    close(fd);
+
+    // tiff, read on demand
+    char raw[] = "/tmp/nanoexif-19-XXXXXX";
+    const char * path = make_raw(raw);
+    fd = open(path, O_RDONLY);
+    assert(fd >= 0);
+    nanoexif_file_io_init(&f, fd, 0);
+    ne = nanoexif_init_io(&f.io, 4096, &ifd0_offset, &stats);
+    ok(ne != NULL && ifd0_offset == 8, "tiff");
+    ok(orientation(ne, ifd0_offset) == 3 && f.calls == 1, "query reads no values it does not need");
+
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    int n = 0;
+    nanoexif_walker_init(&w, ne, ifd0_offset);
+    while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) {
+        n++;
+    }
+    ok(n == 8, "walk");
+    // one read for each of 8MB(with 8MB+4000 merged into it), 16MB, the Exif IFD and IFD1
+    ok(f.calls == 5, "window + merged ranges");
+
+    char * s;
+    uint32_t next;
+    uint16_t cnt;
+    nanoexif_ifd_entry * entries = nanoexif_read_ifd(ne, ifd0_offset, &next, &cnt);
+    ok(entries && cnt == 6, "read_ifd");
+    s = nanoexif_get_ifd_entry_data_ascii(ne, &entries[1]);
+    ok(s && memcmp(s, "NIKON CORP", 10) == 0, "make");
+    free(s);
+    s = nanoexif_get_ifd_entry_data_ascii(ne, &entries[2]);
+    ok(s && strcmp(s, "D90") == 0, "model");
+    free(s);
+    s = nanoexif_get_ifd_entry_data_ascii(ne, &entries[4]);
+    ok(s && strcmp(s, "Alice") == 0, "artist");
+    free(s);
+    free(entries);
+    ok(f.calls == 5, "no more reads");
+    nanoexif_io_stats(ne, &stats);
+    ok(stats.syscalls == f.calls && stats.bytes == f.bytes, "io stats");
+    nanoexif_free(ne);
+    close(fd);
+    unlink(path);
+
+    done_testing();
+}
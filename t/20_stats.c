@@ -0,0 +1,129 @@
+/* the counters are compiled in only with NANOEXIF_STATS, so this test builds nanoexif.c itself. */
+#ifndef NANOEXIF_STATS
+#define NANOEXIF_STATS
+#endif
+#include "../src/nanoexif.c"
+#include "nanotap.h"
+
+static uint8_t * slurp(const char *path, size_t *len) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) { return NULL; }
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8_t *buf = malloc(*len);
+    if (buf && fread(buf, 1, *len, fp) != *len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+}
+
+static bool find_tag(nanoexif_ifd_entry *entries, uint16_t cnt, uint16_t tag, nanoexif_ifd_entry *found) {
+    uint16_t i;
+    for (i=0; i<cnt; i++) {
+        if (entries[i].tag == tag) {
+            *found = entries[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+int main() {
+    nanoexif_stats s, p;
+    nanoexif_process_stats_reset();
+    ok(nanoexif_process_stats(&p), "built in");
+    ok(p.reads == 0 && p.bytes_read == 0, "reset process counters");
+
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    uint32_t ifd_offset;
+    nanoexif *ne = nanoexif_init(fp, &ifd_offset);
+    ok(!!ne, "init");
+    ok(nanoexif_handle_stats(ne, &s), "handle stats");
+    /* SOI, the APP1 marker, the exif header and the body */
+    ok(s.reads == 4, "reads");
+    ok(s.bytes_read == 2 + 4 + 14219 - 2, "bytes read");
+    ok(s.seeks == 0 && s.markers_skipped == 0, "APP1 comes first");
+    ok(s.allocs == 2, "the buffer and the handle");
+    ok(s.ns_load > 0, "load time");
+    ok(s.ifds_visited == 0 && s.entries_decoded == 0, "nothing walked yet");
+
+    uint32_t next;
+    uint16_t cnt;
+    nanoexif_ifd_entry *entries = nanoexif_read_ifd(ne, ifd_offset, &next, &cnt);
+    ok(!!entries, "read ifd");
+    nanoexif_handle_stats(ne, &s);
+    ok(s.ifds_visited == 1, "ifds visited");
+    ok(s.entries_decoded == cnt, "entries decoded");
+    ok(s.allocs == 3, "entries allocated");
+    ok(s.ns_walk > 0, "walk time");
+
+    nanoexif_ifd_entry orientation;
+    ok(find_tag(entries, cnt, NANOEXIF_TAG_ORIENTATION, &orientation), "orientation");
+    uint16_t *v = nanoexif_get_ifd_entry_data_short(ne, &orientation);
+    ok(v && v[0] == 6, "get short");
+    nanoexif_handle_stats(ne, &s);
+    ok(s.swapped_bytes == (NANOEXIF_MACHINE_ENDIAN == NANOEXIF_BIG_ENDIAN ? 0 : 2), "swapped bytes");
+    ok(s.allocs == 4 && s.alloc_bytes >= 2, "value allocated");
+    free(v);
+    free(entries);
+
+    nanoexif_process_stats(&p);
+    ok(p.reads == s.reads && p.bytes_read == s.bytes_read && p.entries_decoded == s.entries_decoded, "process has the handle's");
+    nanoexif_free(ne);
+    fclose(fp);
+
+    /* a JFIF segment before APP1 */
+    size_t len;
+    uint8_t *file = slurp("t/data/sample-iphone.jpg", &len);
+    assert(file);
+    uint8_t *jfif = malloc(len + 18);
+    assert(jfif);
+    memcpy(jfif, file, 2);
+    memcpy(jfif+2, "\xFF\xE0\x00\x10JFIF\0\x01\x01\0\0\x01\0\x01\0\0", 18);
+    memcpy(jfif+20, file+2, len-2);
+    ne = nanoexif_init_from_memory(jfif, len+18, &ifd_offset);
+    ok(!!ne, "init from memory");
+    nanoexif_handle_stats(ne, &s);
+    ok(s.markers_skipped == 1, "markers skipped");
+    ok(s.reads == 0 && s.bytes_read == 0, "nothing read");
+
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    uint64_t n = 0;
+    nanoexif_walker_init(&w, ne, ifd_offset);
+    while (nanoexif_walker_next(&w, &entry) == NANOEXIF_WALK_ENTRY) { n++; }
+    nanoexif_handle_stats(ne, &s);
+    ok(s.entries_decoded == n, "walker entries");
+    ok(s.ifds_visited == (uint64_t)w.nvisited, "walker ifds");
+    ok(s.allocs == 1, "the walker does not allocate");
+    nanoexif_free(ne);
+
+    nanoexif_process_stats(&p);
+    ok(p.markers_skipped == 1 && p.reads == 4, "process keeps the freed handles'");
+
+    /* the context counts from zero for each file */
+    nanoexif_ctx *ctx = nanoexif_ctx_new();
+    int i;
+    for (i=0; i<2; i++) {
+        fp = fopen("t/data/sample-iphone.jpg", "rb");
+        ne = nanoexif_reset(ctx, fp, &ifd_offset);
+        ok(!!ne, "reset");
+        nanoexif_ctx_read_ifd(ctx, ifd_offset, &next, &cnt);
+        nanoexif_handle_stats(ne, &s);
+        ok(s.reads == 4 && s.ifds_visited == 1, "per file counts");
+        fclose(fp);
+    }
+    nanoexif_ctx_free(ctx);
+
+    nanoexif_process_stats_reset();
+    nanoexif_process_stats(&p);
+    ok(p.reads == 0 && p.ifds_visited == 0 && p.ns_load == 0, "reset again");
+
+    free(jfif);
+    free(file);
+    done_testing();
+}
@@ -0,0 +1,126 @@
+#include "nanotap.h"
+#include "fixture.h"
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <nanoexif.hpp>
+
+using nanoexifpp::Exif;
+using nanoexifpp::Entry;
+using nanoexifpp::Errc;
+
+static_assert(!std::is_copy_constructible<Exif>::value, "move only");
+static_assert(std::is_nothrow_move_constructible<Exif>::value, "move only");
+static_assert(std::is_trivially_copyable<nanoexifpp::Values<uint16_t>>::value, "views are plain pointers");
+static_assert(std::is_trivially_copyable<Entry>::value, "entries are plain values");
+
+int main() {
+    // the sample is big endian
+    {
+        FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+        assert(fp);
+        nanoexifpp::Result<Exif> opened = Exif::open(fp);
+        ok(opened.has_value(), "open");
+        Exif exif = std::move(*opened);
+        ok(!!exif && !opened->get(), "moved");
+
+        auto orientation = exif.find(NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION);
+        ok(orientation && orientation->count() == 1, "find");
+        auto shorts = exif.values<uint16_t>(*orientation);
+        ok(shorts && shorts->size() == 1 && (*shorts)[0] == 6, "values<uint16_t>");
+        ok(exif.values<uint32_t>(*orientation).error() == Errc::type_mismatch, "type mismatch");
+        ok(exif.uint(*orientation).value_or(0) == 6, "uint");
+        ok(exif.uint(*orientation, 1).error() == Errc::out_of_range, "out of count");
+
+        auto make = exif.find(NANOEXIF_IFD_0, NANOEXIF_TAG_MAKE);
+        auto s = exif.ascii(*make);
+        ok(s && *s == "Apple", "ascii");
+        ok(s->data() >= reinterpret_cast<const char *>(exif.get()->buf) &&
+           s->data() < reinterpret_cast<const char *>(exif.get()->buf + exif.get()->len), "points into APP1");
+
+        auto xres = exif.find(NANOEXIF_IFD_0, 0x011A);
+        auto r = exif.values<nanoexifpp::Rational>(*xres);
+        ok(r && r->front().num == 72 && r->front().den == 1, "rational");
+        ok(exif.real(*xres).value_or(0) == 72.0, "real");
+
+        auto width = exif.find(NANOEXIF_IFD_EXIF, 0xA002);
+        ok(width && width->ifd() == NANOEXIF_IFD_EXIF, "exif ifd");
+        ok(exif.values<uint32_t>(*width)->front() == 2048, "values<uint32_t>");
+        auto raw = exif.bytes(*width);
+        ok(raw && raw->size() == 4 && memcmp(raw->data(), "\x00\x00\x08\x00", 4) == 0, "bytes in the file's endian");
+
+        ok(exif.find(NANOEXIF_IFD_GPS, 0x9999).error() == Errc::not_found, "not found");
+
+        // same entries as the C walker
+        nanoexif_walker w;
+        nanoexif_ifd_entry e;
+        size_t n = 0;
+        nanoexif_walker_init(&w, exif.get(), exif.ifd0_offset());
+        while (nanoexif_walker_next(&w, &e) == NANOEXIF_WALK_ENTRY) { n++; }
+        size_t m = 0, ifd1 = 0;
+        bool found = false;
+        auto entries = exif.entries();
+        for (const Entry & entry : entries) {
+            m++;
+            if (entry.ifd() == NANOEXIF_IFD_1) { ifd1++; }
+            if (entry.tag() == NANOEXIF_TAG_ORIENTATION && entry.ifd() == NANOEXIF_IFD_0) {
+                found = entry.offset() == orientation->offset();
+            }
+        }
+        ok(m == n && ifd1 > 0, "entries");
+        ok(found, "entry offset");
+        ok(!entries.broken(), "not broken");
+
+        // the small value is read in place, not from the copy
+        Entry copy = *orientation;
+        memset(copy.raw().offset, 0xFF, 4);
+        ok(exif.values<uint16_t>(copy)->front() == 6, "small values point into APP1");
+
+        Exif other;
+        other = std::move(exif);
+        ok(!exif && !!other, "move assign");
+        fclose(fp);
+    }
+
+    // little endian tiff, with the values out of the entry
+    {
+        uint8_t tiff[8 + 2 + 12*3 + 4 + 6 + 8];
+        memcpy(tiff, "II\x2A\x00", 4);
+        put32(tiff+4, 8);
+        put16(tiff+8, 3);
+        put_entry(tiff+10, 0x0102, NANOEXIF_TYPE_SHORT, 3, 50);
+        put_entry(tiff+22, 0x9201, NANOEXIF_TYPE_SRATIONAL, 1, 56);
+        put_entry(tiff+34, 0x9999, NANOEXIF_TYPE_SSHORT, 2, 0);
+        put16(tiff+34+8, 0xFFFE);
+        put16(tiff+34+10, 3);
+        put32(tiff+46, 0);
+        put16(tiff+50, 8); put16(tiff+52, 16); put16(tiff+54, 0x1234);
+        put32(tiff+56, (uint32_t)-3); put32(tiff+60, 2);
+
+        auto exif = Exif::from_tiff(tiff, sizeof(tiff));
+        ok(exif.has_value(), "from tiff");
+        auto bps = exif->values<uint16_t>(*exif->find(NANOEXIF_IFD_0, 0x0102));
+        ok(bps && bps->size() == 3 && bps->data() == tiff+50, "out of line");
+        uint32_t sum = 0;
+        for (uint16_t v : *bps) { sum += v; }
+        ok(sum == 8 + 16 + 0x1234, "iterate");
+        ok(bps->end() - bps->begin() == 3 && bps->begin()[2] == 0x1234, "random access");
+
+        auto sr = exif->values<nanoexifpp::SRational>(*exif->find(NANOEXIF_IFD_0, 0x9201));
+        ok(sr && sr->front().num == -3 && sr->front().to_double() == -1.5, "srational");
+        auto ss = exif->values<int16_t>(*exif->find(NANOEXIF_IFD_0, 0x9999));
+        ok(ss && (*ss)[0] == -2 && (*ss)[1] == 3, "sshort");
+        ok(ss->at(2).error() == Errc::out_of_range, "at");
+    }
+
+    {
+        static const uint8_t junk[] = "not a jpeg";
+        auto exif = Exif::from_memory(junk, sizeof(junk));
+        ok(!exif && exif.error() == Errc::no_exif, "no exif");
+        ok(strcmp(nanoexifpp::message(exif.error()), "no exif") == 0, "message");
+    }
+
+    done_testing();
+}
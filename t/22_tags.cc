@@ -0,0 +1,100 @@
+#include "nanotap.h"
+#include "fixture.h"
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <nanoexif-tags.hpp>
+
+using nanoexifpp::Exif;
+using nanoexifpp::Errc;
+using nanoexifpp::Rational;
+using nanoexifpp::SRational;
+using nanoexifpp::Values;
+using nanoexifpp::get;
+namespace tags = nanoexifpp::tags;
+
+static_assert(std::is_same<tags::Orientation::value_type, uint16_t>::value, "SHORT");
+static_assert(std::is_same<tags::Make::value_type, std::string_view>::value, "ASCII");
+static_assert(std::is_same<tags::FNumber::value_type, Rational>::value, "RATIONAL");
+static_assert(std::is_same<tags::GPSLatitude::value_type, Values<Rational>>::value, "RATIONAL[3]");
+static_assert(std::is_same<tags::ISO::value_type, Values<uint16_t>>::value, "any count");
+static_assert(tags::Orientation::tag == NANOEXIF_TAG_ORIENTATION && tags::Orientation::ifd == NANOEXIF_IFD_0, "schema");
+static_assert(tags::DateTimeOriginal::ifd == NANOEXIF_IFD_EXIF && tags::GPSAltitude::ifd == NANOEXIF_IFD_GPS, "ifds");
+
+int main() {
+    // the sample stores every tag in its standard type, except ExifImageWidth
+    {
+        FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+        assert(fp);
+        auto exif = Exif::open(fp);
+        ok(exif.has_value(), "open");
+
+        ok(get<tags::Orientation>(*exif).value_or(0) == 6, "Orientation");
+        ok(get<tags::Make>(*exif).value_or("") == "Apple", "Make");
+        ok(get<tags::DateTimeOriginal>(*exif).value_or("").size() == 19, "DateTimeOriginal");
+        auto xres = get<tags::XResolution>(*exif);
+        ok(xres && xres->num == 72 && xres->den == 1, "XResolution");
+        auto fnumber = get<tags::FNumber>(*exif);
+        ok(fnumber && fnumber->to_double() == 2.8, "FNumber");
+        auto shutter = get<tags::ShutterSpeedValue>(*exif);
+        ok(shutter && shutter->den != 0 && shutter->to_double() > 0, "ShutterSpeedValue");
+        auto iso = get<tags::ISO>(*exif);
+        ok(iso && iso->size() == 1 && (*iso)[0] == 70, "ISO");
+        auto version = get<tags::ExifVersion>(*exif);
+        ok(version && version->size() == 4 && memcmp(version->data(), "02", 2) == 0, "ExifVersion");
+        auto lat = get<tags::GPSLatitude>(*exif);
+        ok(lat && lat->size() == 3, "GPSLatitude");
+        ok(get<tags::GPSLatitudeRef>(*exif).has_value(), "GPSLatitudeRef");
+
+        // LONG in the file, SHORT in the schema
+        ok(get<tags::ExifImageWidth>(*exif).value_or(0) == 2048, "converted");
+        ok(get<tags::Artist>(*exif).error() == Errc::not_found, "not found");
+        fclose(fp);
+    }
+
+    // non standard types
+    {
+        uint8_t tiff[8 + 2 + 12*6 + 4 + 8];
+        memcpy(tiff, "II\x2A\x00", 4);
+        put32(tiff+4, 8);
+        put16(tiff+8, 6);
+        put_entry(tiff+10, 0x0100, NANOEXIF_TYPE_SHORT, 1, 640);            // ImageWidth, LONG
+        put_entry(tiff+22, 0x010F, NANOEXIF_TYPE_SHORT, 1, 1);              // Make, ASCII
+        put_entry(tiff+34, 0x0112, NANOEXIF_TYPE_LONG, 1, 70000);           // Orientation, SHORT
+        put_entry(tiff+46, 0x0128, NANOEXIF_TYPE_LONG, 1, 2);               // ResolutionUnit, SHORT
+        put_entry(tiff+58, 0x011A, NANOEXIF_TYPE_LONG, 1, 300);             // XResolution, RATIONAL
+        put_entry(tiff+70, 0x0131, NANOEXIF_TYPE_UNDEFINED, 4, 0x00786F6E); // Software, ASCII
+        put32(tiff+82, 0);
+
+        auto exif = Exif::from_tiff(tiff, sizeof(tiff));
+        ok(exif.has_value(), "from tiff");
+        ok(get<tags::ImageWidth>(*exif).value_or(0) == 640, "SHORT as LONG");
+        ok(get<tags::Make>(*exif).error() == Errc::type_mismatch, "SHORT as ASCII");
+        ok(get<tags::Orientation>(*exif).error() == Errc::out_of_range, "does not fit");
+        ok(get<tags::ResolutionUnit>(*exif).value_or(0) == 2, "LONG as SHORT");
+        auto xres = get<tags::XResolution>(*exif);
+        ok(xres && xres->num == 300 && xres->den == 1, "LONG as RATIONAL");
+        ok(get<tags::Software>(*exif).value_or("") == "nox", "UNDEFINED as ASCII");
+    }
+
+    // a RATIONAL converted to SRATIONAL, its value out of the data
+    {
+        uint8_t tiff[8 + (2 + 12 + 4)*2];
+        memcpy(tiff, "II\x2A\x00", 4);
+        put32(tiff+4, 8);
+        put16(tiff+8, 1);
+        put_entry(tiff+10, NANOEXIF_TAG_EXIF_OFFSET, NANOEXIF_TYPE_LONG, 1, 26);
+        put32(tiff+22, 0);
+        put16(tiff+26, 1);
+        put_entry(tiff+28, 0x9201, NANOEXIF_TYPE_RATIONAL, 1, 0xFFFFFF00); // ShutterSpeedValue, SRATIONAL
+        put32(tiff+40, 0);
+
+        auto exif = Exif::from_tiff(tiff, sizeof(tiff));
+        ok(exif.has_value(), "from tiff, exif ifd");
+        ok(get<tags::ShutterSpeedValue>(*exif).error() == Errc::out_of_range, "RATIONAL out of the data");
+    }
+
+    done_testing();
+}
@@ -0,0 +1,224 @@
+#define _GNU_SOURCE
+#include "nanotap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <nanoexif.h>
+#include <nanoexif-cache.h>
+
+#define NFILES 16
+#define NPROCS 4
+
+static uint8_t orig[1<<20];
+static size_t orig_len;
+static char dir[] = "/tmp/nanoexif-23-XXXXXX";
+
+static void write_file(const char * path, const uint8_t * data, size_t len) {
+    int out = open(path, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    assert(out >= 0);
+    ssize_t n = write(out, data, len);
+    assert(n == (ssize_t)len);
+    (void)n;
+    close(out);
+}
+
+static bool orientation(nanoexif * ne, uint32_t ifd_offset, uint32_t * v) {
+    nanoexif_tag_key key = { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION };
+    nanoexif_query_result res;
+    return nanoexif_query(ne, ifd_offset, &key, 1, &res) && nanoexif_get_ifd_entry_uint(ne, &res.entry, 0, v);
+}
+
+static const char * small_path(int i) {
+    static char path[64];
+    snprintf(path, sizeof(path), "%s/%02d.jpg", dir, i);
+    return path;
+}
+
+int main() {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    orig_len = fread(orig, 1, sizeof(orig), fp);
+    fclose(fp);
+    char * made = mkdtemp(dir);
+    assert(made);
+    (void)made;
+
+    char cache_path[64], jpeg[64], noexif[64];
+    snprintf(cache_path, sizeof(cache_path), "%s/cache", dir);
+    snprintf(jpeg, sizeof(jpeg), "%s/sample.jpg", dir);
+    snprintf(noexif, sizeof(noexif), "%s/noexif.jpg", dir);
+    write_file(jpeg, orig, orig_len);
+    write_file(noexif, (const uint8_t*)"\xFF\xD8\xFF\xD9", 4);
+
+    nanoexif_cache * cache = nanoexif_cache_open(cache_path, 64, 1<<20);
+    ok(!!cache, "create");
+    ok(nanoexif_cache_count(cache) == 0, "empty");
+
+    uint32_t ifd_offset = 0, v = 0;
+    nanoexif_cache_status status;
+    nanoexif * ne = nanoexif_cache_init(cache, jpeg, &ifd_offset, &status);
+    ok(ne && status == NANOEXIF_CACHE_STORED, "miss");
+    ok(orientation(ne, ifd_offset, &v) && v == 6, "stored exif");
+    nanoexif_free(ne);
+    ok(!nanoexif_cache_init(cache, noexif, &ifd_offset, &status) && status == NANOEXIF_CACHE_STORED, "no exif");
+    ok(!nanoexif_cache_init(cache, "/nonexistent", &ifd_offset, &status) && status == NANOEXIF_CACHE_ERROR, "no file");
+    nanoexif_cache_close(cache);
+
+    // the entries are in the file; geometry of an existing file is its own
+    cache = nanoexif_cache_open(cache_path, 2, 64);
+    ok(!!cache, "reopen");
+    ok(nanoexif_cache_count(cache) == 2, "count");
+    ne = nanoexif_cache_init(cache, jpeg, &ifd_offset, &status);
+    ok(ne && status == NANOEXIF_CACHE_HIT, "hit");
+    ok(orientation(ne, ifd_offset, &v) && v == 6, "cached exif");
+    nanoexif_free(ne);
+    ok(!nanoexif_cache_init(cache, noexif, &ifd_offset, &status) && status == NANOEXIF_CACHE_HIT, "negative hit");
+
+    // a hit does not read the file: garbage of the same size and mtime is not noticed
+    struct stat st;
+    int r = stat(jpeg, &st);
+    assert(r == 0);
+    uint8_t * junk = malloc(orig_len);
+    assert(junk);
+    memset(junk, 0xA5, orig_len);
+    write_file(jpeg, junk, orig_len);
+    struct timespec times[2] = { st.st_atim, st.st_mtim };
+    r = utimensat(AT_FDCWD, jpeg, times, 0);
+    assert(r == 0);
+    ne = nanoexif_cache_init(cache, jpeg, &ifd_offset, &status);
+    ok(ne && status == NANOEXIF_CACHE_HIT && orientation(ne, ifd_offset, &v) && v == 6, "stat only");
+    nanoexif_free(ne);
+
+    // a new mtime is a new key
+    times[1].tv_sec += 10;
+    r = utimensat(AT_FDCWD, jpeg, times, 0);
+    assert(r == 0);
+    (void)r;
+    ok(!nanoexif_cache_init(cache, jpeg, &ifd_offset, &status) && status == NANOEXIF_CACHE_STORED, "modified");
+    ok(!nanoexif_cache_init(cache, jpeg, &ifd_offset, &status) && status == NANOEXIF_CACHE_HIT, "modified, hit");
+    ok(nanoexif_cache_count(cache) == 3, "old entry kept");
+    nanoexif_cache_close(cache);
+    free(junk);
+
+    // not a cache
+    ok(!nanoexif_cache_open(jpeg, 0, 0), "bad magic");
+
+    // processes filling one cache at once
+    size_t small_len = 2 + 2 + 14219;
+    uint8_t * small = malloc(small_len + 2);
+    assert(small);
+    memcpy(small, orig, small_len);
+    memcpy(small + small_len, "\xFF\xD9", 2);
+    int i;
+    for (i=0; i<NFILES; i++) {
+        write_file(small_path(i), small, small_len + 2);
+    }
+    free(small);
+
+    char shared[64];
+    snprintf(shared, sizeof(shared), "%s/shared", dir);
+    pid_t pids[NPROCS];
+    int p;
+    for (p=0; p<NPROCS; p++) {
+        pids[p] = fork();
+        assert(pids[p] >= 0);
+        if (pids[p] == 0) {
+            nanoexif_cache * c = nanoexif_cache_open(shared, 256, 1<<20);
+            int bad = !c;
+            for (i=0; c && i<NFILES; i++) {
+                uint32_t off, o;
+                nanoexif * e = nanoexif_cache_init(c, small_path((i + p*5) % NFILES), &off, NULL);
+                if (!e || !orientation(e, off, &o) || o != 6) { bad++; }
+                nanoexif_free(e);
+            }
+            nanoexif_cache_close(c);
+            _exit(bad ? 1 : 0);
+        }
+    }
+    int failed = 0;
+    for (p=0; p<NPROCS; p++) {
+        int wstatus;
+        if (waitpid(pids[p], &wstatus, 0) != pids[p] || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) { failed++; }
+    }
+    ok(failed == 0, "concurrent writers");
+
+    cache = nanoexif_cache_open(shared, 0, 0);
+    ok(!!cache, "open shared");
+    int hits = 0;
+    for (i=0; i<NFILES; i++) {
+        ne = nanoexif_cache_init(cache, small_path(i), &ifd_offset, &status);
+        if (ne && status == NANOEXIF_CACHE_HIT && orientation(ne, ifd_offset, &v) && v == 6) { hits++; }
+        nanoexif_free(ne);
+        unlink(small_path(i));
+    }
+    ok(hits == NFILES, "all stored");
+    ok(nanoexif_cache_count(cache) >= NFILES, "shared count");
+    nanoexif_cache_close(cache);
+
+    // full: parsed, not stored
+    char tiny[64];
+    snprintf(tiny, sizeof(tiny), "%s/tiny", dir);
+    cache = nanoexif_cache_open(tiny, 4, 64);
+    ok(!!cache, "tiny cache");
+    ne = nanoexif_cache_init(cache, jpeg, &ifd_offset, &status);
+    ok(!ne && status == NANOEXIF_CACHE_STORED, "no exif fits");
+    write_file(noexif, orig, orig_len);
+    ne = nanoexif_cache_init(cache, noexif, &ifd_offset, &status);
+    ok(ne && status == NANOEXIF_CACHE_FULL && orientation(ne, ifd_offset, &v) && v == 6, "full");
+    nanoexif_free(ne);
+
+    // what did not fit is not counted: a smaller exif still goes in
+    char little[64], other[64];
+    snprintf(little, sizeof(little), "%s/little.jpg", dir);
+    snprintf(other, sizeof(other), "%s/other.jpg", dir);
+    static const uint8_t little_jpeg[] = {
+        0xFF, 0xD8, 0xFF, 0xE1, 0x00, 0x22, 'E', 'x', 'i', 'f', 0, 0,
+        'I', 'I', 0x2A, 0x00, 8, 0, 0, 0, 1, 0,
+        0x12, 0x01, 3, 0, 1, 0, 0, 0, 6, 0, 0, 0,
+        0, 0, 0, 0, 0xFF, 0xD9,
+    };
+    write_file(little, little_jpeg, sizeof(little_jpeg));
+    write_file(other, (const uint8_t*)"\xFF\xD8\xFF\xD9", 4);
+    ne = nanoexif_cache_init(cache, little, &ifd_offset, &status);
+    ok(ne && status == NANOEXIF_CACHE_STORED && orientation(ne, ifd_offset, &v) && v == 6, "data left after full");
+    nanoexif_free(ne);
+
+    // 4 slots take 2 entries
+    ok(!nanoexif_cache_init(cache, other, &ifd_offset, &status) && status == NANOEXIF_CACHE_FULL, "load factor");
+    ok(nanoexif_cache_count(cache) == 2, "count of a full cache");
+    nanoexif_cache_close(cache);
+
+    // a slot pointing out of the data: header 64 bytes, then 48 byte slots with offset at 32, len at 40
+    int fd = open(tiny, O_RDWR);
+    assert(fd >= 0);
+    for (i=0; i<4; i++) {
+        uint32_t len;
+        ssize_t n = pread(fd, &len, 4, 64 + i*48 + 40);
+        assert(n == 4);
+        if (len) {
+            uint64_t offset = (uint64_t)1<<40;
+            n = pwrite(fd, &offset, 8, 64 + i*48 + 32);
+            assert(n == 8);
+        }
+        (void)n;
+    }
+    close(fd);
+    cache = nanoexif_cache_open(tiny, 0, 0);
+    ok(!nanoexif_cache_init(cache, little, &ifd_offset, &status) && status == NANOEXIF_CACHE_ERROR, "broken slot");
+    nanoexif_cache_close(cache);
+
+    unlink(tiny);
+    unlink(little);
+    unlink(other);
+    unlink(shared);
+    unlink(cache_path);
+    unlink(jpeg);
+    unlink(noexif);
+    rmdir(dir);
+    done_testing();
+}
@@ -0,0 +1,177 @@
+#define _GNU_SOURCE
+#include "nanotap.h"
+#include "fixture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <nanoexif.h>
+#include <nanoexif-easy.h>
+#include <nanoexif-flat.h>
+
+static uint8_t orig[1<<20];
+static size_t orig_len;
+
+static bool is_offset(nanoexif_ifd_kind kind, uint16_t tag) {
+    return tag == NANOEXIF_TAG_EXIF_OFFSET || tag == NANOEXIF_TAG_GPS_INFO ||
+        tag == NANOEXIF_TAG_INTEROP_OFFSET || (kind == NANOEXIF_IFD_1 && tag == NANOEXIF_TAG_JPEG_IF_OFFSET);
+}
+
+/* the same entries in the same ifds, with the same values */
+static bool same_entries(nanoexif * a, uint32_t a_ifd0, nanoexif * b, uint32_t b_ifd0, size_t * n) {
+    nanoexif_walker wa, wb;
+    nanoexif_ifd_entry ea, eb;
+    nanoexif_walker_init(&wa, a, a_ifd0);
+    nanoexif_walker_init(&wb, b, b_ifd0);
+    *n = 0;
+    for (;;) {
+        nanoexif_walk_status sa = nanoexif_walker_next(&wa, &ea);
+        nanoexif_walk_status sb = nanoexif_walker_next(&wb, &eb);
+        if (sa != sb) { return false; }
+        if (sa != NANOEXIF_WALK_ENTRY) { return sa == NANOEXIF_WALK_END; }
+        if (wa.kind != wb.kind || ea.tag != eb.tag || ea.type != eb.type || ea.count != eb.count) { return false; }
+        (*n)++;
+        if (is_offset(wa.kind, ea.tag)) { continue; }
+        uint32_t i;
+        for (i=0; i<ea.count; i++) {
+            double da, db;
+            if (nanoexif_type_size(ea.type) == 1) {
+                if (nanoexif_get_ifd_entry_data(a, &ea)[i] != nanoexif_get_ifd_entry_data(b, &eb)[i]) { return false; }
+            } else {
+                bool ga = nanoexif_get_ifd_entry_double(a, &ea, i, &da);
+                bool gb = nanoexif_get_ifd_entry_double(b, &eb, i, &db);
+                if (ga != gb || (ga && da != db)) { return false; }
+            }
+        }
+    }
+}
+
+int main() {
+    FILE *fp = fopen("t/data/sample-iphone.jpg", "rb");
+    assert(fp);
+    orig_len = fread(orig, 1, sizeof(orig), fp);
+    fclose(fp);
+
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init_from_memory(orig, orig_len, &ifd0_offset);
+    assert(ne);
+
+    // big endian to the machine's
+    size_t len = nanoexif_flatten(ne, ifd0_offset, NULL, 0);
+    ok(len > NANOEXIF_FLAT_HEADER_SIZE && len < NANOEXIF_FLAT_HEADER_SIZE + ne->len + 64, "size");
+    uint8_t small[16];
+    ok(nanoexif_flatten(ne, ifd0_offset, small, sizeof(small)) == len, "too small");
+    uint64_t * flat = malloc(len);
+    uint8_t * data = (uint8_t*)flat;
+    assert(flat);
+    ok(nanoexif_flatten(ne, ifd0_offset, data, len) == len, "flatten");
+    ok(memcmp(data, "NXFLAT", 6) == 0 && data[6] == NANOEXIF_FLAT_VERSION, "header");
+
+    uint32_t flat_ifd0;
+    nanoexif * fe = nanoexif_init_flat(data, len, &flat_ifd0);
+    ok(!!fe, "init flat");
+    ok(fe->endian == NANOEXIF_MACHINE_ENDIAN, "machine endian");
+    ok(fe->buf == data + NANOEXIF_FLAT_HEADER_SIZE, "in place");
+    size_t n;
+    ok(same_entries(ne, ifd0_offset, fe, flat_ifd0, &n), "same entries");
+    ok(n == 46, "all the ifds");
+
+    nanoexif_tag_key keys[] = {
+        { NANOEXIF_IFD_0, NANOEXIF_TAG_ORIENTATION },
+        { NANOEXIF_IFD_EXIF, 0x829D }, /* FNumber */
+        { NANOEXIF_IFD_GPS, 0x0002 },  /* GPSLatitude */
+    };
+    nanoexif_query_result res[3];
+    ok(nanoexif_query(fe, flat_ifd0, keys, 3, res) == 3, "query");
+    uint32_t v;
+    ok(nanoexif_get_ifd_entry_uint(fe, &res[0].entry, 0, &v) && v == 6, "orientation");
+    uint16_t o;
+    memcpy(&o, res[0].entry.offset, 2);
+    ok(o == 6, "stored as the machine's short");
+    const uint8_t * fnumber = nanoexif_get_ifd_entry_data(fe, &res[1].entry);
+    ok(fnumber && (fnumber - fe->buf) % 4 == 0, "rational aligned");
+    ok(((const uint32_t*)fnumber)[0] == 14 && ((const uint32_t*)fnumber)[1] == 5, "loaded in place");
+    ok(res[2].entry.count == 3, "gps");
+
+    uint16_t orientation;
+    uint32_t thumb_len, flat_thumb_len;
+    const uint8_t * thumb = nanoexif_easy_thumbnail_view(ne, ifd0_offset, &orientation, &thumb_len);
+    const uint8_t * flat_thumb = nanoexif_easy_thumbnail_view(fe, flat_ifd0, &orientation, &flat_thumb_len);
+    ok(flat_thumb && flat_thumb_len == thumb_len && memcmp(flat_thumb, thumb, thumb_len) == 0, "thumbnail");
+
+    // flat to flat is the same bytes
+    uint8_t * again = malloc(len);
+    assert(again);
+    ok(nanoexif_flatten(fe, flat_ifd0, again, len) == len && memcmp(again, data, len) == 0, "stable");
+    free(again);
+    nanoexif_free(fe);
+
+    ok(!nanoexif_init_flat(data, len - 100, &flat_ifd0), "truncated");
+    data[6]++;
+    ok(!nanoexif_init_flat(data, len, &flat_ifd0), "version");
+    ok(!nanoexif_init_flat(orig, orig_len, &flat_ifd0), "not flat");
+    free(flat);
+    nanoexif_free(ne);
+
+    // handed to another process through shared memory
+    ne = nanoexif_init_from_memory(orig, orig_len, &ifd0_offset);
+    len = nanoexif_flatten(ne, ifd0_offset, NULL, 0);
+    uint8_t * shm = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+    assert(shm != MAP_FAILED);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        _exit(nanoexif_flatten(ne, ifd0_offset, shm, len) == len ? 0 : 1);
+    }
+    int status;
+    ok(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0, "written by a child");
+    fe = nanoexif_init_flat(shm, len, &flat_ifd0);
+    ok(fe && same_entries(ne, ifd0_offset, fe, flat_ifd0, &n), "read from shared memory");
+    nanoexif_free(fe);
+    munmap(shm, len);
+    nanoexif_free(ne);
+
+    // little endian tiff: a double, a value out of range, and an Exif pointer to nowhere
+    {
+        uint8_t tiff[8 + 2 + 12*4 + 4 + 8];
+        memcpy(tiff, "II\x2A\x00", 4);
+        put32(tiff+4, 8);
+        put16(tiff+8, 4);
+        put_entry(tiff+10, 0x0100, NANOEXIF_TYPE_SHORT, 1, 640);
+        put_entry(tiff+22, 0x9999, NANOEXIF_TYPE_DFLOAT, 1, 62);
+        put_entry(tiff+34, 0x9998, NANOEXIF_TYPE_LONG, 100, 62);
+        put_entry(tiff+46, NANOEXIF_TAG_EXIF_OFFSET, NANOEXIF_TYPE_LONG, 1, 4000);
+        put32(tiff+58, 0);
+        double d = -1.25;
+        uint64_t bits;
+        memcpy(&bits, &d, 8);
+        put32(tiff+62, bits);
+        put32(tiff+66, bits >> 32);
+
+        uint32_t off;
+        ne = nanoexif_init_tiff(tiff, sizeof(tiff), &off);
+        assert(ne);
+        len = nanoexif_flatten(ne, off, NULL, 0);
+        flat = malloc(len);
+        assert(flat);
+        nanoexif_flatten(ne, off, (uint8_t*)flat, len);
+        fe = nanoexif_init_flat((uint8_t*)flat, len, &flat_ifd0);
+        nanoexif_ifd_entry entries[3];
+        nanoexif_walker w;
+        nanoexif_walker_init(&w, fe, flat_ifd0);
+        n = 0;
+        while (n < 3 && nanoexif_walker_next(&w, &entries[n]) == NANOEXIF_WALK_ENTRY) { n++; }
+        ok(n == 2, "broken entries left out");
+        const uint8_t * dp = nanoexif_get_ifd_entry_data(fe, &entries[1]);
+        ok(entries[1].tag == 0x9999 && dp && *(const double*)dp == -1.25, "double in the machine's endian");
+        ok((dp - fe->buf) % 8 == 0, "double aligned");
+        nanoexif_free(fe);
+        nanoexif_free(ne);
+        free(flat);
+    }
+
+    done_testing();
+}
@@ -0,0 +1,16 @@
+#ifndef FIXTURE_H_
+#define FIXTURE_H_
+
+#include <stdint.h>
+
+/* writers of the little endian tiffs the tests build by hand */
+
+static inline void put16(uint8_t *p, uint16_t v) { p[0] = v; p[1] = v>>8; }
+static inline void put32(uint8_t *p, uint32_t v) { put16(p, v); put16(p+2, v>>16); }
+
+/* a 12 byte ifd entry */
+static inline void put_entry(uint8_t *p, uint16_t tag, uint16_t type, uint32_t count, uint32_t value) {
+    put16(p, tag); put16(p+2, type); put32(p+4, count); put32(p+8, value);
+}
+
+#endif /* FIXTURE_H_ */
@@ -0,0 +1,67 @@
+#ifndef RAW_H_
+#define RAW_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <nanoexif.h>
+#include "fixture.h"
+
+#define MB (1024*1024)
+
+static inline void pwrite_all(int fd, const void *buf, size_t len, off_t offset) {
+    ssize_t n = pwrite(fd, buf, len, offset);
+    assert(n == (ssize_t)len);
+    (void)n;
+}
+
+/*
+ * a 40MB little endian tiff, like a raw file: IFD0 at the top, the values and the other ifds scattered far away.
+ *   IFD0 at 8:  ImageWidth 6000, Make "NIKON CORP" at 8MB, Model "D90" at 8MB+4000, Orientation 3,
+ *               Artist "Alice" at 16MB, the Exif IFD at 20MB, IFD1 at 30MB
+ *   Exif IFD:   DateTimeOriginal "2011:02:03 04:05:06" at 20MB+100
+ *   IFD1:       Compression 7
+ * Make and Model are closer than a fetch apart. path is a mkstemp(3) template, and is the file made.
+ */
+static inline const char * make_raw(char * path) {
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    int r = ftruncate(fd, 40*MB);
+    assert(r == 0);
+    (void)r;
+
+    uint8_t head[8 + 2 + 12*6 + 4];
+    memcpy(head, "II\x2A\x00", 4);
+    put32(head+4, 8);
+    put16(head+8, 6);
+    put_entry(head+10, 0x0100, NANOEXIF_TYPE_SHORT, 1, 6000);
+    put_entry(head+22, NANOEXIF_TAG_MAKE, NANOEXIF_TYPE_ASCII, 10, 8*MB);
+    put_entry(head+34, NANOEXIF_TAG_MODEL, NANOEXIF_TYPE_ASCII, 200, 8*MB + 4000);
+    put_entry(head+46, NANOEXIF_TAG_ORIENTATION, NANOEXIF_TYPE_SHORT, 1, 3);
+    put_entry(head+58, 0x013B, NANOEXIF_TYPE_ASCII, 6, 16*MB);
+    put_entry(head+70, NANOEXIF_TAG_EXIF_OFFSET, NANOEXIF_TYPE_LONG, 1, 20*MB);
+    put32(head+82, 30*MB); /* IFD1 */
+    pwrite_all(fd, head, sizeof(head), 0);
+    pwrite_all(fd, "NIKON CORP", 10, 8*MB);
+    pwrite_all(fd, "D90", 4, 8*MB + 4000);
+    pwrite_all(fd, "Alice", 6, 16*MB);
+
+    uint8_t exif[2 + 12 + 4];
+    put16(exif, 1);
+    put_entry(exif+2, 0x9003, NANOEXIF_TYPE_ASCII, 20, 20*MB + 100);
+    put32(exif+14, 0);
+    pwrite_all(fd, exif, sizeof(exif), 20*MB);
+    pwrite_all(fd, "2011:02:03 04:05:06", 20, 20*MB + 100);
+
+    uint8_t ifd1[2 + 12 + 4];
+    put16(ifd1, 1);
+    put_entry(ifd1+2, NANOEXIF_TAG_COMPRESSION, NANOEXIF_TYPE_SHORT, 1, 7);
+    put32(ifd1+14, 0);
+    pwrite_all(fd, ifd1, sizeof(ifd1), 30*MB);
+    close(fd);
+    return path;
+}
+
+#endif /* RAW_H_ */
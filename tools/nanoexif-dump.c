@@ -3,78 +3,78 @@
 #include <assert.h>
 #include <stdlib.h>
 
-void dump(nanoexif *ne, int level, uint32_t ifd_offset) {
-    uint32_t next_offset;
+static const char * ifd_name[] = { "IFD0", "IFD1", "Exif", "GPS", "Interop" };
 
-    do {
-        uint16_t cnt;
-        nanoexif_ifd_entry* entries = nanoexif_read_ifd(ne, ifd_offset, &next_offset, &cnt);
-        printf("tag cnt: %d, next offset: %d\n", cnt, next_offset);
-        uint16_t i;
-        for (i=0; i<cnt; i++) {
-            const char * tag = nanoexif_tag_name(entries[i].tag);
-            int j;
-            for (j=0; j<level*3+1; j++) {
-                printf("-");
-            }
-            printf(" tag: 0x%04X(%s), type:%d, count:%d\n", entries[i].tag, tag ? tag : "(null)", entries[i].type, entries[i].count);
-            switch (entries[i].type) {
-            case NANOEXIF_TYPE_RATIONAL:
-                {
-                    uint32_t *x = nanoexif_get_ifd_entry_data_rational(ne, &entries[i]);
-                    assert(x);
-                    uint16_t j;
-                    for (j=0; j<entries[i].count*2; j+=2) {
-                        printf("  %d/%d\n", x[j], x[j+1]);
-                    }
-                    free(x);
-                }
-                break;
-            case NANOEXIF_TYPE_ASCII: // 2
-                {
-                    char *x = nanoexif_get_ifd_entry_data_ascii(ne, &entries[i]);
-                    assert(x);
-                    printf("  %s\n", x); // x is null terminated.
-                    free(x);
-                }
-                break;
-            case NANOEXIF_TYPE_SHORT:
-                {
-                    uint16_t *x = nanoexif_get_ifd_entry_data_short(ne, &entries[i]);
-                    assert(x);
-                    uint16_t j;
-                    for (j=0;j<entries[i].count; j++) {
-                        printf("  %d\n", x[j]);
-                    }
-                    free(x);
+void dump(nanoexif *ne, uint32_t ifd_offset) {
+    nanoexif_walker w;
+    nanoexif_ifd_entry entry;
+    nanoexif_walk_status st;
+    uint32_t current = 0;
+
+    nanoexif_walker_init(&w, ne, ifd_offset);
+    while ((st = nanoexif_walker_next(&w, &entry)) == NANOEXIF_WALK_ENTRY) {
+        if (w.ifd_offset != current) {
+            current = w.ifd_offset;
+            printf("%s: offset: %d, tag cnt: %d\n", ifd_name[w.kind], w.ifd_offset, w.count);
+        }
+        int level = w.kind == NANOEXIF_IFD_0 || w.kind == NANOEXIF_IFD_1 ? 0 : w.kind == NANOEXIF_IFD_INTEROP ? 2 : 1;
+        const char * tag = nanoexif_ifd_tag_name(w.kind, entry.tag);
+        int j;
+        for (j=0; j<level*3+1; j++) {
+            printf("-");
+        }
+        printf(" tag: 0x%04X(%s), type:%d, count:%d\n", entry.tag, tag ? tag : "(null)", entry.type, entry.count);
+        switch (entry.type) {
+        case NANOEXIF_TYPE_RATIONAL:
+            {
+                uint32_t *x = nanoexif_get_ifd_entry_data_rational(ne, &entry);
+                assert(x);
+                uint32_t j;
+                for (j=0; j<entry.count*2; j+=2) {
+                    printf("  %u/%u\n", x[j], x[j+1]);
                 }
-                break;
-            case NANOEXIF_TYPE_LONG:
-                {
-                    uint32_t *x = nanoexif_get_ifd_entry_data_long(ne, &entries[i]);
-                    assert(x);
-                    uint16_t j;
-                    for (j=0;j<entries[i].count; j++) {
-                        printf("  %d\n", x[j]);
-                    }
-                    free(x);
+                free(x);
+            }
+            break;
+        case NANOEXIF_TYPE_ASCII: // 2
+            {
+                char *x = nanoexif_get_ifd_entry_data_ascii(ne, &entry);
+                assert(x);
+                printf("  %.*s\n", (int)entry.count, x);
+                free(x);
+            }
+            break;
+        case NANOEXIF_TYPE_SHORT:
+            {
+                uint16_t *x = nanoexif_get_ifd_entry_data_short(ne, &entry);
+                assert(x);
+                uint32_t j;
+                for (j=0;j<entry.count; j++) {
+                    printf("  %d\n", x[j]);
                 }
-                break;
-            default:
-                printf("UNKNOWN type: %d\n", entries[i].type);
-                break;
+                free(x);
             }
-            if (entries[i].tag == NANOEXIF_TAG_EXIF_OFFSET || entries[i].tag == NANOEXIF_TAG_GPS_INFO) { // has sub id 
-                uint32_t * x = nanoexif_get_ifd_entry_data_long(ne, &entries[i]);
+            break;
+        case NANOEXIF_TYPE_LONG:
+            {
+                uint32_t *x = nanoexif_get_ifd_entry_data_long(ne, &entry);
                 assert(x);
-                uint32_t offset = *x;
+                uint32_t j;
+                for (j=0;j<entry.count; j++) {
+                    printf("  %u\n", x[j]);
+                }
                 free(x);
-
-                dump(ne, level+1, offset);
             }
+            break;
+        default:
+            printf("UNKNOWN type: %d\n", entry.type);
+            break;
         }
-        ifd_offset = next_offset;
-    } while (next_offset != 0);
+    }
+    if (st == NANOEXIF_WALK_ERROR) {
+        /* the broken ifd is left pending */
+        printf("broken ifd at offset: %u\n", w.pending[0].offset);
+    }
 }
 
 int main(int argc, char **argv) {
@@ -90,7 +90,7 @@ int main(int argc, char **argv) {
     printf("offset: %d\n", ifd_offset);
     assert(ne);
 
-    dump(ne, 0, ifd_offset);
+    dump(ne, ifd_offset);
 
     nanoexif_free(ne);
     fclose(fp);
@@ -0,0 +1,452 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include <nanoexif.h>
+#include <nanoexif-bulk.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+/* the jpeg header is almost always in the first 64KB */
+#define HEADER_WINDOW (64*1024)
+/* a worker takes this many files at a time from its own queue */
+#define CHUNK 16
+
+typedef struct {
+    char ** paths;
+    size_t n;
+    size_t cap;
+} path_list;
+
+typedef struct {
+    char * buf;
+    size_t len;
+    size_t cap;
+} strbuf;
+
+typedef struct worker {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    size_t lo;  /* the queue is the range [lo, hi) of the path list */
+    size_t hi;
+    nanoexif_ctx * ctx;
+    nanoexif_bulk * bulk;
+    size_t base;
+    strbuf out;
+    size_t found;
+    size_t reads;
+    size_t bytes;
+    struct scanner * scanner;
+} worker;
+
+typedef struct scanner {
+    path_list list;
+    worker * workers;
+    int nworkers;
+    bool ordered;
+    bool bulk;
+
+    pthread_mutex_t out_lock;
+    char ** slots;     /* ordered mode: lines waiting for the previous ones */
+    size_t next_emit;
+} scanner;
+
+static void die(const char *msg) {
+    perror(msg);
+    exit(1);
+}
+
+static void sb_reserve(strbuf *sb, size_t n) {
+    if (sb->len + n <= sb->cap) { return; }
+    size_t cap = sb->cap ? sb->cap : 1024;
+    while (cap < sb->len + n) { cap *= 2; }
+    sb->buf = realloc(sb->buf, cap);
+    if (!sb->buf) { die("realloc"); }
+    sb->cap = cap;
+}
+
+static void sb_puts(strbuf *sb, const char *s, size_t n) {
+    sb_reserve(sb, n);
+    memcpy(sb->buf + sb->len, s, n);
+    sb->len += n;
+}
+
+static void sb_printf(strbuf *sb, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void sb_printf(strbuf *sb, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    sb_reserve(sb, n+1);
+    va_start(ap, fmt);
+    vsnprintf(sb->buf + sb->len, n+1, fmt, ap);
+    va_end(ap);
+    sb->len += n;
+}
+
+static void sb_json_string(strbuf *sb, const char *s, size_t n) {
+    sb_puts(sb, "\"", 1);
+    size_t i;
+    for (i=0; i<n && s[i]; i++) {
+        unsigned char c = s[i];
+        if (c == '"' || c == '\\') {
+            sb_printf(sb, "\\%c", c);
+        } else if (c < 0x20 || c >= 0x7f) {
+            sb_printf(sb, "\\u%04x", c);
+        } else {
+            sb_puts(sb, (const char*)&c, 1);
+        }
+    }
+    sb_puts(sb, "\"", 1);
+}
+
+static void list_push(path_list *list, const char *path) {
+    if (list->n == list->cap) {
+        list->cap = list->cap ? list->cap*2 : 1024;
+        list->paths = realloc(list->paths, sizeof(char*)*list->cap);
+        if (!list->paths) { die("realloc"); }
+    }
+    list->paths[list->n] = strdup(path);
+    if (!list->paths[list->n]) { die("strdup"); }
+    list->n++;
+}
+
+static void list_walk(path_list *list, const char *path) {
+    DIR *dir = opendir(path);
+    if (!dir) {
+        list_push(list, path);
+        return;
+    }
+    struct dirent *d;
+    while ((d = readdir(dir))) {
+        if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) { continue; }
+        size_t len = strlen(path) + strlen(d->d_name) + 2;
+        char *child = malloc(len);
+        if (!child) { die("malloc"); }
+        snprintf(child, len, "%s/%s", path, d->d_name);
+        if (d->d_type == DT_DIR) {
+            list_walk(list, child);
+        } else if (d->d_type == DT_REG) {
+            list_push(list, child);
+        } else if (d->d_type == DT_UNKNOWN) {
+            struct stat st;
+            if (stat(child, &st) == 0) {
+                if (S_ISDIR(st.st_mode)) {
+                    list_walk(list, child);
+                } else if (S_ISREG(st.st_mode)) {
+                    list_push(list, child);
+                }
+            }
+        }
+        free(child);
+    }
+    closedir(dir);
+}
+
+static const char * ifd_name[] = { "IFD0", "IFD1", "Exif", "GPS", "Interop" };
+
+static void format_value(strbuf *sb, nanoexif *ne, nanoexif_ifd_entry *entry) {
+    if (entry->type == NANOEXIF_TYPE_ASCII) {
+        const char *p = (const char*)nanoexif_get_ifd_entry_data(ne, entry);
+        if (p) {
+            sb_json_string(sb, p, entry->count);
+        } else {
+            sb_puts(sb, "null", 4);
+        }
+        return;
+    }
+
+    /* the values are in the data, so count is bounded by its size. a corrupt count is one null, not count nulls. */
+    if (!nanoexif_get_ifd_entry_data(ne, entry)) {
+        sb_puts(sb, "null", 4);
+        return;
+    }
+    if (entry->count > 1) { sb_puts(sb, "[", 1); }
+    uint32_t i;
+    for (i=0; i<entry->count; i++) {
+        double d;
+        uint32_t u;
+        if (i) { sb_puts(sb, ",", 1); }
+        if (nanoexif_get_ifd_entry_uint(ne, entry, i, &u)) {
+            sb_printf(sb, "%u", u);
+        } else if (nanoexif_get_ifd_entry_double(ne, entry, i, &d)) {
+            sb_printf(sb, "%.10g", d);
+        } else {
+            sb_puts(sb, "null", 4);
+        }
+    }
+    if (entry->count > 1) { sb_puts(sb, "]", 1); }
+}
+
+/* format the exif as a json object body into w->out. */
+static void format_exif(worker *w, nanoexif *ne, uint32_t ifd0_offset) {
+    strbuf *sb = &w->out;
+    nanoexif_walker walker;
+    nanoexif_ifd_entry entry;
+    uint32_t current = 0;
+    bool first = true;
+    nanoexif_walker_init(&walker, ne, ifd0_offset);
+    while (nanoexif_walker_next(&walker, &entry) == NANOEXIF_WALK_ENTRY) {
+        if (entry.type == NANOEXIF_TYPE_UNDEFINED || nanoexif_type_size(entry.type) == 0) { continue; }
+        if (walker.ifd_offset != current) {
+            sb_printf(sb, "%s\"%s\":{", current ? "}," : ",", ifd_name[walker.kind]);
+            current = walker.ifd_offset;
+            first = true;
+        }
+        const char *name = nanoexif_ifd_tag_name(walker.kind, entry.tag);
+        if (name) {
+            sb_printf(sb, "%s\"%s\":", first ? "" : ",", name);
+        } else {
+            sb_printf(sb, "%s\"0x%04X\":", first ? "" : ",", entry.tag);
+        }
+        first = false;
+        format_value(sb, ne, &entry);
+    }
+    if (current) { sb_puts(sb, "}", 1); }
+}
+
+/* format one file as a json line into w->out. */
+static void scan_file(worker *w, const char *path) {
+    strbuf *sb = &w->out;
+    sb->len = 0;
+    sb_puts(sb, "{\"path\":", 8);
+    sb_json_string(sb, path, strlen(path));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        sb_puts(sb, ",\"error\":\"open\"}\n", 17);
+        return;
+    }
+    /* only the header is needed; don't let the kernel read ahead into the image */
+    posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+    posix_fadvise(fd, 0, HEADER_WINDOW, POSIX_FADV_WILLNEED);
+
+    uint32_t ifd0_offset;
+    nanoexif_read_stats stats;
+    nanoexif *ne = nanoexif_reset_fd(w->ctx, fd, HEADER_WINDOW, &ifd0_offset, &stats);
+    w->reads += stats.syscalls;
+    w->bytes += stats.bytes;
+    if (ne) {
+        w->found++;
+        format_exif(w, ne, ifd0_offset);
+    }
+    sb_puts(sb, "}\n", 2);
+    close(fd);
+}
+
+static void emit(scanner *s, worker *w, size_t index) {
+    pthread_mutex_lock(&s->out_lock);
+    if (!s->ordered) {
+        fwrite(w->out.buf, 1, w->out.len, stdout);
+    } else {
+        char *line = malloc(w->out.len + 1);
+        if (!line) { die("malloc"); }
+        memcpy(line, w->out.buf, w->out.len);
+        line[w->out.len] = '\0';
+        s->slots[index] = line;
+        while (s->next_emit < s->list.n && s->slots[s->next_emit]) {
+            fputs(s->slots[s->next_emit], stdout);
+            free(s->slots[s->next_emit]);
+            s->slots[s->next_emit] = NULL;
+            s->next_emit++;
+        }
+    }
+    pthread_mutex_unlock(&s->out_lock);
+}
+
+/* take a chunk from the front of our own queue. */
+static bool take(worker *w, size_t *lo, size_t *hi) {
+    pthread_mutex_lock(&w->lock);
+    *lo = w->lo;
+    size_t chunk = w->bulk ? NANOEXIF_BULK_DEPTH : CHUNK;
+    *hi = w->lo + chunk < w->hi ? w->lo + chunk : w->hi;
+    w->lo = *hi;
+    pthread_mutex_unlock(&w->lock);
+    return *lo < *hi;
+}
+
+/* steal the back half of the fullest queue. */
+static bool steal(worker *w) {
+    scanner *s = w->scanner;
+    int i, victim = -1;
+    size_t most = 0;
+    for (i=0; i<s->nworkers; i++) {
+        worker *v = &s->workers[i];
+        pthread_mutex_lock(&v->lock);
+        size_t left = v->hi - v->lo;
+        pthread_mutex_unlock(&v->lock);
+        if (v != w && left > most) {
+            most   = left;
+            victim = i;
+        }
+    }
+    if (victim < 0) { return false; }
+
+    worker *v = &s->workers[victim];
+    size_t lo, hi;
+    pthread_mutex_lock(&v->lock);
+    hi = v->hi;
+    lo = v->lo + (v->hi - v->lo) / 2;
+    v->hi = lo;
+    pthread_mutex_unlock(&v->lock);
+    if (lo >= hi) { return true; } /* someone else got it first. look again. */
+
+    pthread_mutex_lock(&w->lock);
+    w->lo = lo;
+    w->hi = hi;
+    pthread_mutex_unlock(&w->lock);
+    return true;
+}
+
+static void on_bulk(size_t index, nanoexif *ne, uint32_t ifd0_offset, void *ud) {
+    worker *w = ud;
+    scanner *s = w->scanner;
+    const char *path = s->list.paths[w->base + index];
+    strbuf *sb = &w->out;
+    sb->len = 0;
+    sb_puts(sb, "{\"path\":", 8);
+    sb_json_string(sb, path, strlen(path));
+    if (ne) {
+        w->found++;
+        format_exif(w, ne, ifd0_offset);
+    }
+    sb_puts(sb, "}\n", 2);
+    emit(s, w, w->base + index);
+}
+
+static void * work(void *arg) {
+    worker *w = arg;
+    scanner *s = w->scanner;
+    while (1) {
+        size_t lo, hi;
+        if (!take(w, &lo, &hi)) {
+            if (!steal(w)) { break; }
+            continue;
+        }
+        if (w->bulk) {
+            w->base = lo;
+            nanoexif_bulk_read(w->bulk, (const char * const *)s->list.paths + lo, hi - lo, on_bulk, w);
+            continue;
+        }
+        size_t i;
+        for (i=lo; i<hi; i++) {
+            scan_file(w, s->list.paths[i]);
+            emit(s, w, i);
+        }
+    }
+    return NULL;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-j threads] [-o] [-u] [path ...]\n"
+                    "  scans jpeg files and directories(recursively), and prints exif as NDJSON.\n"
+                    "  reads paths from stdin if no path is given.\n"
+                    "  -o  print in the input order\n"
+                    "  -u  read headers in batches, with io_uring where available\n", prog);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    scanner s;
+    memset(&s, 0, sizeof(s));
+    s.nworkers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:ouh")) != -1) {
+        switch (opt) {
+        case 'j': s.nworkers = atoi(optarg); break;
+        case 'o': s.ordered = true; break;
+        case 'u': s.bulk = true; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (s.nworkers < 1) { s.nworkers = 1; }
+
+    if (optind == argc) {
+        char *line = NULL;
+        size_t cap = 0;
+        ssize_t len;
+        while ((len = getline(&line, &cap, stdin)) > 0) {
+            if (line[len-1] == '\n') { line[--len] = '\0'; }
+            if (len) { list_walk(&s.list, line); }
+        }
+        free(line);
+    } else {
+        int i;
+        for (i=optind; i<argc; i++) {
+            list_walk(&s.list, argv[i]);
+        }
+    }
+
+    if (s.ordered) {
+        s.slots = calloc(s.list.n ? s.list.n : 1, sizeof(char*));
+        if (!s.slots) { die("calloc"); }
+    }
+    pthread_mutex_init(&s.out_lock, NULL);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    s.workers = calloc(s.nworkers, sizeof(worker));
+    if (!s.workers) { die("calloc"); }
+    int i;
+    for (i=0; i<s.nworkers; i++) {
+        worker *w = &s.workers[i];
+        pthread_mutex_init(&w->lock, NULL);
+        w->scanner = &s;
+        w->lo      = s.list.n * i / s.nworkers;
+        w->hi      = s.list.n * (i+1) / s.nworkers;
+        if (s.bulk) {
+            w->bulk = nanoexif_bulk_new(HEADER_WINDOW, NANOEXIF_BULK_DEPTH, true);
+            if (!w->bulk) { die("nanoexif_bulk_new"); }
+        } else {
+            w->ctx = nanoexif_ctx_new();
+            if (!w->ctx) { die("malloc"); }
+        }
+    }
+    for (i=0; i<s.nworkers; i++) {
+        if (pthread_create(&s.workers[i].thread, NULL, work, &s.workers[i]) != 0) { die("pthread_create"); }
+    }
+    for (i=0; i<s.nworkers; i++) {
+        pthread_join(s.workers[i].thread, NULL);
+    }
+    size_t found = 0, reads = 0, bytes = 0;
+    for (i=0; i<s.nworkers; i++) {
+        worker *w = &s.workers[i];
+        found += w->found;
+        reads += w->reads;
+        bytes += w->bytes;
+        nanoexif_ctx_free(w->ctx);
+        nanoexif_bulk_free(w->bulk);
+        free(w->out.buf);
+        pthread_mutex_destroy(&w->lock);
+    }
+    fflush(stdout);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "%zu files, %zu with exif, %.3f sec, %.0f files/sec, %d threads\n",
+        s.list.n, found, elapsed, elapsed > 0 ? s.list.n / elapsed : 0.0, s.nworkers);
+    if (!s.bulk) {
+        fprintf(stderr, "%zu reads, %.1f MB read\n", reads, bytes / 1e6);
+    }
+
+    size_t j;
+    for (j=0; j<s.list.n; j++) {
+        free(s.list.paths[j]);
+    }
+    free(s.list.paths);
+    free(s.slots);
+    free(s.workers);
+    return 0;
+}
@@ -1,8 +1,11 @@
+#define _POSIX_C_SOURCE 200809L
 #include <nanoexif.h>
 #include <nanoexif-easy.h>
 #include <stdio.h>
 #include <assert.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 int main(int argc, char **argv) {
     if (argc != 3) {
@@ -10,17 +13,21 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    FILE * ifp = fopen(argv[1], "rb");
-    assert(ifp);
+    int ifd = open(argv[1], O_RDONLY);
+    assert(ifd >= 0);
+    uint32_t ifd0_offset;
+    nanoexif * ne = nanoexif_init_mmap(ifd, &ifd0_offset);
+    assert(ne);
+    close(ifd);
+
     uint16_t orientation;
     uint32_t jpeg_byte_count;
-    char * thumb = nanoexif_easy_thumbnail(ifp, &orientation, &jpeg_byte_count);
+    const uint8_t * thumb = nanoexif_easy_thumbnail_view(ne, ifd0_offset, &orientation, &jpeg_byte_count);
     assert(thumb);
-    fclose(ifp);
 
     FILE * ofp = fopen(argv[2], "wb");
     assert(ofp);
     assert(fwrite(thumb, sizeof(char), jpeg_byte_count, ofp) == jpeg_byte_count);
     fclose(ofp);
+    nanoexif_free(ne);
 }
-
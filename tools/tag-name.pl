@@ -2,53 +2,302 @@ use common::sense;
 use autodie;
 
 use Image::ExifTool::Exif;
+use Image::ExifTool::GPS;
 use Scalar::Util qw/reftype/;
 use String::CamelCase qw/camelize decamelize/;
+use POSIX qw/ceil/;
 
-my %src = %Image::ExifTool::Exif::Main;
-my @key = sort { $a <=> $b } grep /^[0-9]+$/, keys %src;
+# generates nanoexif-tagname.c: minimal perfect hash tables for (namespace, tag) => name, and name => tag.
+# IFD0, IFD1, Exif and Interop share the tag numbers of Exif::Main. GPS has its own.
+# generates nanoexif-tags.hpp too: the C++ schema of the tags in %SCHEMA, with the type ExifTool writes them with.
+
+my %NS  = (main => 0, gps => 1);
+my %IFD = (IFD0 => 'NANOEXIF_IFD_0', IFD1 => 'NANOEXIF_IFD_1', ExifIFD => 'NANOEXIF_IFD_EXIF', GPS => 'NANOEXIF_IFD_GPS', InteropIFD => 'NANOEXIF_IFD_INTEROP');
+my %FORMAT = (
+    int8u => 'BYTE', string => 'ASCII', int16u => 'SHORT', int32u => 'LONG', rational64u => 'RATIONAL',
+    int8s => 'SBYTE', undef => 'UNDEFINED', int16s => 'SSHORT', int32s => 'SLONG', rational64s => 'SRATIONAL',
+    float => 'FLOAT', double => 'DFLOAT',
+);
+
+# the tags nanoexif-tags.hpp carries: the TIFF, Exif, DNG and GPS ones a caller asks for by name. the rest of
+# ExifTool's writable tags are left out, so the header does not change with the ExifTool it is generated by.
+my %SCHEMA = map { $_ => 1 } qw(
+    InteropIndex InteropVersion SubfileType ImageWidth ImageHeight BitsPerSample Compression
+    PhotometricInterpretation ImageDescription Make Model Orientation SamplesPerPixel RowsPerStrip XResolution
+    YResolution PlanarConfiguration ResolutionUnit TransferFunction Software ModifyDate Artist HostComputer
+    Predictor WhitePoint PrimaryChromaticities TileWidth TileLength YCbCrCoefficients YCbCrSubSampling
+    YCbCrPositioning ReferenceBlackWhite RelatedImageFileFormat RelatedImageWidth RelatedImageHeight Rating
+    RatingPercent Copyright ExposureTime FNumber ExifOffset ExposureProgram SpectralSensitivity GPSInfo ISO
+    TimeZoneOffset SelfTimerMode ExifVersion DateTimeOriginal CreateDate ComponentsConfiguration
+    CompressedBitsPerPixel ShutterSpeedValue ApertureValue BrightnessValue ExposureCompensation
+    MaxApertureValue SubjectDistance MeteringMode LightSource Flash FocalLength SubjectArea UserComment
+    SubSecTime SubSecTimeOriginal SubSecTimeDigitized XPTitle XPComment XPAuthor XPKeywords XPSubject
+    FlashpixVersion ColorSpace ExifImageWidth ExifImageHeight RelatedSoundFile InteropOffset FlashEnergy
+    FocalPlaneXResolution FocalPlaneYResolution FocalPlaneResolutionUnit SubjectLocation ExposureIndex
+    SensingMethod FileSource SceneType CFAPattern CustomRendered ExposureMode WhiteBalance DigitalZoomRatio
+    FocalLengthIn35mmFormat SceneCaptureType GainControl Contrast Saturation Sharpness
+    DeviceSettingDescription SubjectDistanceRange ImageUniqueID Gamma DNGVersion DNGBackwardVersion
+    UniqueCameraModel LocalizedCameraModel CameraSerialNumber DNGLensInfo GPSVersionID GPSLatitudeRef
+    GPSLatitude GPSLongitudeRef GPSLongitude GPSAltitudeRef GPSAltitude GPSTimeStamp GPSSatellites GPSStatus
+    GPSMeasureMode GPSDOP GPSSpeedRef GPSSpeed GPSTrackRef GPSTrack GPSImgDirectionRef GPSImgDirection
+    GPSMapDatum GPSDestLatitudeRef GPSDestLatitude GPSDestLongitudeRef GPSDestLongitude GPSDestBearingRef
+    GPSDestBearing GPSDestDistanceRef GPSDestDistance GPSProcessingMethod GPSAreaInformation GPSDateStamp
+    GPSDifferential GPSHPositioningError
+);
+
+my @tags;
+for my $table ([main => \%Image::ExifTool::Exif::Main], [gps => \%Image::ExifTool::GPS::Main]) {
+    my ($ns, $src) = @$table;
+    my $default = $src->{GROUPS}{1} || 'IFD0';
+    for my $k (sort { $a <=> $b } grep /^[0-9]+$/, keys %$src) {
+        my @name = get_name($src->{$k});
+        next unless @name==1;
+        my $group = (reftype($src->{$k}) // '') eq 'HASH' && $src->{$k}{Groups} && $src->{$k}{Groups}{1} || $default;
+        push @tags, { ns => $NS{$ns}, tag => $k, name => $name[0], ifd => $IFD{$group} || 'NANOEXIF_IFD_0', schema($src->{$k}) };
+    }
+}
+
+# some names are used by two tags(TIFF-EP and Exif, or JPEG-XR). name => tag prefers the Exif one, then the smaller tag.
+my %by_name;
+for my $t (@tags) {
+    my $cur = $by_name{$t->{name}};
+    if (!$cur || ($t->{ifd} eq 'NANOEXIF_IFD_EXIF' && $cur->{ifd} ne 'NANOEXIF_IFD_EXIF')) {
+        $by_name{$t->{name}} = $t;
+    }
+}
+
+my ($tag_disp, $tag_slots) = chd([map { [key($_), $_] } @tags], \&hash_key);
+my ($name_disp, $name_slots) = chd([map { [$_->{name}, $_] } values %by_name], \&hash_name);
+
+my %index;
+$index{$tag_slots->[$_]} = $_ for 0..$#$tag_slots;
+
+my $names = '';
+my %name_offset;
+for my $t (@$tag_slots) {
+    $name_offset{$t->{name}} //= do { my $off = length $names; $names .= "$t->{name}\0"; $off };
+}
+die "name pool too large" if length($names) > 0xFFFF;
 
 do {
     open my $fh, '>', 'nanoexif-tagname.c';
     print {$fh} <<'...';
+/* generated by tools/tag-name.pl. do not edit. */
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nanoexif.h"
+
+/**
+ * @file nanoexif-tagname.c
+ */
+
+typedef struct {
+    uint16_t tag;
+    uint8_t  ns;   /* 0: IFD0, IFD1, Exif and Interop. 1: GPS */
+    uint8_t  ifd;  /* nanoexif_ifd_kind the tag is defined in */
+    uint16_t name; /* offset in NAMES */
+} tag_info;
 
-const char *nanoexif_tag_name(uint32_t n) {
-    switch (n) {
 ...
-    for my $k (@key) {
-        my @name = get_name($src{$k});
-        if (@name==1) {
-            printf {$fh} qq{    case 0x%04X: return "$name[0]";\n}, $k;
-        }
+    print {$fh} "static const char NAMES[] =\n";
+    my $off = 0;
+    for my $t (@$tag_slots) {
+        next unless $name_offset{$t->{name}} == $off;
+        print {$fh} qq{    "$t->{name}\\0"\n};
+        $off += length($t->{name}) + 1;
     }
+    print {$fh} "    ;\n\n";
+
+    emit_array($fh, 'uint16_t', 'TAG_DISP', $tag_disp);
+    printf {$fh} "static const tag_info TAGS[%d] = {\n", scalar @$tag_slots;
+    for my $t (@$tag_slots) {
+        printf {$fh} "    { 0x%04X, %d, %s, %d },\n", $t->{tag}, $t->{ns}, $t->{ifd}, $name_offset{$t->{name}};
+    }
+    print {$fh} "};\n\n";
+    emit_array($fh, 'uint16_t', 'NAME_DISP', $name_disp);
+    emit_array($fh, 'uint16_t', 'NAME_SLOT', [map { $index{$_} } @$name_slots]);
+
     print {$fh} <<'...';
+static inline uint32_t hash_key(uint32_t key, uint32_t seed) {
+    uint32_t h = key ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline uint32_t hash_name(const char *s, uint32_t seed) {
+    uint32_t h = 0x811C9DC5u ^ (seed * 0x9E3779B9u);
+    for (; *s; s++) {
+        h ^= (uint8_t)*s;
+        h *= 0x01000193u;
     }
-    return NULL;
+    return h;
+}
+
+#define NTAGS  (sizeof(TAGS)/sizeof(TAGS[0]))
+#define NNAMES (sizeof(NAME_SLOT)/sizeof(NAME_SLOT[0]))
+
+static const tag_info * find_tag(uint8_t ns, uint16_t tag) {
+    uint32_t key = ((uint32_t)ns << 16) | tag;
+    uint16_t d = TAG_DISP[hash_key(key, 0) % (sizeof(TAG_DISP)/sizeof(TAG_DISP[0]))];
+    const tag_info * t = &TAGS[hash_key(key, d) % NTAGS];
+    return t->tag == tag && t->ns == ns ? t : NULL;
 }
+
+/** name of the tag in IFD0, IFD1, Exif or Interop ifd.
+ * @param uint32_t n: tag number
+ * @return the name, or NULL for unknown tags.
+ */
+const char *nanoexif_tag_name(uint32_t n) {
+    if (n > 0xFFFF) { return NULL; }
+    const tag_info * t = find_tag(0, n);
+    return t ? NAMES + t->name : NULL;
+}
+
+/** name of the tag in the ifd. GPS tags have their own numbers.
+ * @param nanoexif_ifd_kind kind: the ifd which has the tag
+ * @param uint16_t tag: tag number
+ * @return the name, or NULL for unknown tags.
+ */
+const char *nanoexif_ifd_tag_name(nanoexif_ifd_kind kind, uint16_t tag) {
+    const tag_info * t = find_tag(kind == NANOEXIF_IFD_GPS ? 1 : 0, tag);
+    return t ? NAMES + t->name : NULL;
+}
+
+/** look up the tag by name.
+ * @param const char * name: the name, as returned by nanoexif_ifd_tag_name()
+ * @param nanoexif_tag_key * key: the tag and the ifd it is defined in will be set.
+ * @return true if the name is known.
+ */
+bool nanoexif_tag_by_name(const char *name, nanoexif_tag_key *key) {
+    uint16_t d = NAME_DISP[hash_name(name, 0) % (sizeof(NAME_DISP)/sizeof(NAME_DISP[0]))];
+    const tag_info * t = &TAGS[NAME_SLOT[hash_name(name, d) % NNAMES]];
+    if (strcmp(NAMES + t->name, name) != 0) { return false; }
+    key->ifd = t->ifd;
+    key->tag = t->tag;
+    return true;
+}
+...
+    close $fh;
+};
+
+do {
+    open my $fh, '>', 'nanoexif-tags.hpp';
+    print {$fh} <<'...';
+/* generated by tools/tag-name.pl. do not edit. */
+#ifndef NANOEXIF_TAGS_HPP__
+#define NANOEXIF_TAGS_HPP__
+
+/**
+ * @file nanoexif-tags.hpp
+ *
+ * The common tags with the type and count of their value, for nanoexifpp::get<>().
+ * Names are ExifTool's; a name used by two tags is the one nanoexif_tag_by_name() returns.
+ */
+
+#include <nanoexif.hpp>
+
+namespace nanoexifpp {
+namespace tags {
+
+...
+    my $ns = -1;
+    for my $t (sort { $a->{ns} <=> $b->{ns} || $a->{tag} <=> $b->{tag} } grep { $_->{type} && $SCHEMA{$_->{name}} && $by_name{$_->{name}} == $_ } @tags) {
+        if ($t->{ns} != $ns) {
+            print {$fh} "\n" if $ns >= 0;
+            print {$fh} $t->{ns} ? "/* GPS */\n" : "/* IFD0, IFD1, Exif and Interop */\n";
+            $ns = $t->{ns};
+        }
+        printf {$fh} "using %s = Tag<0x%04X, %s, NANOEXIF_TYPE_%s, %d>;\n", $t->{name}, $t->{tag}, $t->{ifd}, $t->{type}, $t->{count};
+    }
+    print {$fh} <<'...';
+
+} // namespace tags
+} // namespace nanoexifpp
+
+#endif  /* NANOEXIF_TAGS_HPP__ */
 ...
     close $fh;
 };
 
-#ub {
-#   return;
-#   open my $fh, '>', 'nanoexif-tag.h';
-#   print {$fh} "#ifndef NANOEXIF_TAG_H__\n";
-#   print {$fh} "#define NANOEXIF_TAG_H__\n\n";
-#   my %seen;
-#   for my $k (@key) {
-#       next if $k > 0x300;
-#       my @name = get_name($src{$k});
-#       for my $name (@name) {
-#           # printf "SEEEEN $name %d\n", $k if $name =~ /ImageWidth/;
-#           print "SEEEEN $name $k\n" if $seen{$name} && $seen{$name} ne $k;
-#           $seen{$name} = $k;
-#           printf {$fh} qq{#define NANOEXIF_TAG_%-30s 0x%04X\n}, uc(decamelize($name)), $k;
-#       }
-#   }
-#   print {$fh} "\n#endif  // NANOEXIF_TAG_H__\n";
-#   close $fh;
-#->();
+sub key { ($_[0]->{ns} << 16) | $_[0]->{tag} }
+
+# the type and count ExifTool writes the tag with. count 0 is any: strings, undef and Count => -1.
+sub schema {
+    my $v = shift;
+    $v = $v->[0] if reftype($v) eq 'ARRAY' && @$v == 1;
+    return () unless reftype($v) eq 'HASH' && $v->{Writable} && $FORMAT{$v->{Writable}};
+    my $count = $v->{Count} // ($v->{Writable} =~ /^(?:string|undef)$/ ? 0 : 1);
+    return (type => $FORMAT{$v->{Writable}}, count => $count < 0 ? 0 : $count);
+}
+
+# 32bit multiply, without losing bits in perl's numbers.
+sub mul32 {
+    my ($x, $y) = @_;
+    return (($x * ($y & 0xFFFF)) + ((($x * ($y >> 16)) & 0xFFFF) << 16)) & 0xFFFFFFFF;
+}
+
+sub hash_key {
+    my ($key, $seed) = @_;
+    my $h = $key ^ mul32($seed, 0x9E3779B9);
+    $h ^= $h >> 16;
+    $h = mul32($h, 0x7FEB352D);
+    $h ^= $h >> 15;
+    $h = mul32($h, 0x846CA68B);
+    $h ^= $h >> 16;
+    return $h;
+}
+
+sub hash_name {
+    my ($s, $seed) = @_;
+    my $h = 0x811C9DC5 ^ mul32($seed, 0x9E3779B9);
+    for my $c (unpack 'C*', $s) {
+        $h ^= $c;
+        $h = mul32($h, 0x01000193);
+    }
+    return $h;
+}
+
+# compress, hash and displace: items go to buckets by hash(x, 0), then each bucket, largest first,
+# gets the smallest seed d which puts all of its items to free slots by hash(x, d).
+sub chd {
+    my ($items, $hash) = @_;
+    my $n = @$items;
+    my $m = ceil($n / 3);
+    my @buckets;
+    push @{$buckets[$hash->($_->[0], 0) % $m]}, $_ for @$items;
+    my @disp = (0) x $m;
+    my @slots;
+    for my $bi (sort { @{$buckets[$b] || []} <=> @{$buckets[$a] || []} || $a <=> $b } 0..$m-1) {
+        my $bucket = $buckets[$bi] or next;
+        D: for my $d (1..0xFFFF) {
+            my %taken;
+            for my $x (@$bucket) {
+                my $i = $hash->($x->[0], $d) % $n;
+                next D if defined $slots[$i] || $taken{$i}++;
+            }
+            $slots[$hash->($_->[0], $d) % $n] = $_->[1] for @$bucket;
+            $disp[$bi] = $d;
+            last;
+        }
+        die "no displacement for bucket $bi" unless $disp[$bi];
+    }
+    return (\@disp, \@slots);
+}
+
+sub emit_array {
+    my ($fh, $type, $name, $values) = @_;
+    printf {$fh} "static const %s %s[%d] = {\n", $type, $name, scalar @$values;
+    for (my $i = 0; $i < @$values; $i += 12) {
+        my $end = $i + 11 < $#$values ? $i + 11 : $#$values;
+        print {$fh} "    ", join(", ", @$values[$i..$end]), ",\n";
+    }
+    print {$fh} "};\n\n";
+}
 
 sub get_name {
     my $v = shift;